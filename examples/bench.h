@@ -0,0 +1,61 @@
+/* **********************************
+ * GPUdb C++ API Benchmarks
+ * Timing helpers shared by the bench_* programs
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+#ifndef _GPUDB_BENCH_H_
+#define _GPUDB_BENCH_H_
+
+
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+
+namespace bench
+{
+
+// Seconds on a monotonic clock
+inline double now()
+{
+    timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+
+// Call f() (a functor) repeatedly, after one call to warm up, and return the
+// nanoseconds per call of the fastest of a few rounds of calls.
+// The functors accumulate a checksum so their work is not optimized away.
+template <class F>
+double ns_per_call( F& f, size_t calls_per_round, size_t rounds = 5 )
+{
+    f();
+
+    double best = 0;
+    for ( size_t r = 0; r < rounds; ++r )
+    {
+        double start = now();
+        for ( size_t i = 0; i < calls_per_round; ++i )
+            f();
+        double ns = ( now() - start ) * 1e9 / (double)calls_per_round;
+        if ( ( r == 0 ) || ( ns < best ) )
+            best = ns;
+    }
+    return best;
+}
+
+
+// Print one comparison of the path a change replaced with the current one
+inline void report( const char* what, double old_ns, double new_ns )
+{
+    printf( "%-40s old %10.1f ns   new %10.1f ns   speedup %5.2fx\n",
+            what, old_ns, new_ns, ( new_ns > 0 ) ? old_ns / new_ns : 0.0 );
+}
+
+}  // end namespace bench
+
+#endif
@@ -0,0 +1,105 @@
+/* **********************************
+ * GPUdb C++ API Benchmark: pooled binary encoding
+ *
+ * Compares AvroUtils::convert_to_bytes(), which reuses the calling thread's
+ * pooled avro::binaryEncoder and memory stream chunks, with the path it
+ * replaced: a new encoder and AvroMemoryOutputStream for every request.
+ * Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "bench.h"
+
+
+// Encode the request as convert_to_bytes() did before the pools
+template <class T>
+static void convert_unpooled( const T& request, std::vector<uint8_t>& bytes )
+{
+    gpudb::AvroMemoryOutputStream out( gpudb::AvroMemoryOutputStream::DEFAULT_CHUNK_SIZE );
+    avro::EncoderPtr e = avro::binaryEncoder();
+    e->init( out );
+    avro::encode( *e, request );
+    e->flush();
+    out.getBuffer( bytes );
+}
+
+
+// Encodes the request with one of the two paths
+template <class T>
+struct encode_request
+{
+    const T&             request;
+    bool                 pooled;
+    std::vector<uint8_t> bytes;
+    size_t               checksum;
+
+    encode_request( const T& r, bool p ) : request( r ), pooled( p ), checksum( 0 ) {}
+
+    void operator()()
+    {
+        if ( pooled )
+            gpudb::AvroUtils::convert_to_bytes( request, bytes );
+        else
+            convert_unpooled( request, bytes );
+        checksum += bytes.size();
+    }
+};
+
+
+// Time both paths on the request, after checking that they agree
+template <class T>
+static bool compare( const char* what, const T& request )
+{
+    encode_request<T> old_path( request, false );
+    encode_request<T> new_path( request, true );
+    old_path();
+    new_path();
+    if ( old_path.bytes != new_path.bytes )
+    {
+        std::cerr << what << ": the paths disagree" << std::endl;
+        return false;
+    }
+
+    bench::report( what, bench::ns_per_call( old_path, 100000 ), bench::ns_per_call( new_path, 100000 ) );
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    gpudb::add_object_request add_object;
+    add_object.set_id = "my_set";
+    add_object.object_data.assign( 24, 7 );
+    add_object.object_encoding = "BINARY";
+
+    gpudb::bounding_box_request bounding_box;
+    bounding_box.min_x = -10;
+    bounding_box.max_x = 10;
+    bounding_box.min_y = -20;
+    bounding_box.max_y = 20;
+    bounding_box.x_attr_name = "x";
+    bounding_box.y_attr_name = "y";
+    bounding_box.set_id = "my_set";
+    bounding_box.result_set_id = "my_result_set";
+    bounding_box.user_auth_string = "";
+
+    gpudb::bulk_add_request bulk_add;
+    bulk_add.set_id = "my_set";
+    bulk_add.list.assign( 100, std::vector<uint8_t>( 24, 7 ) );
+    bulk_add.list_encoding = "BINARY";
+
+    printf( "Binary encoding, per request:\n" );
+    bool ok = compare( "add_object (24 byte object)", add_object )
+           && compare( "bounding_box", bounding_box )
+           && compare( "bulk_add (100 24 byte objects)", bulk_add );
+
+    return ok ? 0 : 1;
+}  // end main
@@ -0,0 +1,134 @@
+/* **********************************
+ * GPUdb C++ API Benchmark: json response decoding
+ *
+ * Compares AvroUtils::convert_to_object() on json, which transcodes the
+ * json to binary and decodes that, with the path it replaced: avro's
+ * validating json decoder (convert_json_to_object_by_schema()).
+ * Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "bench.h"
+
+
+// Decodes the json response with one of the two paths
+template <class T>
+struct decode_response
+{
+    const std::string&        json;
+    const gpudb::SchemaHandle schema;
+    bool                      transcode;
+    T                         response;
+    size_t                    checksum;
+
+    decode_response( const std::string& j, bool t ) :
+        json( j ), schema( gpudb::AvroUtils::intern_known_schema( T::schema_str(), T::fingerprint() ) ),
+        transcode( t ), checksum( 0 ) {}
+
+    bool decode()
+    {
+        response.clear();
+        if ( transcode )
+            return gpudb::AvroUtils::convert_to_object( json, schema, response );
+        return gpudb::AvroUtils::convert_json_to_object_by_schema( json, T::schema(), response );
+    }
+
+    void operator()()
+    {
+        decode();
+        checksum += gpudb::AvroUtils::get_exact_binary_encoded_size( response );
+    }
+};
+
+
+// Time both paths on the json, after checking that they agree
+template <class T>
+static bool compare( const char* what, const std::string& json )
+{
+    decode_response<T> old_path( json, false );
+    decode_response<T> new_path( json, true );
+
+    std::vector<uint8_t> old_bytes, new_bytes;
+    bool old_ok = false, new_ok = false;
+    try
+    {
+        old_ok = old_path.decode() && gpudb::AvroUtils::convert_to_bytes( old_path.response, old_bytes );
+        new_ok = new_path.decode() && gpudb::AvroUtils::convert_to_bytes( new_path.response, new_bytes );
+    }
+    catch ( const std::exception& e )
+    {
+        std::cerr << what << ": " << e.what() << std::endl;
+        return false;
+    }
+    if ( !old_ok || !new_ok || ( old_bytes != new_bytes ) )
+    {
+        std::cerr << what << ": the paths disagree" << std::endl;
+        return false;
+    }
+
+    size_t calls = 1 + 1000000 / json.size();
+    bench::report( what, bench::ns_per_call( old_path, calls ), bench::ns_per_call( new_path, calls ) );
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    char buf[ 256 ];
+
+    std::string bounding_box = "{\"count\": 12345}";
+
+    // A status of 20 sets, each with a child
+    std::string set_ids, is_parent, types, labels, sizes, child_map;
+    for ( int i = 0; i < 20; ++i )
+    {
+        const char* sep = i ? "," : "";
+        sprintf( buf, "%s\"set_%d\"", sep, i );
+        set_ids += buf;
+        is_parent += sep;
+        is_parent += ( i % 2 ) ? "true" : "false";
+        sprintf( buf, "%s\"point\"", sep );
+        types += buf;
+        sprintf( buf, "%s\"label \\\"%d\\\"\"", sep, i );
+        labels += buf;
+        sprintf( buf, "%s%d", sep, i * 1000 );
+        sizes += buf;
+        sprintf( buf, "%s\"set_%d\":[\"child_%d\"]", sep, i, i );
+        child_map += buf;
+    }
+    std::string status = "{\"set_id\":\"\",\"set_ids\":[" + set_ids + "],\"is_parent\":[" + is_parent +
+                         "],\"semantic_types\":[" + types + "],\"labels\":[" + labels +
+                         "],\"sizes\":[" + sizes + "],\"full_sizes\":[" + sizes +
+                         "],\"child_map\":{" + child_map + "},\"total_size\":190000,\"total_full_size\":190000}";
+
+    // A page of 1000 json objects, as a json handle gets them
+    std::string list_str, type_ids, object_ids;
+    for ( int i = 0; i < 1000; ++i )
+    {
+        const char* sep = i ? "," : "";
+        sprintf( buf, "%s\"{\\\"x\\\":%.3f,\\\"y\\\":%.3f,\\\"OBJECT_ID\\\":\\\"%d\\\"}\"", sep, i * 0.5, i * 0.25, i );
+        list_str += buf;
+        sprintf( buf, "%s\"point\"", sep );
+        type_ids += buf;
+        sprintf( buf, "%s\"%d\"", sep, i );
+        object_ids += buf;
+    }
+    std::string get_set = "{\"list\":[],\"list_str\":[" + list_str + "],\"type_ids\":[" + type_ids +
+                          "],\"set_id\":\"my_set\",\"object_ids\":[" + object_ids + "]}";
+
+    printf( "json response decoding, per response:\n" );
+    bool ok = compare<gpudb::bounding_box_response>( "bounding_box", bounding_box )
+           && compare<gpudb::status_response>( "status (20 sets)", status )
+           && compare<gpudb::get_set_response>( "get_set (1000 objects)", get_set );
+
+    return ok ? 0 : 1;
+}  // end main
@@ -0,0 +1,112 @@
+/* **********************************
+ * GPUdb C++ API Benchmark: json scanning
+ *
+ * Compares the vectorized JsonScanner searches the transcoder uses on
+ * string bodies and skipped values with the byte at a time loops they
+ * replaced. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "Utils/JsonScanner.h"
+#include "bench.h"
+
+
+// The loops the scanner replaced
+static const char* scalar_find_quote_or_escape( const char* p, const char* end )
+{
+    while ( ( p < end ) && ( *p != '"' ) && ( *p != '\\' ) )
+        ++p;
+    return p;
+}
+
+static const char* scalar_find_structural( const char* p, const char* end )
+{
+    while ( ( p < end ) && ( *p != '"' ) && ( *p != '{' ) && ( *p != '}' ) && ( *p != '[' ) && ( *p != ']' ) )
+        ++p;
+    return p;
+}
+
+
+typedef const char* (*find_fn)( const char*, const char* );
+
+// Finds every match in the text with one search function
+struct find_all
+{
+    const std::string& text;
+    find_fn            find;
+    size_t             checksum;
+
+    find_all( const std::string& t, find_fn f ) : text( t ), find( f ), checksum( 0 ) {}
+
+    void operator()()
+    {
+        const char* end = text.data() + text.size();
+        for ( const char* p = text.data(); p < end; ++p )
+        {
+            p = find( p, end );
+            checksum += (size_t)( end - p );
+        }
+    }
+};
+
+
+// Time both searches over the text, after checking that they agree
+static bool compare( const char* what, const std::string& text, find_fn old_find, find_fn new_find )
+{
+    find_all old_path( text, old_find );
+    find_all new_path( text, new_find );
+    old_path();
+    new_path();
+    if ( old_path.checksum != new_path.checksum )
+    {
+        std::cerr << what << ": the searches disagree" << std::endl;
+        return false;
+    }
+
+    double old_ns = bench::ns_per_call( old_path, 200 );
+    double new_ns = bench::ns_per_call( new_path, 200 );
+    bench::report( what, old_ns, new_ns );
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    // Strings of a few lengths, each ending in an escaped quote and a quote
+    const size_t lengths[] = { 8, 32, 128, 1024 };
+    char what[ 64 ];
+
+    printf( "json scanning (%s), per 64 KB of text:\n", gpudb::JsonScanner::simd_name() );
+    bool ok = true;
+    for ( size_t l = 0; ok && ( l < sizeof( lengths ) / sizeof( lengths[0] ) ); ++l )
+    {
+        std::string text;
+        while ( text.size() < 65536 )
+        {
+            for ( size_t i = 0; i < lengths[ l ]; ++i )
+                text += (char)( 'a' + ( i % 26 ) );
+            text += "\\\"\"";
+        }
+
+        sprintf( what, "quote or escape, %lu byte strings", (unsigned long)lengths[ l ] );
+        ok = compare( what, text, scalar_find_quote_or_escape, gpudb::JsonScanner::find_quote_or_escape );
+
+        // The same runs as array values to skip: [aaa...] ...
+        for ( size_t i = 0; i < text.size(); ++i )
+            if ( text[ i ] == '"' )
+                text[ i ] = ( i % 2 ) ? '[' : ']';
+        sprintf( what, "structural, %lu byte values", (unsigned long)lengths[ l ] );
+        ok = ok && compare( what, text, scalar_find_structural, gpudb::JsonScanner::find_structural );
+    }
+
+    return ok ? 0 : 1;
+}  // end main
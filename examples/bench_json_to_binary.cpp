@@ -0,0 +1,108 @@
+/* **********************************
+ * GPUdb C++ API Benchmark: JSON to binary conversion
+ *
+ * Compares the single pass AvroJsonTranscoder with the validating path it
+ * replaced (avro::jsonDecoder into a GenericDatum, then binary encoding)
+ * on the objects of a bulk_add. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "bench.h"
+
+
+// Converts every object with one of the two paths
+struct convert_objects
+{
+    const std::vector<std::string>& objects;
+    const gpudb::SchemaHandle&      schema;
+    bool                            transcode;
+    std::vector<uint8_t>            bytes;
+    size_t                          checksum;
+
+    convert_objects( const std::vector<std::string>& o, const gpudb::SchemaHandle& s, bool t ) :
+        objects( o ), schema( s ), transcode( t ), checksum( 0 ) {}
+
+    void operator()()
+    {
+        for ( size_t i = 0; i < objects.size(); ++i )
+        {
+            if ( transcode )
+                gpudb::AvroUtils::transcode_json_to_binary( objects[ i ], schema, bytes );
+            else
+                gpudb::AvroUtils::convert_json_to_binary_validated( objects[ i ], schema, bytes );
+            checksum += bytes.size();
+        }
+    }
+};
+
+
+// Time both paths over the objects, after checking that they agree
+static bool compare( const char* what, const std::string& type_definition,
+                     const std::vector<std::string>& objects )
+{
+    gpudb::SchemaHandle schema = gpudb::AvroUtils::intern_schema( type_definition );
+
+    for ( size_t i = 0; i < objects.size(); ++i )
+    {
+        std::vector<uint8_t> old_bytes, new_bytes;
+        if ( !gpudb::AvroUtils::convert_json_to_binary_validated( objects[ i ], schema, old_bytes ) ||
+             !gpudb::AvroUtils::transcode_json_to_binary( objects[ i ], schema, new_bytes ) )
+        {
+            std::cerr << what << ": cannot convert " << objects[ i ] << std::endl;
+            return false;
+        }
+        if ( old_bytes != new_bytes )
+        {
+            std::cerr << what << ": the paths disagree on " << objects[ i ] << std::endl;
+            return false;
+        }
+    }
+
+    convert_objects old_path( objects, schema, false );
+    convert_objects new_path( objects, schema, true );
+    double old_ns = bench::ns_per_call( old_path, 20 ) / (double)objects.size();
+    double new_ns = bench::ns_per_call( new_path, 20 ) / (double)objects.size();
+    bench::report( what, old_ns, new_ns );
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    const size_t num_objects = 10000;
+    char buf[ 256 ];
+
+    std::string point_type = "{\"type\":\"record\",\"name\":\"point\",\"fields\":[{\"name\":\"x\",\"type\":\"double\"},{\"name\":\"y\",\"type\":\"double\"},{\"name\":\"OBJECT_ID\",\"type\":\"string\"}]}";
+    std::vector<std::string> points;
+    for ( size_t i = 0; i < num_objects; ++i )
+    {
+        sprintf( buf, "{\"x\":%.6f,\"y\":%.6f,\"OBJECT_ID\":\"\"}", i * 0.25 - 10, i * 0.5 - 20 );
+        points.push_back( buf );
+    }
+
+    std::string track_type = "{\"type\":\"record\",\"name\":\"track\",\"fields\":[{\"name\":\"id\",\"type\":\"long\"},{\"name\":\"name\",\"type\":\"string\"},{\"name\":\"speed\",\"type\":\"float\"},{\"name\":\"active\",\"type\":\"boolean\"},{\"name\":\"path\",\"type\":{\"type\":\"array\",\"items\":\"double\"}},{\"name\":\"OBJECT_ID\",\"type\":\"string\"}]}";
+    std::vector<std::string> tracks;
+    for ( size_t i = 0; i < num_objects; ++i )
+    {
+        sprintf( buf, "{\"id\":%lu,\"name\":\"track \\\"%lu\\\"\",\"speed\":%.2f,\"active\":%s,"
+                      "\"path\":[%.4f,%.4f,%.4f,%.4f],\"OBJECT_ID\":\"\"}",
+                 (unsigned long)i, (unsigned long)i, i * 0.01, ( i % 2 ) ? "true" : "false",
+                 i * 0.1, i * 0.2, i * 0.3, i * 0.4 );
+        tracks.push_back( buf );
+    }
+
+    printf( "JSON to binary, per object:\n" );
+    bool ok = compare( "point (2 doubles, string)", point_type, points )
+           && compare( "track (long, string, array, ...)", track_type, tracks );
+
+    return ok ? 0 : 1;
+}  // end main
@@ -0,0 +1,132 @@
+/* **********************************
+ * GPUdb C++ API Benchmark: varint arrays
+ *
+ * Compares the batch AvroVarint kernels (decode_array, encode_array) with
+ * the one value at a time loops they replaced, on arrays of small values
+ * (one byte each), of mixed sizes and of large values. Needs no GPUdb
+ * server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "GPUdb.h"
+#include "Utils/AvroVarint.h"
+#include "bench.h"
+
+
+using gpudb::AvroVarint;
+
+
+// Decodes the whole array, one value at a time or in a batch
+struct decode_values
+{
+    const std::vector<uint8_t>& bytes;
+    std::vector<int64_t>        values;
+    bool                        batch;
+    size_t                      checksum;
+
+    decode_values( const std::vector<uint8_t>& b, size_t n, bool ba ) :
+        bytes( b ), values( n ), batch( ba ), checksum( 0 ) {}
+
+    void operator()()
+    {
+        const uint8_t* p = &bytes[0];
+        const uint8_t* end = p + bytes.size();
+        if ( batch )
+            checksum += AvroVarint::decode_array( p, end, &values[0], values.size() );
+        else
+        {
+            for ( size_t i = 0; i < values.size(); ++i )
+                AvroVarint::decode( p, end, values[ i ] );
+            checksum += values.size();
+        }
+        checksum += (size_t)values.back();
+    }
+};
+
+
+// Encodes the whole array, one value at a time or in a batch
+struct encode_values
+{
+    const std::vector<int64_t>& values;
+    std::vector<uint8_t>        bytes;
+    bool                        batch;
+    size_t                      checksum;
+
+    encode_values( const std::vector<int64_t>& v, bool ba ) :
+        values( v ), bytes( v.size() * AvroVarint::MAX_ENCODED_SIZE ), batch( ba ), checksum( 0 ) {}
+
+    void operator()()
+    {
+        uint8_t* out = &bytes[0];
+        if ( batch )
+            checksum += AvroVarint::encode_array( &values[0], values.size(), out );
+        else
+        {
+            uint8_t* p = out;
+            for ( size_t i = 0; i < values.size(); ++i )
+                p += AvroVarint::encode( values[ i ], p );
+            checksum += (size_t)( p - out );
+        }
+    }
+};
+
+
+// Time both paths both ways over the values, after checking that they agree
+static bool compare( const char* what, const std::vector<int64_t>& values )
+{
+    encode_values old_encode( values, false );
+    encode_values new_encode( values, true );
+    old_encode();
+    new_encode();
+    std::vector<uint8_t> bytes( old_encode.bytes.begin(), old_encode.bytes.begin() + old_encode.checksum );
+
+    decode_values old_decode( bytes, values.size(), false );
+    decode_values new_decode( bytes, values.size(), true );
+    old_decode();
+    new_decode();
+    if ( ( old_encode.checksum != new_encode.checksum ) ||
+         !std::equal( bytes.begin(), bytes.end(), new_encode.bytes.begin() ) ||
+         ( old_decode.values != values ) || ( new_decode.values != values ) )
+    {
+        std::cerr << what << ": the paths disagree" << std::endl;
+        return false;
+    }
+
+    double per_value = 1.0 / (double)values.size();
+    printf( "%s, per value:\n", what );
+    bench::report( "  decode", bench::ns_per_call( old_decode, 100 ) * per_value,
+                   bench::ns_per_call( new_decode, 100 ) * per_value );
+    bench::report( "  encode", bench::ns_per_call( old_encode, 100 ) * per_value,
+                   bench::ns_per_call( new_encode, 100 ) * per_value );
+    return true;
+}
+
+
+int main( int argc, char* argv[] )
+{
+    const size_t num_values = 100000;
+    srand( 42 );
+
+    std::vector<int64_t> small, mixed, large;
+    for ( size_t i = 0; i < num_values; ++i )
+    {
+        small.push_back( ( rand() % 128 ) - 64 );
+        mixed.push_back( ( i % 4 ) ? ( rand() % 128 ) - 64 : (int64_t)rand() * 1000 );
+        large.push_back( (int64_t)rand() * rand() );
+    }
+
+    bool ok = compare( "small values (1 byte)", small )
+           && compare( "mixed values (1 in 4 large)", mixed )
+           && compare( "large values (5-9 bytes)", large );
+
+    return ok ? 0 : 1;
+}  // end main
@@ -0,0 +1,56 @@
+/* **********************************
+ * GPUdb C++ API Checks
+ * Assertion helpers shared by the check_* programs
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+#ifndef _GPUDB_CHECK_H_
+#define _GPUDB_CHECK_H_
+
+
+#include <stdio.h>
+
+
+namespace check
+{
+
+// The number of failed CHECKs so far
+inline int& failures()
+{
+    static int count = 0;
+    return count;
+}
+
+
+inline bool record( bool passed, const char* what, const char* file, int line )
+{
+    if ( !passed )
+    {
+        fprintf( stderr, "%s:%d: CHECK failed: %s\n", file, line, what );
+        ++failures();
+    }
+    return passed;
+}
+
+
+// Print the outcome; returns the exit code for main()
+inline int result( const char* program )
+{
+    if ( failures() == 0 )
+    {
+        printf( "%s: all checks passed\n", program );
+        return 0;
+    }
+    printf( "%s: %d checks failed\n", program, failures() );
+    return 1;
+}
+
+}  // end namespace check
+
+
+// Records (and reports) a failure if cond is false; evaluates to cond.
+#define CHECK( cond ) check::record( ( cond ) ? true : false, #cond, __FILE__, __LINE__ )
+
+#endif
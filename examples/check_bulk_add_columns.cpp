@@ -0,0 +1,144 @@
+/* **********************************
+ * GPUdb C++ API Check: columnar bulk_add requests
+ *
+ * Checks that the /bulkadd request GPUdb writes from column buffers
+ * (gpudb::detail::write_bulk_add_columns) is byte for byte the binary
+ * encoding of the equivalent bulk_add_request, whose objects are the rows
+ * encoded as records: no rows, string and bytes columns, int and long
+ * values of every varint length and params. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "Utils/AvroRecord.h"
+#include "check.h"
+
+
+namespace app {
+GPUDB_AVRO_RECORD( row,
+                   ((double, x))
+                   ((float, speed))
+                   ((int, count))
+                   ((long, id))
+                   ((string, name))
+                   ((bytes, blob)) )
+}
+GPUDB_AVRO_RECORD_CODEC( app::row )
+
+
+// The rows of a batch, as columns
+struct row_columns
+{
+    std::vector<double>      x;
+    std::vector<float>       speed;
+    std::vector<int32_t>     count;
+    std::vector<int64_t>     id;
+    std::vector<std::string> name;
+    std::vector<std::string> blob;
+
+    size_t size() const { return x.size(); }
+
+    void add( double xv, float sv, int32_t cv, int64_t iv, const std::string& nv, const std::string& bv )
+    {
+        x.push_back( xv );
+        speed.push_back( sv );
+        count.push_back( cv );
+        id.push_back( iv );
+        name.push_back( nv );
+        blob.push_back( bv );
+    }
+};
+
+
+static void check_request( const char* what, const row_columns& rows,
+                           const std::map<std::string, std::string>& params )
+{
+    gpudb::AvroColumns columns( rows.size() );
+    columns.add( rows.x ).add( rows.speed ).add( rows.count ).add( rows.id ).add( rows.name ).add( rows.blob );
+    bool ok = CHECK( columns.matches( app::row::schema() ) );
+
+    // The same objects, encoded one at a time into a bulk_add_request
+    gpudb::bulk_add_request request;
+    request.set_id = "rows";
+    request.list.resize( rows.size() );
+    request.list_str.resize( rows.size() );
+    request.list_encoding = "BINARY";
+    request.params = params;
+    for ( size_t i = 0; i < rows.size(); ++i )
+    {
+        app::row r;
+        r.x = rows.x[ i ];
+        r.speed = rows.speed[ i ];
+        r.count = rows.count[ i ];
+        r.id = rows.id[ i ];
+        r.name = rows.name[ i ];
+        r.blob.assign( rows.blob[ i ].begin(), rows.blob[ i ].end() );
+        ok = CHECK( gpudb::AvroUtils::convert_to_bytes( r, request.list[ i ] ) ) && ok;
+    }
+    std::vector<uint8_t> expected;
+    ok = CHECK( gpudb::AvroUtils::convert_to_bytes( request, expected ) ) && ok;
+
+    std::vector<uint8_t> bytes;
+    gpudb::detail::write_bulk_add_columns( request.set_id, columns, params, bytes );
+    ok = CHECK( bytes == expected ) && ok;
+
+    if ( !ok )
+        std::cerr << "  for " << what << ": " << bytes.size() << " bytes, expected " << expected.size() << std::endl;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    row_columns rows;
+    std::map<std::string, std::string> params;
+
+    check_request( "no rows", rows, params );
+
+    rows.add( 1.5, 2.25f, 0, 0, "", "" );
+    check_request( "one row", rows, params );
+
+    // Every varint length of int and long values, positive and negative,
+    // and strings whose length prefix takes more than one byte
+    const int32_t int_max = std::numeric_limits<int32_t>::max();
+    const int32_t int_min = std::numeric_limits<int32_t>::min();
+    const int64_t long_max = std::numeric_limits<int64_t>::max();
+    const int64_t long_min = std::numeric_limits<int64_t>::min();
+    rows.add( -0.0, -1.0f, int_max, long_max, "name \"quoted\"", std::string( "\0\x01\xff", 3 ) );
+    rows.add( 1e300, 3.4e38f, int_min, long_min, std::string( 200, 'n' ), std::string( 20000, '\x80' ) );
+    for ( int shift = 0; shift < 63; ++shift )
+    {
+        int64_t v = (int64_t)1 << shift;
+        int32_t c = (int32_t)1 << ( shift % 31 );
+        rows.add( (double)shift, (float)shift, ( shift % 2 ) ? c : -c, ( shift % 2 ) ? v : -v,
+                  std::string( (size_t)shift * 3, 'a' + shift % 26 ), std::string( (size_t)shift, (char)shift ) );
+    }
+    check_request( "many rows", rows, params );
+
+    params[ "update_on_existing_pk" ] = "true";
+    check_request( "a param", rows, params );
+
+    params[ "" ] = "";
+    params[ std::string( 150, 'k' ) ] = std::string( 300, 'v' );
+    check_request( "params", rows, params );
+
+    rows = row_columns();
+    check_request( "params and no rows", rows, params );
+
+    // More rows than fit a one byte count, in one block
+    for ( size_t i = 0; i < 1000; ++i )
+        rows.add( i * 0.5, (float)i, (int32_t)i * 1000, (int64_t)i << 30, "row", "" );
+    check_request( "1000 rows", rows, params );
+
+    return check::result( "check_bulk_add_columns" );
+}  // end main
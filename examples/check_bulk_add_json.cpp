@@ -0,0 +1,89 @@
+/* **********************************
+ * GPUdb C++ API Check: JSON bulk_add requests
+ *
+ * Checks that the /bulkadd request GPUdb writes around JSON encoded
+ * objects (gpudb::detail::write_bulk_add_json) is byte for byte the JSON
+ * encoding of the equivalent bulk_add_request, with strings that need
+ * escapes, params and an empty list. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "check.h"
+
+
+static void check_request( const char* what,
+                           const std::string& set_id,
+                           const std::vector<std::string>& objects,
+                           const std::map<std::string, std::string>& params )
+{
+    gpudb::bulk_add_request request;
+    request.set_id = set_id;
+    request.list.resize( objects.size() );
+    request.list_str = objects;
+    request.list_encoding = "JSON";
+    request.params = params;
+
+    std::string expected;
+    bool ok = CHECK( gpudb::AvroUtils::convert_to_json_by_schema( request, gpudb::bulk_add_request::schema(), expected ) );
+
+    std::string json;
+    gpudb::detail::write_bulk_add_json( set_id, objects, params, json );
+    ok = ok && CHECK( json == expected );
+
+    if ( !ok )
+        std::cerr << "  for " << what << ":\n  " << json << "\n  expected\n  " << expected << std::endl;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    std::vector<std::string> objects;
+    std::map<std::string, std::string> params;
+
+    check_request( "an empty list", "points", objects, params );
+    check_request( "an empty list and set_id", "", objects, params );
+
+    objects.push_back( "{\"x\":1.5,\"y\":-2,\"OBJECT_ID\":\"\"}" );
+    check_request( "one object", "points", objects, params );
+
+    // Quotes, backslashes, control characters, DEL and UTF-8
+    objects.push_back( "{\"name\":\"a \\\"quoted\\\" \\\\ name\",\"note\":\"tab\\there\"}" );
+    objects.push_back( "raw \"\\/\b\f\n\r\t\x01\x1f\x7f end" );
+    objects.push_back( std::string( "nul \0 inside", 12 ) );
+    objects.push_back( "caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x8c\x8d" );
+    objects.push_back( "" );
+    check_request( "objects with escapes", "set \"with\" \\ escapes\n", objects, params );
+
+    params[ "update_on_existing_pk" ] = "true";
+    check_request( "a param", "points", objects, params );
+
+    params[ "" ] = "";
+    params[ "key \"quoted\"" ] = "value\twith\\escapes\x02";
+    check_request( "params with escapes", "points", objects, params );
+
+    objects.clear();
+    check_request( "params and an empty list", "points", objects, params );
+
+    // Many objects, as a bulk_add sends
+    params.clear();
+    char buf[ 64 ];
+    for ( size_t i = 0; i < 1000; ++i )
+    {
+        sprintf( buf, "{\"x\":%lu,\"y\":%lu,\"OBJECT_ID\":\"\\\"%lu\\\"\"}", (unsigned long)i, (unsigned long)( 2 * i ), (unsigned long)i );
+        objects.push_back( buf );
+    }
+    check_request( "1000 objects", "points", objects, params );
+
+    return check::result( "check_bulk_add_json" );
+}  // end main
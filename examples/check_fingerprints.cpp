@@ -0,0 +1,116 @@
+/* **********************************
+ * GPUdb C++ API Check: schema fingerprints
+ *
+ * Checks that the fingerprint() each obj_defs type (and a GPUDB_AVRO_RECORD
+ * type) carries precomputed is AvroUtils::fingerprint64() of its
+ * schema_str(), and that interning the schema by it finds the same entry
+ * as interning the text alone, and that a different text under an
+ * interned fingerprint is rejected. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <string>
+
+#include "GPUdb.h"
+#include "obj_defs/actorlist.h"
+#include "obj_defs/actorobject.h"
+#include "obj_defs/filterbystringresponse.h"
+#include "Utils/AvroRecord.h"
+#include "check.h"
+
+
+namespace app {
+GPUDB_AVRO_RECORD( track,
+                   ((long, id))
+                   ((string, name))
+                   ((array_double, path))
+                   ((map_string, labels)) )
+}
+GPUDB_AVRO_RECORD_CODEC( app::track )
+
+
+template <class T>
+static void check_type( const char* what )
+{
+    const std::string& schema_str = T::schema_str();
+    uint64_t fingerprint = T::fingerprint();
+
+    bool ok = CHECK( fingerprint == gpudb::AvroUtils::fingerprint64( schema_str ) ) &&
+              CHECK( fingerprint == gpudb::AvroRecord::fingerprint64( schema_str.data(), schema_str.size() ) );
+
+    gpudb::SchemaHandle by_fingerprint = gpudb::AvroUtils::intern_schema( schema_str, fingerprint );
+    gpudb::SchemaHandle by_text = gpudb::AvroUtils::intern_schema( schema_str );
+    ok = CHECK( by_fingerprint.valid() ) && CHECK( by_fingerprint == by_text ) &&
+         CHECK( by_fingerprint.fingerprint() == fingerprint ) &&
+         CHECK( by_fingerprint.schema_str() == schema_str ) && ok;
+
+    // schema() is compiled from the same text
+    ok = CHECK( T::schema().root()->type() == by_text.schema().root()->type() ) &&
+         CHECK( &gpudb::AvroUtils::get_or_compile_schema( schema_str, fingerprint ) == &by_text.schema() ) && ok;
+
+    if ( !ok )
+        std::cerr << "  for " << what << std::endl;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    // The fingerprint of no bytes is the CRC-64-AVRO seed
+    CHECK( gpudb::AvroUtils::fingerprint64( "" ) == 0xc15d213aa4d7a795ULL );
+
+    check_type<gpudb::actor_list>( "actor_list" );
+    check_type<gpudb::actor_object>( "actor_object" );
+    check_type<gpudb::add_object_request>( "add_object_request" );
+    check_type<gpudb::add_object_response>( "add_object_response" );
+    check_type<gpudb::bounding_box_request>( "bounding_box_request" );
+    check_type<gpudb::bounding_box_response>( "bounding_box_response" );
+    check_type<gpudb::bulk_add_request>( "bulk_add_request" );
+    check_type<gpudb::bulk_add_response>( "bulk_add_response" );
+    check_type<gpudb::clear_request>( "clear_request" );
+    check_type<gpudb::clear_response>( "clear_response" );
+    check_type<gpudb::filter_by_string_response>( "filter_by_string_response" );
+    check_type<gpudb::get_set_flat_response>( "get_set_flat_response" );
+    check_type<gpudb::get_set_request>( "get_set_request" );
+    check_type<gpudb::get_set_response>( "get_set_response" );
+    check_type<gpudb::gpudb_response>( "gpudb_response" );
+    check_type<gpudb::gpudb_response_view>( "gpudb_response_view" );
+    check_type<gpudb::new_set_request>( "new_set_request" );
+    check_type<gpudb::new_set_response>( "new_set_response" );
+    check_type<gpudb::register_parent_set_request>( "register_parent_set_request" );
+    check_type<gpudb::register_parent_set_response>( "register_parent_set_response" );
+    check_type<gpudb::register_type_request>( "register_type_request" );
+    check_type<gpudb::register_type_response>( "register_type_response" );
+    check_type<gpudb::status_request>( "status_request" );
+    check_type<gpudb::status_response>( "status_response" );
+    check_type<app::track>( "app::track (GPUDB_AVRO_RECORD)" );
+
+    // A different type definition of the same length found under an
+    // interned fingerprint (as a CRC-64 collision would be) is not given
+    // the interned schema
+    std::string point = "{\"type\":\"record\",\"name\":\"point\",\"fields\":[{\"name\":\"x\",\"type\":\"double\"}]}";
+    std::string other = "{\"type\":\"record\",\"name\":\"other\",\"fields\":[{\"name\":\"x\",\"type\":\"string\"}]}";
+    other.resize( point.size(), ' ' );
+    uint64_t point_fingerprint = gpudb::AvroUtils::intern_schema( point ).fingerprint();
+    bool collision_thrown = false;
+    try
+    {
+        gpudb::AvroUtils::intern_schema( other, point_fingerprint );
+    }
+    catch ( const std::exception& e )
+    {
+        collision_thrown = true;
+    }
+    CHECK( collision_thrown );
+
+    // The generated types' strings are looked up by their fingerprint alone
+    CHECK( gpudb::AvroUtils::intern_known_schema( gpudb::status_request::schema_str(), gpudb::status_request::fingerprint() ) ==
+           gpudb::AvroUtils::intern_schema( gpudb::status_request::schema_str() ) );
+
+    return check::result( "check_fingerprints" );
+}  // end main
@@ -0,0 +1,123 @@
+/* **********************************
+ * GPUdb C++ API Check: json numbers under a decimal comma locale
+ *
+ * Checks that AvroJsonWriter writes doubles and floats, and that
+ * AvroJsonTranscoder reads them (also those too long for its fast path),
+ * the same way whatever the LC_NUMERIC locale: under one whose decimal
+ * point is a comma (e.g. de_DE) printf writes "0,5" and strtod stops at
+ * "0.5"'s '.'. Skipped if no such locale is installed. Needs no GPUdb
+ * server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <locale.h>
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "Utils/AvroJsonWriter.h"
+#include "check.h"
+
+
+static const char* const COMMA_LOCALES[] = {
+    "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR.utf8", "fr_FR",
+    "nl_NL.UTF-8", "ru_RU.UTF-8", "es_ES.UTF-8", "it_IT.UTF-8", "pt_BR.UTF-8"
+};
+
+static const double SAMPLE_DOUBLES[] = { 0.5, -20.25, 0.1, 1.0 / 3, 2.5e-05, -1e+100, 1e300, 123456.789,
+                                         4.9406564584124654e-324, 657784910.27943236 };
+static const float  SAMPLE_FLOATS[]  = { 0.5f, -0.25f, 0.1f, 1.0f / 3, 3.4e38f, 1.17549435e-38f, 1234.5678f };
+
+// Numbers as json text; the long ones take the transcoder's strtod path
+static const char* const SAMPLE_JSON[] = {
+    "0.5", "-20.25", "2.5e-05", "-1E+100", "0.1000000000000000055511151231257827",
+    "657784910.27943236", "3.14159265358979323846264338327950288", "12345678901234567890.5", "1e-320"
+};
+
+static const char* NUMBERS_SCHEMA =
+    "{\"type\":\"record\",\"name\":\"numbers\",\"fields\":["
+    "{\"name\":\"d\",\"type\":\"double\"},"
+    "{\"name\":\"f\",\"type\":\"float\"}]}";
+
+
+// The json text and transcoded bytes of every sample, in the current locale
+static void write_samples( std::vector<std::string>& text, std::vector<std::vector<uint8_t> >& bytes )
+{
+    for ( size_t i = 0; i < sizeof( SAMPLE_DOUBLES ) / sizeof( SAMPLE_DOUBLES[0] ); ++i )
+    {
+        std::string s;
+        gpudb::AvroJsonWriter::write_double( SAMPLE_DOUBLES[ i ], s );
+        text.push_back( s );
+    }
+    for ( size_t i = 0; i < sizeof( SAMPLE_FLOATS ) / sizeof( SAMPLE_FLOATS[0] ); ++i )
+    {
+        std::string s;
+        gpudb::AvroJsonWriter::write_float( SAMPLE_FLOATS[ i ], s );
+        text.push_back( s );
+    }
+
+    gpudb::SchemaHandle schema = gpudb::AvroUtils::intern_schema( NUMBERS_SCHEMA );
+    for ( size_t i = 0; i < sizeof( SAMPLE_JSON ) / sizeof( SAMPLE_JSON[0] ); ++i )
+    {
+        std::string json = std::string( "{\"d\":" ) + SAMPLE_JSON[ i ] + ",\"f\":" + SAMPLE_JSON[ i ] + "}";
+        std::vector<uint8_t> b;
+        if ( !CHECK( gpudb::AvroUtils::transcode_json_to_binary( json, schema, b ) ) )
+            std::cerr << "  for " << json << " under LC_NUMERIC " << setlocale( LC_NUMERIC, NULL ) << std::endl;
+        bytes.push_back( b );
+    }
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    std::vector<std::string> c_text;
+    std::vector<std::vector<uint8_t> > c_bytes;
+    write_samples( c_text, c_bytes );
+    for ( size_t i = 0; i < c_text.size(); ++i )
+        CHECK( c_text[ i ].find( ',' ) == std::string::npos );
+
+    const char* comma_locale = NULL;
+    for ( size_t i = 0; ( comma_locale == NULL ) && ( i < sizeof( COMMA_LOCALES ) / sizeof( COMMA_LOCALES[0] ) ); ++i )
+    {
+        if ( setlocale( LC_NUMERIC, COMMA_LOCALES[ i ] ) && ( strcmp( localeconv()->decimal_point, "," ) == 0 ) )
+            comma_locale = COMMA_LOCALES[ i ];
+    }
+    if ( comma_locale == NULL )
+    {
+        setlocale( LC_NUMERIC, "C" );
+        printf( "check_json_locale: no locale with a decimal comma is installed, skipped\n" );
+        return check::result( "check_json_locale" );
+    }
+
+    // printf does follow the locale, so the writer and transcoder are tested
+    char buf[ 32 ];
+    snprintf( buf, sizeof( buf ), "%g", 0.5 );
+    CHECK( strcmp( buf, "0,5" ) == 0 );
+
+    std::vector<std::string> text;
+    std::vector<std::vector<uint8_t> > bytes;
+    write_samples( text, bytes );
+    setlocale( LC_NUMERIC, "C" );
+
+    bool ok = CHECK( text.size() == c_text.size() );
+    for ( size_t i = 0; ok && ( i < text.size() ); ++i )
+    {
+        if ( !CHECK( text[ i ] == c_text[ i ] ) )
+            std::cerr << "  wrote " << text[ i ] << " under " << comma_locale << ", " << c_text[ i ] << " under C" << std::endl;
+    }
+    ok = CHECK( bytes.size() == c_bytes.size() );
+    for ( size_t i = 0; ok && ( i < bytes.size() ); ++i )
+    {
+        if ( !CHECK( bytes[ i ] == c_bytes[ i ] ) )
+            std::cerr << "  transcoded " << SAMPLE_JSON[ i ] << " differently under " << comma_locale << std::endl;
+    }
+
+    return check::result( "check_json_locale" );
+}  // end main
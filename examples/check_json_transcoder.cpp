@@ -0,0 +1,287 @@
+/* **********************************
+ * GPUdb C++ API Check: JSON to binary transcoding
+ *
+ * Checks that the schema-compiled AvroJsonTranscoder writes the same bytes
+ * as the validating path (avro::jsonDecoder into a GenericDatum, then the
+ * binary encoder, AvroUtils::convert_json_to_binary_validated) for unions
+ * and nullable fields, maps, arrays, enums and fixed, string escapes
+ * including \uXXXX and surrogate pairs, integer literals in double and
+ * float fields and fields out of schema order; and that malformed input,
+ * missing fields and values of the wrong type are rejected by both, and
+ * so by AvroUtils::convert_json_to_binary_by_schema. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "GPUdb.h"
+#include "Utils/AvroJsonTranscoder.h"
+#include "check.h"
+
+
+static const char* THING_SCHEMA =
+    "{\"type\":\"record\",\"name\":\"thing\",\"fields\":["
+    "{\"name\":\"id\",\"type\":\"long\"},"
+    "{\"name\":\"count\",\"type\":\"int\"},"
+    "{\"name\":\"x\",\"type\":\"double\"},"
+    "{\"name\":\"speed\",\"type\":\"float\"},"
+    "{\"name\":\"ok\",\"type\":\"boolean\"},"
+    "{\"name\":\"name\",\"type\":\"string\"},"
+    "{\"name\":\"blob\",\"type\":\"bytes\"},"
+    "{\"name\":\"hash\",\"type\":{\"type\":\"fixed\",\"name\":\"hash\",\"size\":4}},"
+    "{\"name\":\"color\",\"type\":{\"type\":\"enum\",\"name\":\"color\",\"symbols\":[\"RED\",\"GREEN\",\"BLUE\"]}},"
+    "{\"name\":\"note\",\"type\":[\"null\",\"string\"]},"
+    "{\"name\":\"value\",\"type\":[\"null\",\"long\",\"double\",\"string\","
+        "{\"type\":\"record\",\"name\":\"point\",\"fields\":[{\"name\":\"x\",\"type\":\"double\"},{\"name\":\"y\",\"type\":\"double\"}]}]},"
+    "{\"name\":\"tags\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},"
+    "{\"name\":\"attrs\",\"type\":{\"type\":\"map\",\"values\":[\"null\",\"int\"]}},"
+    "{\"name\":\"points\",\"type\":{\"type\":\"array\",\"items\":\"point\"}}]}";
+
+
+// The fields of a thing as json text, in the order they are written
+typedef std::vector<std::pair<std::string, std::string> > fields;
+
+static fields default_thing()
+{
+    fields f;
+    f.push_back( std::make_pair( "id", "1234567890123" ) );
+    f.push_back( std::make_pair( "count", "-42" ) );
+    f.push_back( std::make_pair( "x", "0.5" ) );
+    f.push_back( std::make_pair( "speed", "2.25" ) );
+    f.push_back( std::make_pair( "ok", "true" ) );
+    f.push_back( std::make_pair( "name", "\"plain\"" ) );
+    f.push_back( std::make_pair( "blob", "\"ab\\u0001\\u007f\"" ) );
+    f.push_back( std::make_pair( "hash", "\"abcd\"" ) );
+    f.push_back( std::make_pair( "color", "\"GREEN\"" ) );
+    f.push_back( std::make_pair( "note", "null" ) );
+    f.push_back( std::make_pair( "value", "{\"long\":7}" ) );
+    f.push_back( std::make_pair( "tags", "[\"a\",\"b\"]" ) );
+    f.push_back( std::make_pair( "attrs", "{\"k\":{\"int\":1},\"n\":null}" ) );
+    f.push_back( std::make_pair( "points", "[{\"x\":1.5,\"y\":-2.0}]" ) );
+    return f;
+}
+
+// The thing with one field's value replaced
+static fields with( const char* name, const std::string& value )
+{
+    fields f = default_thing();
+    for ( size_t i = 0; i < f.size(); ++i )
+    {
+        if ( f[ i ].first == name )
+            f[ i ].second = value;
+    }
+    return f;
+}
+
+static std::string json( const fields& f )
+{
+    std::string text = "{";
+    for ( size_t i = 0; i < f.size(); ++i )
+    {
+        if ( i > 0 )
+            text += ",";
+        text += "\"" + f[ i ].first + "\":" + f[ i ].second;
+    }
+    return text + "}";
+}
+
+
+static gpudb::SchemaHandle thing_schema()
+{
+    return gpudb::AvroUtils::intern_schema( THING_SCHEMA );
+}
+
+
+// The transcoder's bytes for json are those of the validating path for
+// expected, which is json itself unless json uses a form (e.g. fields out of
+// order) that the transcoder accepts and avro's json decoder may not
+static void check_same( const char* what, const std::string& json, const std::string& expected )
+{
+    std::vector<uint8_t> transcoded, validated, converted;
+    bool ok = CHECK( gpudb::AvroUtils::transcode_json_to_binary( json, thing_schema(), transcoded ) ) &&
+              CHECK( gpudb::AvroUtils::convert_json_to_binary_validated( expected, thing_schema(), validated ) ) &&
+              CHECK( transcoded == validated ) &&
+              CHECK( gpudb::AvroUtils::convert_json_to_binary_by_schema( json, thing_schema(), converted ) ) &&
+              CHECK( converted == validated );
+    if ( !ok )
+        std::cerr << "  for " << what << ":\n  " << json << std::endl;
+}
+
+static void check_same( const char* what, const std::string& json )
+{
+    check_same( what, json, json );
+}
+
+
+// Neither path accepts json
+static void check_rejected( const char* what, const std::string& json )
+{
+    std::vector<uint8_t> bytes;
+    bool ok = CHECK( !gpudb::AvroUtils::transcode_json_to_binary( json, thing_schema(), bytes ) ) &&
+              CHECK( !gpudb::AvroUtils::convert_json_to_binary_validated( json, thing_schema(), bytes ) ) &&
+              CHECK( !gpudb::AvroUtils::convert_json_to_binary_by_schema( json, thing_schema(), bytes ) );
+    if ( !ok )
+        std::cerr << "  for " << what << ":\n  " << json << std::endl;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    CHECK( thing_schema().json_transcoder() != NULL );
+
+    check_same( "the default thing", json( default_thing() ) );
+
+    // Whitespace everywhere json allows it
+    std::string spaced = json( default_thing() );
+    for ( size_t i = 0; i < spaced.size(); ++i )
+    {
+        if ( ( spaced[ i ] == ':' ) || ( spaced[ i ] == ',' ) )
+            spaced.insert( ++i, " \n\t\r" );
+    }
+    check_same( "whitespace", " \n" + spaced + "\t " );
+
+    // Unions and nullable fields, every branch
+    check_same( "a nullable string", json( with( "note", "{\"string\":\"hi\"}" ) ) );
+    check_same( "a null union", json( with( "value", "null" ) ) );
+    check_same( "a double branch", json( with( "value", "{\"double\":-1.5}" ) ) );
+    check_same( "a string branch", json( with( "value", "{\"string\":\"s\"}" ) ) );
+    check_same( "a record branch", json( with( "value", "{ \"point\" : {\"x\":1.0,\"y\":2.0} }" ) ) );
+
+    // Maps and arrays: empty, and with more entries than fit a one byte count
+    check_same( "empty", json( with( "tags", "[]" ) ) );
+    check_same( "an empty map", json( with( "attrs", "{}" ) ) );
+    check_same( "no points", json( with( "points", "[ ]" ) ) );
+    std::string tags = "[", attrs = "{";
+    char buf[ 64 ];
+    for ( int i = 0; i < 200; ++i )
+    {
+        sprintf( buf, "%s\"tag %d\"", i ? "," : "", i );
+        tags += buf;
+        sprintf( buf, "%s\"key %d\":%s", i ? "," : "", i, ( i % 3 ) ? "{\"int\":-7}" : "null" );
+        attrs += buf;
+    }
+    check_same( "200 tags", json( with( "tags", tags + "]" ) ) );
+    check_same( "200 attrs", json( with( "attrs", attrs + "}" ) ) );
+    check_same( "map keys with escapes", json( with( "attrs", "{\"a\\\"b\":null,\"tab\\t\":{\"int\":0},\"\":null}" ) ) );
+
+    // Enums and fixed
+    check_same( "the first symbol", json( with( "color", "\"RED\"" ) ) );
+    check_same( "the last symbol", json( with( "color", "\"BLUE\"" ) ) );
+    check_same( "fixed with escapes", json( with( "hash", "\"\\u0000\\u0001\\\"z\"" ) ) );
+    check_same( "bytes with escapes", json( with( "blob", "\"\\u00ff\\u0080\\n\\\\\"" ) ) );
+    check_same( "empty bytes", json( with( "blob", "\"\"" ) ) );
+
+    // String escapes; \uXXXX escapes are compared with the characters they
+    // stand for written out in utf-8
+    check_same( "escapes", json( with( "name", "\"\\\"quoted\\\" \\\\ \\/ \\b\\f\\n\\r\\t\"" ) ) );
+    check_same( "unicode escapes",
+                json( with( "name", "\"caf\\u00e9 \\u20AC \\ud83c\\udf0d \\u0041\"" ) ),
+                json( with( "name", "\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x8c\x8d A\"" ) ) );
+    check_same( "utf-8", json( with( "name", "\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x8c\x8d\"" ) ) );
+    check_same( "an escape that shortens the length prefix",
+                json( with( "name", "\"" + std::string( 62, 'a' ) + "\\n\"" ) ) );
+    check_same( "a long string", json( with( "name", "\"" + std::string( 10000, 'x' ) + "\\t\"" ) ) );
+
+    // Numbers: integer literals in double and float fields, the fast and
+    // slow paths of double parsing, and the int and long extremes
+    check_same( "an integer double", json( with( "x", "2" ) ), json( with( "x", "2.0" ) ) );
+    check_same( "an integer float", json( with( "speed", "-3" ) ), json( with( "speed", "-3.0" ) ) );
+    check_same( "a negative zero double", json( with( "x", "-0" ) ), json( with( "x", "-0.0" ) ) );
+    check_same( "a big integer double", json( with( "x", "12345678901234567890" ) ), json( with( "x", "12345678901234567890.0" ) ) );
+    check_same( "2^53 + 1", json( with( "x", "9007199254740993" ) ), json( with( "x", "9007199254740993.0" ) ) );
+    check_same( "an integer in a point", json( with( "points", "[{\"x\":1,\"y\":-2}]" ) ),
+                json( with( "points", "[{\"x\":1.0,\"y\":-2.0}]" ) ) );
+    const char* doubles[] = { "0.1", "-1e3", "1E-5", "123456.789e-3", "1e-310", "1.7976931348623157e308",
+                              "3.14159265358979323846264338327950288", "657784910.27943236", "0.000000000000000000001", "4.9e-324" };
+    for ( size_t i = 0; i < sizeof( doubles ) / sizeof( doubles[ 0 ] ); ++i )
+    {
+        check_same( doubles[ i ], json( with( "x", doubles[ i ] ) ) );
+        check_same( doubles[ i ], json( with( "speed", doubles[ i ] ) ) );
+    }
+    check_same( "the largest int", json( with( "count", "2147483647" ) ) );
+    check_same( "the smallest int", json( with( "count", "-2147483648" ) ) );
+    check_same( "the largest long", json( with( "id", "9223372036854775807" ) ) );
+    check_same( "the smallest long", json( with( "id", "-9223372036854775808" ) ) );
+
+    // Fields out of schema order, which are written in order
+    fields reversed = default_thing();
+    std::reverse( reversed.begin(), reversed.end() );
+    check_same( "reversed fields", json( reversed ), json( default_thing() ) );
+    fields moved = default_thing();
+    moved.push_back( moved.front() );
+    moved.erase( moved.begin() );
+    check_same( "the first field last", json( moved ), json( default_thing() ) );
+    fields swapped = with( "value", "{\"point\":{\"y\":2.0,\"x\":1.0}}" );
+    std::swap( swapped[ 2 ], swapped[ 9 ] );
+    check_same( "swapped fields and point fields", json( swapped ),
+                json( with( "value", "{\"point\":{\"x\":1.0,\"y\":2.0}}" ) ) );
+
+    // Malformed json, including every truncation of a valid object
+    std::string valid = json( default_thing() );
+    for ( size_t len = 0; len < valid.size(); ++len )
+    {
+        std::vector<uint8_t> bytes;
+        if ( !CHECK( !gpudb::AvroUtils::transcode_json_to_binary( valid.substr( 0, len ), thing_schema(), bytes ) ) ||
+             !CHECK( !gpudb::AvroUtils::convert_json_to_binary_by_schema( valid.substr( 0, len ), thing_schema(), bytes ) ) )
+        {
+            std::cerr << "  truncated to " << len << " characters" << std::endl;
+            break;
+        }
+    }
+    check_rejected( "no closing brace", valid.substr( 0, valid.size() - 1 ) + " " );
+    check_rejected( "a missing comma", json( with( "ok", "true \"extra\"" ) ) );
+    check_rejected( "a missing colon", "{\"id\" 1" + valid.substr( valid.find( ',' ) ) );
+    check_rejected( "an unterminated string", json( with( "name", "\"plain" ) ) );
+    check_rejected( "a bad escape", json( with( "name", "\"a\\xb\"" ) ) );
+    check_rejected( "a bad unicode escape", json( with( "name", "\"a\\u12G4\"" ) ) );
+    check_rejected( "a bad literal", json( with( "ok", "tru" ) ) );
+    check_rejected( "an array", "[" + valid + "]" );
+    check_rejected( "nothing", "" );
+
+    // Missing, unknown and repeated fields
+    fields missing = default_thing();
+    missing.erase( missing.begin() + 4 );
+    check_rejected( "a missing field", json( missing ) );
+    missing = default_thing();
+    missing.pop_back();
+    check_rejected( "a missing last field", json( missing ) );
+    check_rejected( "a missing point field", json( with( "points", "[{\"x\":1.5}]" ) ) );
+    fields extra = default_thing();
+    extra.push_back( std::make_pair( "extra", "1" ) );
+    check_rejected( "an unknown field", json( extra ) );
+    fields repeated = default_thing();
+    repeated.push_back( repeated[ 3 ] );
+    check_rejected( "a repeated field", json( repeated ) );
+
+    // Values of the wrong type
+    check_rejected( "a string for an int", json( with( "count", "\"1\"" ) ) );
+    check_rejected( "a fraction for an int", json( with( "count", "1.5" ) ) );
+    check_rejected( "an exponent for a long", json( with( "id", "1e3" ) ) );
+    check_rejected( "an int out of range", json( with( "count", "2147483648" ) ) );
+    check_rejected( "a long out of range", json( with( "id", "9223372036854775808" ) ) );
+    check_rejected( "a number for a boolean", json( with( "ok", "1" ) ) );
+    check_rejected( "a number for a string", json( with( "name", "5" ) ) );
+    check_rejected( "null for a string", json( with( "name", "null" ) ) );
+    check_rejected( "a string for a double", json( with( "x", "\"0.5\"" ) ) );
+    check_rejected( "an array for a map", json( with( "attrs", "[]" ) ) );
+    check_rejected( "a map for an array", json( with( "tags", "{}" ) ) );
+    check_rejected( "an unknown symbol", json( with( "color", "\"PURPLE\"" ) ) );
+    check_rejected( "a short fixed", json( with( "hash", "\"abc\"" ) ) );
+    check_rejected( "a long fixed", json( with( "hash", "\"abcde\"" ) ) );
+    check_rejected( "an unknown branch", json( with( "note", "{\"boolean\":true}" ) ) );
+    check_rejected( "an unwrapped branch", json( with( "note", "\"hi\"" ) ) );
+    check_rejected( "a branch of the wrong type", json( with( "value", "{\"long\":\"7\"}" ) ) );
+    check_rejected( "a wrong item", json( with( "tags", "[\"a\",2]" ) ) );
+    check_rejected( "a wrong map value", json( with( "attrs", "{\"k\":1}" ) ) );
+
+    return check::result( "check_json_transcoder" );
+}  // end main
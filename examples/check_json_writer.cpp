@@ -0,0 +1,339 @@
+/* **********************************
+ * GPUdb C++ API Check: AvroJsonWriter
+ *
+ * Checks that AvroJsonWriter writes the same json as avro::jsonEncoder()
+ * for every obj_defs type, filled with sample values generated from its
+ * schema, and for a schema with the types the obj_defs do not use (unions,
+ * enums, fixed, nested and recursive records). Needs no GPUdb server.
+ *
+ * The writer may escape a string differently (e.g. \u0001 for a raw
+ * control character), so strings are compared by the characters they
+ * decode to. The sample numbers are ones avro-cpp writes exactly; it
+ * writes doubles with 6 significant digits where the writer is lossless.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "obj_defs/actorlist.h"
+#include "obj_defs/actorobject.h"
+#include "obj_defs/filterbystringresponse.h"
+#include "Utils/AvroJsonWriter.h"
+#include "check.h"
+
+#include <avro/NodeImpl.hh>
+
+
+// --------------------------------------------------------------------------
+// Sample values generated from a schema
+
+static const char* const SAMPLE_STRINGS[] = {
+    "",
+    "plain",
+    "\"quoted\" back\\slash path/to",
+    "\b\f\n\r\t controls \x01\x1f",
+    "utf-8 \xc3\xa9\xe2\x82\xac"
+};
+static const int32_t SAMPLE_INTS[]    = { 0, -1, 1, 63, -64, 2147483647, -2147483647 - 1 };
+static const int64_t SAMPLE_LONGS[]   = { 0, -1, 1099511627776LL, -9223372036854775807LL - 1, 9223372036854775807LL };
+static const double  SAMPLE_DOUBLES[] = { 0, 1.5, -20.25, 0.1, 123456, 2.5e-05, -1e+100 };
+static const float   SAMPLE_FLOATS[]  = { 0, 1.5f, -0.25f, 3, 0.1f };
+
+#define SAMPLE( values, n ) values[ ( n ) % ( sizeof( values ) / sizeof( values[0] ) ) ]
+
+
+// Encodes a sample value of the schema node with the encoder, the same
+// calls as avro::encode() makes; n varies the values, depth stops recursion
+static void encode_sample( const avro::NodePtr& schema_node, avro::Encoder& e, size_t& n, int depth )
+{
+    avro::NodePtr node = ( schema_node->type() == avro::AVRO_SYMBOLIC ) ? avro::resolveSymbol( schema_node ) : schema_node;
+    ++n;
+
+    switch ( node->type() )
+    {
+        case avro::AVRO_NULL:    e.encodeNull(); break;
+        case avro::AVRO_BOOL:    e.encodeBool( ( n % 2 ) == 0 ); break;
+        case avro::AVRO_INT:     e.encodeInt( SAMPLE( SAMPLE_INTS, n ) ); break;
+        case avro::AVRO_LONG:    e.encodeLong( SAMPLE( SAMPLE_LONGS, n ) ); break;
+        case avro::AVRO_FLOAT:   e.encodeFloat( SAMPLE( SAMPLE_FLOATS, n ) ); break;
+        case avro::AVRO_DOUBLE:  e.encodeDouble( SAMPLE( SAMPLE_DOUBLES, n ) ); break;
+        case avro::AVRO_STRING:  e.encodeString( SAMPLE( SAMPLE_STRINGS, n ) ); break;
+        case avro::AVRO_ENUM:    e.encodeEnum( n % node->names() ); break;
+
+        case avro::AVRO_BYTES:
+        case avro::AVRO_FIXED:
+        {
+            // Every byte value, 0-255, or the fixed size of them
+            std::vector<uint8_t> bytes( ( node->type() == avro::AVRO_FIXED ) ? (size_t)node->fixedSize() : 256 );
+            for ( size_t i = 0; i < bytes.size(); ++i )
+                bytes[ i ] = (uint8_t)( n + i );
+            if ( node->type() == avro::AVRO_FIXED )
+                e.encodeFixed( bytes.empty() ? NULL : &bytes[0], bytes.size() );
+            else
+                e.encodeBytes( &bytes[0], bytes.size() );
+            break;
+        }
+
+        case avro::AVRO_RECORD:
+            for ( size_t i = 0; i < node->leaves(); ++i )
+                encode_sample( node->leafAt( (int)i ), e, n, depth + 1 );
+            break;
+
+        case avro::AVRO_ARRAY:
+        case avro::AVRO_MAP:
+        {
+            // Alternately empty and two items, always empty when deep
+            size_t items = ( ( depth < 4 ) && ( n % 2 ) ) ? 2 : 0;
+            bool is_map = ( node->type() == avro::AVRO_MAP );
+            if ( is_map )
+                e.mapStart();
+            else
+                e.arrayStart();
+            if ( items > 0 )
+                e.setItemCount( items );
+            for ( size_t i = 0; i < items; ++i )
+            {
+                e.startItem();
+                if ( is_map )
+                    e.encodeString( std::string( "key \"" ) + (char)( 'a' + i ) + "\"" );
+                encode_sample( node->leafAt( is_map ? 1 : 0 ), e, n, depth + 1 );
+            }
+            if ( is_map )
+                e.mapEnd();
+            else
+                e.arrayEnd();
+            break;
+        }
+
+        case avro::AVRO_UNION:
+        {
+            // Every branch in turn, null when deep
+            size_t branch = n % node->leaves();
+            if ( depth >= 4 )
+                for ( size_t i = 0; i < node->leaves(); ++i )
+                    if ( node->leafAt( (int)i )->type() == avro::AVRO_NULL )
+                        branch = i;
+            e.encodeUnionIndex( branch );
+            encode_sample( node->leafAt( (int)branch ), e, n, depth + 1 );
+            break;
+        }
+
+        default:
+            throw avro::Exception( "check_json_writer: unexpected schema type" );
+    }
+}  // end encode_sample
+
+
+
+// --------------------------------------------------------------------------
+// Json comparison
+
+// The json with each string replaced by the characters it decodes to,
+// written as \u escapes, so differently escaped strings compare equal
+static std::string canonical_json( const std::string& json )
+{
+    std::string out;
+    char buf[ 8 ];
+    for ( size_t i = 0; i < json.size(); ++i )
+    {
+        if ( json[ i ] != '"' )
+        {
+            out.push_back( json[ i ] );
+            continue;
+        }
+
+        out.push_back( '"' );
+        for ( ++i; ( i < json.size() ) && ( json[ i ] != '"' ); ++i )
+        {
+            unsigned long c = (uint8_t)json[ i ];
+            if ( ( c == '\\' ) && ( i + 1 < json.size() ) )
+            {
+                char escape = json[ ++i ];
+                switch ( escape )
+                {
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'n': c = '\n'; break;
+                    case 'r': c = '\r'; break;
+                    case 't': c = '\t'; break;
+                    case 'u':
+                        c = strtoul( json.substr( i + 1, 4 ).c_str(), NULL, 16 );
+                        i += 4;
+                        break;
+                    default:  c = (uint8_t)escape; break;
+                }
+            }
+            sprintf( buf, "\\u%04lx", c );
+            out += buf;
+        }
+        out.push_back( '"' );
+    }
+    return out;
+}
+
+
+// The json avro::jsonEncoder() writes for the value encode() encodes
+template <class F>
+static std::string avro_json( const avro::ValidSchema& schema, F encode )
+{
+    avro::EncoderPtr e = avro::jsonEncoder( schema );
+    gpudb::AvroMemoryOutputStream out;
+    e->init( out );
+    encode( *e );
+    e->flush();
+
+    std::string json;
+    out.getBuffer( json );
+    return json;
+}
+
+
+// The json AvroJsonWriter writes for the value encode() encodes
+template <class F>
+static std::string writer_json( const avro::ValidSchema& schema, F encode )
+{
+    gpudb::AvroJsonWriter writer( schema );
+    std::string json;
+    writer.init( json );
+    encode( writer );
+    writer.flush();
+    return json;
+}
+
+
+template <class F>
+static void compare( const char* what, const avro::ValidSchema& schema, F encode )
+{
+    try
+    {
+        std::string expected = avro_json( schema, encode );
+        std::string actual   = writer_json( schema, encode );
+        if ( !CHECK( canonical_json( actual ) == canonical_json( expected ) ) )
+            std::cerr << what << ":\n  avro:   " << expected << "\n  writer: " << actual << std::endl;
+    }
+    catch ( const std::exception& e )
+    {
+        CHECK( !"unexpected exception" );
+        std::cerr << what << ": " << e.what() << std::endl;
+    }
+}
+
+
+// Encodes a sample value of the schema, starting at the given sample
+struct sample_encoder
+{
+    const avro::ValidSchema& schema;
+    size_t                   first;
+
+    explicit sample_encoder( const avro::ValidSchema& s, size_t f = 0 ) : schema( s ), first( f ) {}
+
+    void operator()( avro::Encoder& e ) const
+    {
+        size_t n = first;
+        encode_sample( schema.root(), e, n, 0 );
+    }
+};
+
+
+// Encodes an object with its codec_traits
+template <class T>
+struct object_encoder
+{
+    const T& object;
+
+    explicit object_encoder( const T& o ) : object( o ) {}
+
+    void operator()( avro::Encoder& e ) const { avro::encode( e, object ); }
+};
+
+
+// Fill an object of the type with sample values (by decoding their binary
+// encoding) and compare the json of it; twice, so each array and map is
+// empty once and not once
+template <class T>
+static void compare_type( const char* what )
+{
+    for ( size_t first = 0; first < 2; ++first )
+    {
+        T object;
+        try
+        {
+            gpudb::AvroMemoryOutputStream out;
+            avro::EncoderPtr e = avro::binaryEncoder();
+            e->init( out );
+            sample_encoder sample( T::schema(), first );
+            sample( *e );
+            e->flush();
+
+            std::vector<uint8_t> bytes;
+            out.getBuffer( bytes );
+            if ( !CHECK( gpudb::AvroUtils::convert_to_object( bytes, object ) ) )
+                return;
+        }
+        catch ( const std::exception& e )
+        {
+            CHECK( !"unexpected exception" );
+            std::cerr << what << ": " << e.what() << std::endl;
+            return;
+        }
+
+        compare( what, T::schema(), object_encoder<T>( object ) );
+    }
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    // gpudb_response_view has no encoder; gpudb_response has its schema
+    compare_type<gpudb::actor_list>( "actor_list" );
+    compare_type<gpudb::actor_object>( "actor_object" );
+    compare_type<gpudb::add_object_request>( "add_object_request" );
+    compare_type<gpudb::add_object_response>( "add_object_response" );
+    compare_type<gpudb::bounding_box_request>( "bounding_box_request" );
+    compare_type<gpudb::bounding_box_response>( "bounding_box_response" );
+    compare_type<gpudb::bulk_add_request>( "bulk_add_request" );
+    compare_type<gpudb::bulk_add_response>( "bulk_add_response" );
+    compare_type<gpudb::clear_request>( "clear_request" );
+    compare_type<gpudb::clear_response>( "clear_response" );
+    compare_type<gpudb::filter_by_string_response>( "filter_by_string_response" );
+    compare_type<gpudb::get_set_flat_response>( "get_set_flat_response" );
+    compare_type<gpudb::get_set_request>( "get_set_request" );
+    compare_type<gpudb::get_set_response>( "get_set_response" );
+    compare_type<gpudb::gpudb_response>( "gpudb_response" );
+    compare_type<gpudb::new_set_request>( "new_set_request" );
+    compare_type<gpudb::new_set_response>( "new_set_response" );
+    compare_type<gpudb::register_parent_set_request>( "register_parent_set_request" );
+    compare_type<gpudb::register_parent_set_response>( "register_parent_set_response" );
+    compare_type<gpudb::register_type_request>( "register_type_request" );
+    compare_type<gpudb::register_type_response>( "register_type_response" );
+    compare_type<gpudb::status_request>( "status_request" );
+    compare_type<gpudb::status_response>( "status_response" );
+
+    // The types the obj_defs do not use, as user types may
+    std::string sample_type =
+        "{\"type\":\"record\",\"name\":\"sample\",\"fields\":["
+            "{\"name\":\"id\",\"type\":\"long\"},"
+            "{\"name\":\"speed\",\"type\":\"float\"},"
+            "{\"name\":\"value\",\"type\":[\"null\",\"string\",\"double\",\"boolean\",\"int\",\"bytes\","
+                "{\"type\":\"record\",\"name\":\"point\",\"fields\":[{\"name\":\"x\",\"type\":\"double\"},{\"name\":\"y\",\"type\":\"double\"}]}]},"
+            "{\"name\":\"kind\",\"type\":{\"type\":\"enum\",\"name\":\"kind\",\"symbols\":[\"A\",\"B\",\"C\"]}},"
+            "{\"name\":\"hash\",\"type\":{\"type\":\"fixed\",\"name\":\"hash\",\"size\":4}},"
+            "{\"name\":\"points\",\"type\":{\"type\":\"array\",\"items\":\"point\"}},"
+            "{\"name\":\"counts\",\"type\":{\"type\":\"map\",\"values\":[\"null\",\"long\",{\"type\":\"array\",\"items\":\"string\"}]}},"
+            "{\"name\":\"next\",\"type\":[\"null\",\"sample\"]}"
+        "]}";
+    avro::ValidSchema sample_schema = avro::compileJsonSchemaFromString( sample_type );
+    for ( size_t first = 0; first < 8; ++first )
+        compare( "sample (unions, enum, fixed, nested records)", sample_schema, sample_encoder( sample_schema, first ) );
+
+    return check::result( "check_json_writer" );
+}  // end main
@@ -0,0 +1,147 @@
+/* **********************************
+ * GPUdb C++ API Check: parallel bulk_add encoding
+ *
+ * Checks that the objects of a bulk_add encoded on a WorkerPool land in
+ * the request in their order, and that the object reported as failed is
+ * the first one a serial loop would have stopped at, whatever the number
+ * of threads, the grain and the failed objects. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "check.h"
+
+
+// A user type; objects with a negative id fail to encode
+struct numbered
+{
+    int64_t             id;
+    std::string         name;
+    std::vector<double> values;
+};
+
+static const char* NUMBERED_SCHEMA =
+    "{\"type\":\"record\",\"name\":\"numbered\",\"fields\":["
+        "{\"name\":\"id\",\"type\":\"long\"},"
+        "{\"name\":\"name\",\"type\":\"string\"},"
+        "{\"name\":\"values\",\"type\":{\"type\":\"array\",\"items\":\"double\"}}]}";
+
+namespace avro
+{
+template <> struct codec_traits<numbered>
+{
+    static void encode( Encoder& e, const numbered& v )
+    {
+        if ( v.id < 0 )
+            throw avro::Exception( "numbered: negative id" );
+        avro::encode( e, v.id );
+        avro::encode( e, v.name );
+        avro::encode( e, v.values );
+    }
+    static void decode( Decoder& d, numbered& v )
+    {
+        avro::decode( d, v.id );
+        avro::decode( d, v.name );
+        avro::decode( d, v.values );
+    }
+};
+}  // end namespace avro
+
+
+static std::vector<numbered> make_objects( size_t n, const std::set<size_t>& failed )
+{
+    std::vector<numbered> objects( n );
+    char buf[ 32 ];
+    for ( size_t i = 0; i < n; ++i )
+    {
+        objects[ i ].id = failed.count( i ) ? -1 : (int64_t)i;
+        sprintf( buf, "object %lu", (unsigned long)i );
+        objects[ i ].name = buf;
+        objects[ i ].values.assign( i % 5, i * 0.5 );
+    }
+    return objects;
+}
+
+
+// Encode the objects on the pool (NULL for the calling thread) both ways
+// and check the results against a serial encoding of each object
+static void check_encoding( gpudb::WorkerPool* pool, size_t n, size_t grain, const std::set<size_t>& failed )
+{
+    std::vector<numbered> objects = make_objects( n, failed );
+    size_t expected_failed = failed.empty() ? gpudb::WorkerPool::ItemTask::NONE : *failed.begin();
+    const avro::ValidSchema& schema = gpudb::AvroUtils::get_or_compile_schema( NUMBERED_SCHEMA );
+
+    std::vector<std::vector<uint8_t> > list( n );
+    gpudb::bulk_add_binary_task<numbered> binary_task( objects, list, grain );
+    binary_task.run_on( pool );
+
+    std::vector<std::string> list_str( n );
+    gpudb::bulk_add_json_task<numbered> json_task( objects, schema, list_str, grain );
+    json_task.run_on( pool );
+
+    bool ok = CHECK( binary_task.first_failed() == expected_failed ) &&
+              CHECK( json_task.first_failed() == expected_failed );
+
+    // Every object before the first failed one is encoded, in its place
+    size_t encoded = failed.empty() ? n : expected_failed;
+    for ( size_t i = 0; ok && ( i < encoded ); ++i )
+    {
+        std::vector<uint8_t> bytes;
+        std::string json;
+        gpudb::AvroUtils::convert_to_bytes( objects[ i ], bytes );
+        gpudb::AvroUtils::convert_to_json_by_schema( objects[ i ], schema, json );
+        ok = CHECK( list[ i ] == bytes ) && CHECK( list_str[ i ] == json );
+    }
+
+    if ( !ok )
+        std::cerr << "  with " << ( pool ? pool->num_threads() : 0 ) << " threads, " << n
+                  << " objects, grain " << grain << ", " << failed.size() << " failed objects" << std::endl;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    srand( 42 );
+
+    gpudb::WorkerPool pool_2( 2 );
+    gpudb::WorkerPool pool_4( 4 );
+    gpudb::WorkerPool pool_8( 8 );
+    gpudb::WorkerPool* pools[] = { NULL, &pool_2, &pool_4, &pool_8 };
+
+    for ( size_t p = 0; p < sizeof( pools ) / sizeof( pools[0] ); ++p )
+    {
+        for ( size_t trial = 0; trial < 50; ++trial )
+        {
+            size_t n = 1 + trial * 97;
+            size_t grain = 1 + trial % 16;
+
+            // None failed, then one to four failures anywhere, including
+            // the first and last objects and the start of a range
+            std::set<size_t> failed;
+            if ( trial % 5 == 1 )
+                failed.insert( 0 );
+            else if ( trial % 5 == 2 )
+                failed.insert( n - 1 );
+            else if ( trial % 5 == 3 )
+                failed.insert( ( n / grain / 2 ) * grain );
+            if ( trial % 5 != 0 )
+                for ( size_t f = rand() % 4; f > 0; --f )
+                    failed.insert( rand() % n );
+
+            check_encoding( pools[ p ], n, grain, failed );
+        }
+    }
+
+    return check::result( "check_parallel_encoding" );
+}  // end main
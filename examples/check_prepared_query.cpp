@@ -0,0 +1,106 @@
+/* **********************************
+ * GPUdb C++ API Check: prepared queries
+ *
+ * Checks that the bytes a PreparedQuery sends are the full binary encoding
+ * of its request (AvroUtils::convert_to_bytes), as the numeric fields it
+ * patches change: get_set's start and end, whose varints grow and shrink,
+ * and bounding_box's doubles. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "check.h"
+
+
+template <class Treq>
+static bool check_bytes( gpudb::PreparedQuery<Treq>& prepared )
+{
+    std::vector<uint8_t> expected;
+    gpudb::AvroUtils::convert_to_bytes( prepared.request(), expected );
+    return CHECK( prepared.bytes() == expected );
+}
+
+
+static void check_get_set( gpudb::PreparedQuery<gpudb::get_set_request>& prepared, int64_t start, int64_t end )
+{
+    prepared.request().start = start;
+    prepared.request().end = end;
+    if ( !check_bytes( prepared ) )
+        std::cerr << "  for get_set start " << (long long)start << ", end " << (long long)end << std::endl;
+}
+
+
+static void check_bounding_box( gpudb::PreparedQuery<gpudb::bounding_box_request>& prepared,
+                                double min_x, double max_x, double min_y, double max_y )
+{
+    prepared.request().min_x = min_x;
+    prepared.request().max_x = max_x;
+    prepared.request().min_y = min_y;
+    prepared.request().max_y = max_y;
+    if ( !check_bytes( prepared ) )
+        std::cerr << "  for bounding_box " << min_x << ", " << max_x << ", " << min_y << ", " << max_y << std::endl;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    const int64_t big = (int64_t)1 << 40;
+    const int64_t max = std::numeric_limits<int64_t>::max();
+    const int64_t min = std::numeric_limits<int64_t>::min();
+
+    gpudb::get_set_request get_set;
+    get_set.set_id = "points";
+    get_set.semantic_type = "POINT";
+    gpudb::PreparedQuery<gpudb::get_set_request> get_set_query( get_set );
+    check_bytes( get_set_query );
+
+    // Each varint grows from 1 to 6 bytes and shrinks back, alone and together
+    check_get_set( get_set_query, 0, 0 );
+    check_get_set( get_set_query, big, 0 );
+    check_get_set( get_set_query, 5, 0 );
+    check_get_set( get_set_query, 5, big );
+    check_get_set( get_set_query, 0, 5 );
+    check_get_set( get_set_query, big, big + 100 );
+    check_get_set( get_set_query, 0, 5 );
+
+    // The longest and negative varints, and every length in turn
+    check_get_set( get_set_query, max, min );
+    check_get_set( get_set_query, -1, 1 );
+    check_get_set( get_set_query, min, -big );
+    for ( int shift = 0; shift < 63; ++shift )
+        check_get_set( get_set_query, (int64_t)1 << shift, (int64_t)1 << ( 62 - shift ) );
+    check_get_set( get_set_query, 0, 0 );
+
+    // The other fields are sent as of the last prepare()
+    get_set_query.request().set_id = "lines";
+    get_set_query.request().start = big;
+    if ( CHECK( get_set_query.prepare() ) )
+        check_bytes( get_set_query );
+    check_get_set( get_set_query, 1, 2 );
+
+    gpudb::bounding_box_request bounding_box;
+    bounding_box.x_attr_name = "x";
+    bounding_box.y_attr_name = "y";
+    bounding_box.set_id = "points";
+    bounding_box.result_set_id = "in_box";
+    gpudb::PreparedQuery<gpudb::bounding_box_request> bounding_box_query( bounding_box );
+    check_bytes( bounding_box_query );
+
+    const double inf = std::numeric_limits<double>::infinity();
+    check_bounding_box( bounding_box_query, -180, 180, -90, 90 );
+    check_bounding_box( bounding_box_query, 0.1, -0.0, 1e-310, 1e308 );
+    check_bounding_box( bounding_box_query, -inf, inf, std::numeric_limits<double>::quiet_NaN(), 0 );
+    check_bounding_box( bounding_box_query, 12.5, 12.75, -33.125, -33 );
+
+    return check::result( "check_prepared_query" );
+}  // end main
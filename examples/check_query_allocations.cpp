@@ -0,0 +1,152 @@
+/* **********************************
+ * GPUdb C++ API Check: allocations per query
+ *
+ * Counts the heap allocations of repeated /status queries made the way
+ * GPUdb used to (a connection opened per call through HTTPUtils, the
+ * request encoded into a new buffer and the response's data copied out)
+ * and through a GPUdb handle, which keeps its connection and buffers
+ * between queries, and checks that the handle allocates less per query.
+ * Needs a running GPUdb, like the example_* programs.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "check.h"
+
+
+// Every operator new of the program (operator new[] calls it) is counted
+static size_t g_allocations = 0;
+
+#if __cplusplus >= 201103L
+void* operator new( size_t size )
+#else
+void* operator new( size_t size ) throw( std::bad_alloc )
+#endif
+{
+    ++g_allocations;
+    void* p = malloc( size ? size : 1 );
+    if ( p == NULL )
+        throw std::bad_alloc();
+    return p;
+}
+
+#if __cplusplus >= 201103L
+void operator delete( void* p ) noexcept
+#else
+void operator delete( void* p ) throw()
+#endif
+{
+    free( p );
+}
+
+
+static const char* IP = "127.0.0.1";
+static const int PORT = 9191;
+static const char* SET_ID = "allocations_set";
+
+
+// A /status query the old way: a connection per call and copies of the data
+static bool old_status( const gpudb::status_request& request, gpudb::status_response& response )
+{
+    char port[ 16 ];
+    sprintf( port, "%d", PORT );
+
+    std::vector<uint8_t> avro_data;
+    gpudb::AvroUtils::convert_to_bytes( request, avro_data );
+    gpudb::gpudb_response gresponse = gpudb::HTTPUtils::call_gpudb( avro_data, gpudb::EndpointTraits<gpudb::status_request>::endpoint(),
+                                                                   IP, port, "", "", 60 );
+    return ( gresponse.status == "OK" ) && gpudb::AvroUtils::convert_to_object( gresponse.data, response );
+}
+
+
+// The allocations per query of count queries, after one to warm up
+template <class F>
+static double allocations_per_query( F query, size_t count )
+{
+    if ( !query() )
+        return -1;
+
+    size_t before = g_allocations;
+    for ( size_t i = 0; i < count; ++i )
+        if ( !query() )
+            return -1;
+    return (double)( g_allocations - before ) / (double)count;
+}
+
+
+// The two ways of making the query, as functors
+struct old_query
+{
+    gpudb::status_request& request;
+    gpudb::status_response& response;
+    old_query( gpudb::status_request& req, gpudb::status_response& resp ) : request( req ), response( resp ) {}
+    bool operator()() { return old_status( request, response ); }
+};
+
+struct handle_query
+{
+    GPUdb& gpudb;
+    gpudb::status_request& request;
+    gpudb::status_response& response;
+    handle_query( GPUdb& g, gpudb::status_request& req, gpudb::status_response& resp ) :
+        gpudb( g ), request( req ), response( resp ) {}
+    bool operator()() { return gpudb.status( request, response ); }
+};
+
+
+
+int main( int argc, char* argv[] )
+{
+    const size_t num_queries = 200;
+
+    // Replace IP and PORT above with the address of your GPUdb
+    GPUdb gpudb( IP, PORT, "BINARY" );
+    if ( gpudb.status() == gpudb::ERROR )
+    {
+        std::cerr << "Error in creating GPUdb handler: " << gpudb.error_message() << std::endl;
+        return 1;
+    }
+
+    // A set to query the status of
+    std::string point_type = "{\"type\":\"record\",\"name\":\"point\",\"fields\":[{\"name\":\"x\",\"type\":\"double\"},{\"name\":\"y\",\"type\":\"double\"},{\"name\":\"OBJECT_ID\",\"type\":\"string\"}]}";
+    gpudb::clear_response clear_resp;
+    gpudb.clear( SET_ID, "", clear_resp );
+    gpudb::register_type_response register_type_resp;
+    gpudb::new_set_response new_set_resp;
+    if ( !gpudb.register_type( point_type, "", "", "POINT", register_type_resp ) ||
+         !gpudb.new_set( register_type_resp.type_id, SET_ID, "", new_set_resp ) )
+    {
+        std::cerr << "Error in creating " << SET_ID << ": " << gpudb.error_message() << std::endl;
+        return 1;
+    }
+
+    gpudb::status_request request;
+    request.set_id = SET_ID;
+    gpudb::status_response response;
+
+    double old_allocations = allocations_per_query( old_query( request, response ), num_queries );
+    double new_allocations = allocations_per_query( handle_query( gpudb, request, response ), num_queries );
+
+    if ( CHECK( old_allocations >= 0 ) && CHECK( new_allocations >= 0 ) )
+    {
+        printf( "allocations per /status query: %.1f per call through HTTPUtils, %.1f through a GPUdb handle\n",
+                old_allocations, new_allocations );
+        CHECK( new_allocations < old_allocations );
+    }
+    else
+        std::cerr << "Error in querying the status of " << SET_ID << ": " << gpudb.error_message() << std::endl;
+
+    gpudb.clear( SET_ID, "", clear_resp );
+
+    return check::result( "check_query_allocations" );
+}  // end main
@@ -0,0 +1,541 @@
+/* **********************************
+ * GPUdb C++ API Check: AvroRecordView
+ *
+ * Checks that the fields an AvroRecordView reads out of binary encoded
+ * records are those of a full avro::GenericDatum decode, whatever the
+ * projection, when the fields it skips hold arrays and maps written in
+ * blocks (some with a negative count and a size in bytes), map keys, union
+ * branches, enums, fixed and nested and recursive records; that read_column()
+ * and for_each() agree with it; and that truncated or invalid records,
+ * nesting deeper than the view's limit and bad projections are rejected.
+ * Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <avro/Decoder.hh>
+#include <avro/Encoder.hh>
+#include <avro/Generic.hh>
+#include <avro/Node.hh>
+#include <avro/NodeImpl.hh>
+
+#include "GPUdb.h"
+#include "Utils/AvroRecordView.h"
+#include "check.h"
+
+
+// The primitive fields are separated by fields of every other kind
+static const char* WIDE_SCHEMA =
+    "{\"type\":\"record\",\"name\":\"wide\",\"fields\":["
+    "{\"name\":\"flag\",\"type\":\"boolean\"},"
+    "{\"name\":\"tags\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},"
+    "{\"name\":\"i\",\"type\":\"int\"},"
+    "{\"name\":\"attrs\",\"type\":{\"type\":\"map\",\"values\":{\"type\":\"array\",\"items\":\"long\"}}},"
+    "{\"name\":\"l\",\"type\":\"long\"},"
+    "{\"name\":\"maybe\",\"type\":[\"null\",\"double\",\"string\","
+        "{\"type\":\"record\",\"name\":\"point\",\"fields\":[{\"name\":\"x\",\"type\":\"double\"},{\"name\":\"y\",\"type\":\"double\"}]}]},"
+    "{\"name\":\"f\",\"type\":\"float\"},"
+    "{\"name\":\"color\",\"type\":{\"type\":\"enum\",\"name\":\"color\",\"symbols\":[\"RED\",\"GREEN\",\"BLUE\"]}},"
+    "{\"name\":\"hash\",\"type\":{\"type\":\"fixed\",\"name\":\"hash\",\"size\":5}},"
+    "{\"name\":\"d\",\"type\":\"double\"},"
+    "{\"name\":\"tree\",\"type\":{\"type\":\"record\",\"name\":\"tree\",\"fields\":["
+        "{\"name\":\"value\",\"type\":\"int\"},{\"name\":\"children\",\"type\":{\"type\":\"array\",\"items\":\"tree\"}}]}},"
+    "{\"name\":\"s\",\"type\":\"string\"},"
+    "{\"name\":\"where\",\"type\":\"point\"},"
+    "{\"name\":\"nothing\",\"type\":\"null\"},"
+    "{\"name\":\"b\",\"type\":\"bytes\"},"
+    "{\"name\":\"opt\",\"type\":[\"null\",\"long\"]},"
+    "{\"name\":\"last\",\"type\":\"int\"}]}";
+
+// A recursive record followed by an int
+static const char* NEST_SCHEMA =
+    "{\"type\":\"record\",\"name\":\"nest\",\"fields\":["
+    "{\"name\":\"tree\",\"type\":{\"type\":\"record\",\"name\":\"tree\",\"fields\":["
+        "{\"name\":\"value\",\"type\":\"int\"},{\"name\":\"children\",\"type\":{\"type\":\"array\",\"items\":\"tree\"}}]}},"
+    "{\"name\":\"after\",\"type\":\"int\"}]}";
+
+static const char* SMALL_SCHEMA =
+    "{\"type\":\"record\",\"name\":\"small\",\"fields\":["
+    "{\"name\":\"u\",\"type\":[\"null\",\"int\"]},"
+    "{\"name\":\"flag\",\"type\":\"boolean\"},"
+    "{\"name\":\"s\",\"type\":\"string\"}]}";
+
+
+// A deterministic pseudo random sequence
+struct random_values
+{
+    uint64_t state;
+
+    explicit random_values( uint64_t seed ) : state( seed ) {}
+
+    uint64_t next()
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 16;
+    }
+
+    size_t below( size_t n ) { return (size_t)( next() % n ); }
+
+    // Of every magnitude, so that varints of every length are written
+    int64_t any_long() { return (int64_t)( ( next() << 32 ) ^ next() ) >> below( 64 ); }
+    int32_t any_int()  { return (int32_t)( any_long() >> 32 ) >> below( 32 ); }
+    double  any_double() { return (double)any_long() / (double)( 1 + below( 1000 ) ); }
+
+    std::string any_string()
+    {
+        std::string s( ( below( 4 ) == 0 ) ? below( 300 ) : below( 10 ), ' ' );
+        for ( size_t i = 0; i < s.size(); ++i )
+            s[ i ] = (char)( 'a' + below( 26 ) );
+        return s;
+    }
+};
+
+
+static void write_value( avro::Encoder& e, const avro::NodePtr& schema_node, random_values& r, int depth );
+
+
+// Write the items of an array or map in a few blocks, each either with its
+// count or with its negated count and its size in bytes
+static void write_blocks( avro::Encoder& e, const avro::NodePtr& n, random_values& r, int depth )
+{
+    size_t num_blocks = ( depth > 6 ) ? 0 : r.below( 4 );
+    for ( size_t block = 0; block < num_blocks; ++block )
+    {
+        size_t count = 1 + r.below( 5 );
+        bool sized = ( r.below( 2 ) == 1 );
+
+        std::vector<uint8_t> bytes;
+        gpudb::AvroMemoryOutputStream out( bytes );
+        avro::EncoderPtr items = avro::binaryEncoder();
+        items->init( out );
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( n->type() == avro::AVRO_MAP )
+            {
+                items->encodeString( r.any_string() );
+                write_value( *items, n->leafAt( 1 ), r, depth );
+            }
+            else
+                write_value( *items, n->leafAt( 0 ), r, depth );
+        }
+        items->flush();
+
+        if ( sized )
+        {
+            e.encodeLong( -(int64_t)count );
+            e.encodeLong( (int64_t)bytes.size() );
+        }
+        else
+            e.encodeLong( (int64_t)count );
+        if ( !bytes.empty() )
+            e.encodeFixed( &bytes[ 0 ], bytes.size() );
+    }
+    e.encodeLong( 0 );
+}
+
+
+// Write a random value of the schema node
+static void write_value( avro::Encoder& e, const avro::NodePtr& schema_node, random_values& r, int depth )
+{
+    avro::NodePtr n = ( schema_node->type() == avro::AVRO_SYMBOLIC ) ? avro::resolveSymbol( schema_node ) : schema_node;
+    switch ( n->type() )
+    {
+    case avro::AVRO_NULL:   e.encodeNull(); break;
+    case avro::AVRO_BOOL:   e.encodeBool( r.below( 2 ) == 1 ); break;
+    case avro::AVRO_INT:    e.encodeInt( r.any_int() ); break;
+    case avro::AVRO_LONG:   e.encodeLong( r.any_long() ); break;
+    case avro::AVRO_FLOAT:  e.encodeFloat( (float)r.any_double() ); break;
+    case avro::AVRO_DOUBLE: e.encodeDouble( r.any_double() ); break;
+    case avro::AVRO_STRING: e.encodeString( r.any_string() ); break;
+    case avro::AVRO_ENUM:   e.encodeEnum( r.below( n->names() ) ); break;
+
+    case avro::AVRO_BYTES:
+    {
+        std::string s = r.any_string();
+        s += (char)r.below( 256 );
+        e.encodeBytes( (const uint8_t*)s.data(), s.size() );
+        break;
+    }
+
+    case avro::AVRO_FIXED:
+    {
+        std::vector<uint8_t> fixed( (size_t)n->fixedSize() );
+        for ( size_t i = 0; i < fixed.size(); ++i )
+            fixed[ i ] = (uint8_t)r.below( 256 );
+        e.encodeFixed( &fixed[ 0 ], fixed.size() );
+        break;
+    }
+
+    case avro::AVRO_UNION:
+    {
+        size_t branch = r.below( n->leaves() );
+        e.encodeUnionIndex( branch );
+        write_value( e, n->leafAt( (int)branch ), r, depth );
+        break;
+    }
+
+    case avro::AVRO_RECORD:
+        for ( size_t i = 0; i < n->leaves(); ++i )
+            write_value( e, n->leafAt( (int)i ), r, depth + 1 );
+        break;
+
+    default: // arrays and maps
+        write_blocks( e, n, r, depth + 1 );
+        break;
+    }
+}
+
+
+static void encode_record( const avro::ValidSchema& schema, random_values& r, std::vector<uint8_t>& bytes )
+{
+    gpudb::AvroMemoryOutputStream out( bytes );
+    avro::EncoderPtr e = avro::binaryEncoder();
+    e->init( out );
+    write_value( *e, schema.root(), r, 0 );
+    e->flush();
+}
+
+
+// A full decode of the first len bytes of the record; false if avro rejects them
+static bool decode_record( const avro::ValidSchema& schema, const std::vector<uint8_t>& bytes, size_t len,
+                           avro::GenericDatum& datum )
+{
+    try
+    {
+        gpudb::AvroMemoryInputStream in( bytes.empty() ? NULL : &bytes[ 0 ], len );
+        avro::DecoderPtr d = avro::binaryDecoder();
+        d->init( in );
+        datum = avro::GenericDatum( schema );
+        avro::decode( *d, datum );
+        return true;
+    }
+    catch ( const std::exception& )
+    {
+        return false;
+    }
+}
+
+
+// Check projected field i of the record last read against the decoded field;
+// numbers may be read as wider types but not as narrower ones
+static bool check_field( const gpudb::AvroRecordView& view, size_t i, const avro::GenericDatum& field )
+{
+    bool               b;
+    int32_t            iv;
+    int64_t            l;
+    float              f;
+    double             d;
+    std::string        s;
+    gpudb::bytes_view  bytes;
+
+    switch ( view.field_type( i ) )
+    {
+    case avro::AVRO_BOOL:
+        return CHECK( view.get( i, b ) ) && CHECK( b == field.value<bool>() ) &&
+               CHECK( !view.get_int( i, iv ) ) && CHECK( !view.get_double( i, d ) );
+
+    case avro::AVRO_INT:
+        return CHECK( view.get( i, iv ) ) && CHECK( iv == field.value<int32_t>() ) &&
+               CHECK( view.get_long( i, l ) ) && CHECK( l == iv ) &&
+               CHECK( view.get_double( i, d ) ) && CHECK( d == iv ) &&
+               CHECK( !view.get_float( i, f ) ) && CHECK( !view.get_bool( i, b ) );
+
+    case avro::AVRO_LONG:
+        return CHECK( view.get( i, l ) ) && CHECK( l == field.value<int64_t>() ) &&
+               CHECK( view.get_double( i, d ) ) && CHECK( d == (double)l ) &&
+               CHECK( !view.get_int( i, iv ) ) && CHECK( !view.get_bytes( i, bytes ) );
+
+    case avro::AVRO_FLOAT:
+        return CHECK( view.get( i, f ) ) && CHECK( f == field.value<float>() ) &&
+               CHECK( view.get_double( i, d ) ) && CHECK( d == (double)f ) &&
+               CHECK( !view.get_long( i, l ) );
+
+    case avro::AVRO_DOUBLE:
+        return CHECK( view.get( i, d ) ) && CHECK( d == field.value<double>() ) &&
+               CHECK( !view.get_float( i, f ) ) && CHECK( !view.get_long( i, l ) );
+
+    case avro::AVRO_STRING:
+        return CHECK( view.get( i, s ) ) && CHECK( s == field.value<std::string>() ) &&
+               CHECK( view.get( i, bytes ) ) && CHECK( bytes == s ) && CHECK( !view.get_double( i, d ) );
+
+    case avro::AVRO_BYTES:
+        return CHECK( view.get( i, bytes ) ) && CHECK( bytes.vec() == field.value<std::vector<uint8_t> >() ) &&
+               CHECK( view.get( i, s ) ) && CHECK( bytes == s ) && CHECK( !view.get_long( i, l ) );
+
+    default:
+        return CHECK( false );
+    }
+}
+
+
+// Read the projection of every record and compare it with the full decode
+static void check_projection( const std::vector<std::vector<uint8_t> >& records,
+                              const std::vector<avro::GenericDatum>& decoded,
+                              const std::vector<std::string>& fields )
+{
+    const avro::ValidSchema& schema = gpudb::AvroUtils::get_or_compile_schema( WIDE_SCHEMA );
+    gpudb::AvroRecordView view( schema, fields );
+    gpudb::AvroRecordView from_string( WIDE_SCHEMA, fields );
+    bool ok = CHECK( view.num_fields() == fields.size() ) && CHECK( from_string.num_fields() == fields.size() );
+
+    for ( size_t n = 0; ok && ( n < records.size() ); ++n )
+    {
+        const avro::GenericRecord& record = decoded[ n ].value<avro::GenericRecord>();
+        ok = CHECK( view.read( records[ n ] ) ) && CHECK( from_string.read( records[ n ] ) );
+        for ( size_t i = 0; ok && ( i < fields.size() ); ++i )
+            ok = check_field( view, i, record.field( fields[ i ] ) ) && check_field( from_string, i, record.field( fields[ i ] ) );
+    }
+
+    if ( !ok )
+    {
+        std::cerr << "  projecting";
+        for ( size_t i = 0; i < fields.size(); ++i )
+            std::cerr << " " << fields[ i ];
+        std::cerr << std::endl;
+    }
+}
+
+
+// The value of a decoded field of each record
+template <class T>
+static std::vector<T> decoded_column( const std::vector<avro::GenericDatum>& decoded, const std::string& name )
+{
+    std::vector<T> values;
+    for ( size_t n = 0; n < decoded.size(); ++n )
+        values.push_back( decoded[ n ].value<avro::GenericRecord>().field( name ).value<T>() );
+    return values;
+}
+
+
+// Counts the records for_each() visits, stopping after stop_after of them
+struct count_records
+{
+    size_t* count;
+    size_t  stop_after;
+
+    bool operator()( gpudb::AvroRecordView& view, size_t n )
+    {
+        int32_t last;
+        CHECK( n == *count );
+        CHECK( view.get_int( 0, last ) );
+        ++*count;
+        return *count < stop_after;
+    }
+};
+
+
+// Write a chain of levels trees, each the only child of the one before, then after
+static std::vector<uint8_t> encode_nest( size_t levels, int32_t after )
+{
+    std::vector<uint8_t> bytes;
+    gpudb::AvroMemoryOutputStream out( bytes );
+    avro::EncoderPtr e = avro::binaryEncoder();
+    e->init( out );
+    for ( size_t level = 0; level < levels; ++level )
+    {
+        e->encodeInt( (int32_t)level );
+        if ( level + 1 < levels )
+            e->encodeLong( 1 ); // a block of one child
+    }
+    for ( size_t level = 0; level < levels; ++level )
+        e->encodeLong( 0 ); // the end of each children array
+    e->encodeInt( after );
+    e->flush();
+    return bytes;
+}
+
+
+static bool throws( const char* schema_str, const std::vector<std::string>& fields )
+{
+    try
+    {
+        gpudb::AvroRecordView view( std::string( schema_str ), fields );
+        return false;
+    }
+    catch ( const std::exception& )
+    {
+        return true;
+    }
+}
+
+
+static std::vector<std::string> names( const char* a, const char* b = NULL, const char* c = NULL )
+{
+    std::vector<std::string> v( 1, a );
+    if ( b != NULL )
+        v.push_back( b );
+    if ( c != NULL )
+        v.push_back( c );
+    return v;
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    const avro::ValidSchema& schema = gpudb::AvroUtils::get_or_compile_schema( WIDE_SCHEMA );
+
+    random_values r( 12345 );
+    std::vector<std::vector<uint8_t> > records( 300 );
+    std::vector<avro::GenericDatum> decoded( records.size() );
+    for ( size_t n = 0; n < records.size(); ++n )
+    {
+        encode_record( schema, r, records[ n ] );
+        CHECK( decode_record( schema, records[ n ], records[ n ].size(), decoded[ n ] ) );
+    }
+
+    // Every primitive field, in the record's order and reversed; one field
+    // at the start, in the middle or at the end; a few in another order
+    const char* primitives[] = { "flag", "i", "l", "f", "d", "s", "b", "last" };
+    std::vector<std::string> all( primitives, primitives + 8 );
+    check_projection( records, decoded, all );
+    check_projection( records, decoded, std::vector<std::string>( all.rbegin(), all.rend() ) );
+    check_projection( records, decoded, names( "flag" ) );
+    check_projection( records, decoded, names( "d" ) );
+    check_projection( records, decoded, names( "last" ) );
+    check_projection( records, decoded, names( "s", "i", "b" ) );
+
+    // Whole columns, including a bool one and an int one widened to doubles
+    {
+        gpudb::AvroRecordView view( schema, all );
+        std::vector<bool> flags;
+        std::vector<int32_t> ints;
+        std::vector<int64_t> longs;
+        std::vector<float> floats;
+        std::vector<double> doubles, widened;
+        std::vector<std::string> strings;
+        std::vector<gpudb::bytes_view> bytes;
+
+        CHECK( view.read_column( records, 0, flags ) && ( flags == decoded_column<bool>( decoded, "flag" ) ) );
+        CHECK( view.read_column( records, 1, ints ) && ( ints == decoded_column<int32_t>( decoded, "i" ) ) );
+        CHECK( view.read_column( records, 2, longs ) && ( longs == decoded_column<int64_t>( decoded, "l" ) ) );
+        CHECK( view.read_column( records, 3, floats ) && ( floats == decoded_column<float>( decoded, "f" ) ) );
+        CHECK( view.read_column( records, 4, doubles ) && ( doubles == decoded_column<double>( decoded, "d" ) ) );
+        CHECK( view.read_column( records, 5, strings ) && ( strings == decoded_column<std::string>( decoded, "s" ) ) );
+
+        std::vector<std::vector<uint8_t> > blobs = decoded_column<std::vector<uint8_t> >( decoded, "b" );
+        if ( CHECK( view.read_column( records, 6, bytes ) ) )
+        {
+            for ( size_t n = 0; n < records.size(); ++n )
+                CHECK( bytes[ n ].vec() == blobs[ n ] );
+        }
+
+        if ( CHECK( view.read_column( records, 1, widened ) ) )
+        {
+            for ( size_t n = 0; n < records.size(); ++n )
+                CHECK( widened[ n ] == (double)ints[ n ] );
+        }
+
+        CHECK( !view.read_column( records, 5, widened ) );
+        CHECK( !view.read_column( records, 2, ints ) );
+    }
+
+    // for_each() visits the records in order, and stops when told to
+    {
+        gpudb::AvroRecordView view( schema, names( "last" ) );
+        size_t count = 0;
+        count_records all_records = { &count, records.size() + 1 };
+        CHECK( view.for_each( records, all_records ) && ( count == records.size() ) );
+
+        count = 0;
+        count_records ten = { &count, 10 };
+        CHECK( !view.for_each( records, ten ) && ( count == 10 ) );
+    }
+
+    // Projecting the last field scans the whole record, so every truncation
+    // is rejected, as avro rejects it
+    {
+        gpudb::AvroRecordView view( schema, names( "last" ) );
+        for ( size_t n = 0; n < 30; ++n )
+        {
+            const std::vector<uint8_t>& record = records[ n ];
+            for ( size_t len = 0; len < record.size(); ++len )
+            {
+                avro::GenericDatum datum;
+                if ( !CHECK( !view.read( len ? &record[ 0 ] : NULL, len ) ) ||
+                     !CHECK( !decode_record( schema, record, len, datum ) ) )
+                {
+                    std::cerr << "  record " << n << " truncated to " << len << " of " << record.size() << " bytes" << std::endl;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Invalid data: union branches out of range, a bool that is not 0 or 1,
+    // a negative length and a varint that does not end
+    {
+        const avro::ValidSchema& small = gpudb::AvroUtils::get_or_compile_schema( SMALL_SCHEMA );
+        gpudb::AvroRecordView view( small, names( "flag", "s" ) );
+        avro::GenericDatum datum;
+        bool flag;
+        std::string s;
+
+        const uint8_t valid[] = { 0x02, 0x54, 0x01, 0x04, 'a', 'b' };
+        std::vector<uint8_t> record( valid, valid + sizeof( valid ) );
+        CHECK( view.read( record ) && view.get_bool( 0, flag ) && flag && view.get_string( 1, s ) && ( s == "ab" ) );
+        CHECK( decode_record( small, record, record.size(), datum ) );
+
+        record[ 0 ] = 0x04;
+        CHECK( !view.read( record ) && !decode_record( small, record, record.size(), datum ) );
+        record[ 0 ] = 0x01;
+        CHECK( !view.read( record ) && !decode_record( small, record, record.size(), datum ) );
+
+        record[ 0 ] = 0x00;
+        record.erase( record.begin() + 1 );
+        CHECK( view.read( record ) && view.get_bool( 0, flag ) && decode_record( small, record, record.size(), datum ) );
+        record[ 1 ] = 0x02;
+        CHECK( view.read( record ) && !view.get_bool( 0, flag ) && !decode_record( small, record, record.size(), datum ) );
+
+        record[ 1 ] = 0x00;
+        record[ 2 ] = 0x03;
+        CHECK( !view.read( record ) && !decode_record( small, record, record.size(), datum ) );
+
+        record[ 0 ] = 0x02;
+        record.insert( record.begin() + 1, 11, 0xff );
+        CHECK( !view.read( record ) );
+    }
+
+    // Nesting is skipped up to a depth of 64 records, arrays and maps; deeper
+    // data is rejected without overflowing the stack
+    {
+        const avro::ValidSchema& nest = gpudb::AvroUtils::get_or_compile_schema( NEST_SCHEMA );
+        gpudb::AvroRecordView view( nest, names( "after" ) );
+        avro::GenericDatum datum;
+        int32_t after;
+
+        const size_t levels[] = { 1, 10, 32 };
+        for ( size_t k = 0; k < 3; ++k )
+        {
+            std::vector<uint8_t> record = encode_nest( levels[ k ], 7 );
+            if ( !CHECK( decode_record( nest, record, record.size(), datum ) ) ||
+                 !CHECK( view.read( record ) && view.get_int( 0, after ) &&
+                         ( after == datum.value<avro::GenericRecord>().field( "after" ).value<int32_t>() ) ) )
+                std::cerr << "  nested " << levels[ k ] << " deep" << std::endl;
+        }
+
+        std::vector<uint8_t> record = encode_nest( 33, 7 );
+        CHECK( decode_record( nest, record, record.size(), datum ) );
+        CHECK( !view.read( record ) );
+        CHECK( !view.read( encode_nest( 100000, 7 ) ) );
+    }
+
+    // Projections that cannot be compiled
+    CHECK( throws( "\"int\"", names( "i" ) ) );
+    CHECK( throws( WIDE_SCHEMA, names( "missing" ) ) );
+    CHECK( throws( WIDE_SCHEMA, names( "tags" ) ) );
+    CHECK( throws( WIDE_SCHEMA, names( "maybe" ) ) );
+    CHECK( throws( WIDE_SCHEMA, names( "where" ) ) );
+    CHECK( throws( WIDE_SCHEMA, names( "i", "l", "i" ) ) );
+    CHECK( !throws( WIDE_SCHEMA, names( "i", "l" ) ) );
+
+    return check::result( "check_record_view" );
+}  // end main
@@ -0,0 +1,308 @@
+/* **********************************
+ * GPUdb C++ API Check: SetScanner
+ *
+ * Checks a SetScanner over a stand-in GPUdb handle that serves a set of
+ * numbered objects from memory: every object is returned once and in
+ * order whatever the page size (a short, an exactly full or an empty last
+ * page) and also when the server returns fewer objects per page than were
+ * asked for, pages are fetched ahead on another thread but no more than
+ * the buffers allow, a page that cannot be fetched (false or a throw) ends
+ * the scan with its error, and destroying the scanner during a fetch waits
+ * for that fetch and starts no other. Needs no GPUdb server.
+ *
+ * Like SetScanner itself this needs C++11 (std::thread).
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GPUdb.h"
+#include "SetScanner.h"
+#include "check.h"
+
+
+// The set the stand-in handles serve, shared by their copies
+struct fake_set
+{
+    enum failure { NO_FAILURE, RETURN_FALSE, RETURN_FALSE_SILENTLY, THROW_EXCEPTION, THROW_OTHER };
+
+    size_t                  num_objects;
+    int64_t                 fail_at;      // The start of the page that fails, -1 for none
+    failure                 how;
+    size_t                  extra;        // Objects returned beyond those asked for
+    size_t                  cap;          // Most objects returned per page, 0 for no cap
+    bool                    block;        // get_set waits for release() while set
+    std::thread::id         caller;       // The thread that reads the scanner
+
+    std::mutex              mutex;        // Guards the rest
+    std::condition_variable changed;
+    size_t                  calls;
+    size_t                  in_progress;  // get_set calls not returned yet
+    bool                    off_caller;   // Every call was made on another thread
+
+    explicit fake_set( size_t n ) : num_objects( n ), fail_at( -1 ), how( NO_FAILURE ), extra( 0 ), cap( 0 ),
+                                    block( false ), caller( std::this_thread::get_id() ), calls( 0 ),
+                                    in_progress( 0 ), off_caller( true ) {}
+
+    size_t get_calls()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        return calls;
+    }
+
+    // Wait (for up to 5 seconds) until calls calls have started
+    bool wait_for_calls( size_t n )
+    {
+        for ( int i = 0; ( i < 5000 ) && ( get_calls() < n ); ++i )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        return get_calls() >= n;
+    }
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        block = false;
+        changed.notify_all();
+    }
+};
+
+
+static std::string object_name( int64_t i )
+{
+    char buf[ 32 ];
+    sprintf( buf, "object %ld", (long)i );
+    return buf;
+}
+
+
+// Has the calls SetScanner needs of a BasicGPUdb
+class fake_gpudb
+{
+public:
+    explicit fake_gpudb( fake_set& set ) : set_( &set ) {}
+
+    bool get_set( const gpudb::get_set_request& request, gpudb::get_set_flat_response& page )
+    {
+        bool fail;
+        {
+            std::unique_lock<std::mutex> lock( set_->mutex );
+            ++set_->calls;
+            ++set_->in_progress;
+            if ( std::this_thread::get_id() == set_->caller )
+                set_->off_caller = false;
+            while ( set_->block )
+                set_->changed.wait( lock );
+            fail = ( request.start == set_->fail_at );
+            --set_->in_progress;
+        }
+
+        if ( fail )
+        {
+            switch ( set_->how )
+            {
+            case fake_set::RETURN_FALSE:
+                error_ = "no page at " + object_name( request.start );
+                return false;
+            case fake_set::RETURN_FALSE_SILENTLY:
+                error_ = "";
+                return false;
+            case fake_set::THROW_EXCEPTION:
+                throw std::runtime_error( "lost the connection" );
+            case fake_set::THROW_OTHER:
+                throw 42;
+            default:
+                break;
+            }
+        }
+
+        // Objects start to end (inclusive), decoded as GPUdb::get_set does
+        gpudb::get_set_response response;
+        response.set_id = request.set_id;
+        int64_t end = std::min( request.end + (int64_t)set_->extra, (int64_t)set_->num_objects - 1 );
+        if ( set_->cap > 0 )
+            end = std::min( end, request.start + (int64_t)set_->cap - 1 );
+        for ( int64_t i = request.start; i <= end; ++i )
+        {
+            std::string name = object_name( i );
+            response.list.push_back( std::vector<uint8_t>( name.begin(), name.end() ) );
+            response.object_ids.push_back( name );
+        }
+
+        boost::shared_ptr<std::vector<uint8_t> > buffer( new std::vector<uint8_t> );
+        gpudb::AvroUtils::convert_to_bytes( response, *buffer );
+        gpudb::set_response_buffer( page, buffer );
+        return gpudb::AvroUtils::convert_to_object( *buffer, page );
+    }
+
+    std::string error_message() { return error_; }
+
+private:
+    fake_set*   set_;
+    std::string error_;
+};
+
+
+// Scan the set; returns the number of objects read, which are checked to
+// be the set's in order
+static size_t scan( fake_set& set, size_t page_size, size_t num_buffers, gpudb::SetScanner*& scanner )
+{
+    scanner = new gpudb::SetScanner( fake_gpudb( set ), "objects", page_size, num_buffers );
+
+    size_t read = 0;
+    gpudb::get_set_flat_response page;
+    while ( scanner->next( page ) )
+    {
+        bool ok = CHECK( scanner->position() == (int64_t)read ) && CHECK( page.size() > 0 ) &&
+                  CHECK( page.size() <= page_size ) && CHECK( page.set_id == "objects" );
+        for ( size_t i = 0; ok && ( i < page.size() ); ++i )
+            ok = CHECK( page.list[ i ].str() == object_name( read + i ) );
+        if ( !ok )
+        {
+            std::cerr << "  in the page at " << read << ", of " << page_size << " objects" << std::endl;
+            break;
+        }
+        read += page.size();
+    }
+    CHECK( page.size() == 0 );
+    return read;
+}
+
+
+// Scan a whole set, which holds num_objects, from a server that returns at
+// most cap objects per page (0 for no cap)
+static void check_scan( size_t num_objects, size_t page_size, size_t num_buffers, size_t cap = 0 )
+{
+    fake_set set( num_objects );
+    set.cap = cap;
+    gpudb::SetScanner* scanner;
+    size_t read = scan( set, page_size, num_buffers, scanner );
+
+    // The pages that hold the objects, then an empty one
+    size_t served = ( ( cap > 0 ) && ( cap < page_size ) ) ? cap : page_size;
+    size_t pages = ( num_objects + served - 1 ) / served + 1;
+    bool ok = CHECK( read == num_objects ) && CHECK( !scanner->failed() ) &&
+              CHECK( scanner->error_message().empty() ) && CHECK( set.get_calls() == pages ) &&
+              CHECK( set.off_caller );
+    delete scanner;
+
+    if ( !ok )
+        std::cerr << "  scanning " << num_objects << " objects in pages of " << page_size
+                  << " with " << num_buffers << " buffers, capped at " << cap << std::endl;
+}
+
+
+// Scan a set whose page at fail_at cannot be fetched
+static void check_failure( fake_set::failure how, const std::string& expected_error )
+{
+    fake_set set( 100 );
+    set.fail_at = 40;
+    set.how = how;
+    gpudb::SetScanner* scanner;
+    size_t read = scan( set, 10, 3, scanner );
+
+    // The pages before it are returned, and no more are fetched
+    bool ok = CHECK( read == 40 ) && CHECK( scanner->failed() ) &&
+              CHECK( scanner->error_message() == expected_error ) && CHECK( set.get_calls() == 5 );
+    gpudb::get_set_flat_response page;
+    ok = CHECK( !scanner->next( page ) ) && ok;
+    delete scanner;
+
+    if ( !ok )
+        std::cerr << "  for failure " << how << std::endl;
+}
+
+
+// Releases a fake_set after a while, from another thread
+static void release_later( fake_set* set )
+{
+    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+    set->release();
+}
+
+
+
+int main( int argc, char* argv[] )
+{
+    // Short, exactly full (then empty) and single last pages; no objects
+    check_scan( 25, 10, 2 );
+    check_scan( 30, 10, 2 );
+    check_scan( 1, 10, 2 );
+    check_scan( 0, 10, 2 );
+    check_scan( 10, 10, 2 );
+    check_scan( 1000, 1, 2 );
+    check_scan( 1000, 7, 3 );
+    check_scan( 1000, 1000, 4 );
+    check_scan( 999, 1000, 1 );
+
+    // A server that returns fewer objects per page than were asked for
+    // does not end the scan early
+    check_scan( 1000, 100, 2, 30 );
+    check_scan( 95, 10, 3, 9 );
+    check_scan( 10, 10, 2, 1 );
+
+    // Pages are fetched ahead, as many as the buffers hold besides the caller's
+    for ( size_t num_buffers = 2; num_buffers <= 4; ++num_buffers )
+    {
+        fake_set set( 1000 );
+        gpudb::SetScanner scanner( fake_gpudb( set ), "objects", 10, num_buffers );
+        gpudb::get_set_flat_response page;
+        if ( CHECK( scanner.next( page ) ) && CHECK( set.wait_for_calls( num_buffers ) ) )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+            if ( !CHECK( set.get_calls() == num_buffers ) )
+                std::cerr << "  fetched " << set.get_calls() << " pages with " << num_buffers << " buffers" << std::endl;
+        }
+        CHECK( set.off_caller );
+    }
+
+    // A page that cannot be fetched ends the scan with its error
+    check_failure( fake_set::RETURN_FALSE, "no page at object 40" );
+    check_failure( fake_set::RETURN_FALSE_SILENTLY, "Unable to get a page of the set" );
+    check_failure( fake_set::THROW_EXCEPTION, "lost the connection" );
+    check_failure( fake_set::THROW_OTHER, "Unknown error getting a page of the set" );
+
+    {
+        fake_set set( 100 );
+        set.extra = 1;
+        gpudb::SetScanner scanner( fake_gpudb( set ), "objects", 10 );
+        gpudb::get_set_flat_response page;
+        CHECK( !scanner.next( page ) );
+        CHECK( scanner.error_message() == "GPUdb returned more objects than were asked for" );
+    }
+
+    // Destroying the scanner during a fetch waits for it, and fetches no more
+    {
+        fake_set set( 1000 );
+        set.block = true;
+        gpudb::SetScanner* scanner = new gpudb::SetScanner( fake_gpudb( set ), "objects", 10, 3 );
+        if ( CHECK( set.wait_for_calls( 1 ) ) )
+        {
+            std::thread releaser( release_later, &set );
+            delete scanner;
+            releaser.join();
+
+            std::lock_guard<std::mutex> lock( set.mutex );
+            CHECK( set.in_progress == 0 );
+            CHECK( set.calls == 1 );
+        }
+        else
+        {
+            set.release();
+            delete scanner;
+        }
+    }
+
+    return check::result( "check_set_scanner" );
+}  // end main
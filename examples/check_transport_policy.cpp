@@ -0,0 +1,312 @@
+/* **********************************
+ * GPUdb C++ API Check: transport policy
+ *
+ * Checks that BasicGPUdb works over a transport other than HTTP: an
+ * in-process stand-in for GPUdb that keeps one set of points in memory
+ * and answers /boundingbox and /getset, through a binary handle (plain,
+ * flat and streamed get_set), its error path and the encoding errors of a
+ * typed add_object. Needs no GPUdb server.
+ *
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+
+#include <stdio.h>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "GPUdb.h"
+#include "check.h"
+
+
+// The points of the one set the transport serves; each object is its
+// point's x and y, binary encoded as an array of doubles
+struct point_set
+{
+    std::string set_id;
+    std::vector<double> x;
+    std::vector<double> y;
+
+    std::vector<uint8_t> object( size_t i ) const
+    {
+        std::vector<double> xy( 2 );
+        xy[ 0 ] = x[ i ];
+        xy[ 1 ] = y[ i ];
+        std::vector<uint8_t> bytes;
+        gpudb::AvroUtils::convert_to_bytes( xy, bytes );
+        return bytes;
+    }
+};
+
+
+// A TransportPolicy that answers from a point_set instead of sending the
+// requests anywhere
+class memory_transport
+{
+public:
+    memory_transport() : calls( 0 ), points_( NULL ) {}
+
+    void serve( const point_set& points ) { points_ = &points; }
+
+    std::string ping( const std::string& ip, const std::string& port )
+    {
+        return "GPUdb is running in process";
+    }
+
+    gpudb::gpudb_response call_json( const std::string& json_data,
+                                     const std::string& endpoint,
+                                     const std::string& ip,
+                                     const std::string& port,
+                                     const std::string& username,
+                                     const std::string& password,
+                                     bool idempotent )
+    {
+        ++calls;
+        return error( "JSON is not served in process" );
+    }
+
+    gpudb::gpudb_response_view call_binary( const std::vector<uint8_t>& binary_data,
+                                            const std::string& endpoint,
+                                            const std::string& ip,
+                                            const std::string& port,
+                                            const std::string& username,
+                                            const std::string& password,
+                                            size_t response_size_hint,
+                                            bool idempotent )
+    {
+        ++calls;
+        gpudb::gpudb_response gresponse = answer( binary_data, endpoint );
+
+        // The view decodes the response as the HTTP transport receives it
+        boost::shared_ptr<std::vector<uint8_t> > buffer( new std::vector<uint8_t> );
+        gpudb::AvroUtils::convert_to_bytes( gresponse, *buffer );
+        gpudb::gpudb_response_view view;
+        view.decode( buffer );
+        return view;
+    }
+
+    gpudb::gpudb_response call_stream( const std::vector<uint8_t>& binary_data,
+                                       const std::string& endpoint,
+                                       const std::string& ip,
+                                       const std::string& port,
+                                       gpudb::ResponseStreamDecoder& data_decoder,
+                                       const std::string& username,
+                                       const std::string& password,
+                                       bool idempotent )
+    {
+        ++calls;
+        gpudb::gpudb_response gresponse = answer( binary_data, endpoint );
+        if ( gresponse.status == "OK" )
+        {
+            gpudb::AvroBufferDecoder d( gresponse.data.empty() ? NULL : &gresponse.data[ 0 ], gresponse.data.size() );
+            data_decoder.decode( d, gresponse.data_type );
+            gresponse.data.clear();
+        }
+        return gresponse;
+    }
+
+    size_t calls;
+
+private:
+    const point_set* points_;
+
+    static gpudb::gpudb_response error( const std::string& message )
+    {
+        gpudb::gpudb_response gresponse;
+        gresponse.status = "ERROR";
+        gresponse.message = message;
+        return gresponse;
+    }
+
+    template <class T>
+    static gpudb::gpudb_response ok( const T& data )
+    {
+        gpudb::gpudb_response gresponse;
+        gresponse.status = "OK";
+        gresponse.data_type = T::schema_name();
+        gpudb::AvroUtils::convert_to_bytes( data, gresponse.data );
+        return gresponse;
+    }
+
+    gpudb::gpudb_response answer( const std::vector<uint8_t>& binary_data, const std::string& endpoint )
+    {
+        if ( endpoint == gpudb::EndpointTraits<gpudb::bounding_box_request>::endpoint() )
+        {
+            gpudb::bounding_box_request request;
+            if ( !gpudb::AvroUtils::convert_to_object( binary_data, request ) )
+                return error( "bad bounding_box_request" );
+            if ( !points_ || ( request.set_id != points_->set_id ) )
+                return error( "no set " + request.set_id );
+
+            gpudb::bounding_box_response response;
+            response.count = 0;
+            for ( size_t i = 0; i < points_->x.size(); ++i )
+                if ( ( points_->x[ i ] >= request.min_x ) && ( points_->x[ i ] <= request.max_x ) &&
+                     ( points_->y[ i ] >= request.min_y ) && ( points_->y[ i ] <= request.max_y ) )
+                    ++response.count;
+            return ok( response );
+        }
+
+        if ( endpoint == gpudb::EndpointTraits<gpudb::get_set_request>::endpoint() )
+        {
+            gpudb::get_set_request request;
+            if ( !gpudb::AvroUtils::convert_to_object( binary_data, request ) )
+                return error( "bad get_set_request" );
+            if ( !points_ || ( request.set_id != points_->set_id ) )
+                return error( "no set " + request.set_id );
+
+            gpudb::get_set_response response;
+            response.set_id = request.set_id;
+            for ( int64_t i = request.start; ( i < request.end ) && ( i < (int64_t)points_->x.size() ); ++i )
+            {
+                char object_id[ 32 ];
+                sprintf( object_id, "%ld", (long)i );
+                response.list.push_back( points_->object( (size_t)i ) );
+                response.type_ids.push_back( "point" );
+                response.object_ids.push_back( object_id );
+            }
+            return ok( response );
+        }
+
+        return error( "endpoint " + endpoint + " is not served in process" );
+    }
+};  // end class memory_transport
+
+
+typedef BasicGPUdb<gpudb::BinaryEncoding, memory_transport> MemoryGPUdb;
+
+
+// An object type for add_object; points with a NaN x fail to encode
+struct checked_point
+{
+    double x;
+    double y;
+
+    static const avro::ValidSchema& schema()
+    {
+        return gpudb::AvroUtils::get_or_compile_schema( "{\"type\":\"array\",\"items\":\"double\"}" );
+    }
+};
+
+namespace avro
+{
+template <> struct codec_traits<checked_point>
+{
+    static void encode( Encoder& e, const checked_point& v )
+    {
+        if ( v.x != v.x )
+            throw avro::Exception( "checked_point: x is NaN" );
+        std::vector<double> xy( 2 );
+        xy[ 0 ] = v.x;
+        xy[ 1 ] = v.y;
+        avro::encode( e, xy );
+    }
+    static void decode( Decoder& d, checked_point& v )
+    {
+        std::vector<double> xy;
+        avro::decode( d, xy );
+        v.x = xy.at( 0 );
+        v.y = xy.at( 1 );
+    }
+};
+}  // end namespace avro
+
+
+// Collects the objects a streamed get_set hands over
+struct collect_sink : public gpudb::get_set_sink
+{
+    std::vector<std::vector<uint8_t> > objects;
+    std::vector<std::string> object_ids;
+    std::string set;
+
+    virtual void object( size_t i, const gpudb::bytes_view& data )
+    {
+        objects.push_back( std::vector<uint8_t>( data.data, data.data + data.size ) );
+    }
+    virtual void set_id( const std::string& set_id ) { set = set_id; }
+    virtual void object_id( size_t i, const gpudb::bytes_view& object_id )
+    {
+        object_ids.push_back( std::string( (const char*)object_id.data, object_id.size ) );
+    }
+};
+
+
+
+int main( int argc, char* argv[] )
+{
+    point_set points;
+    points.set_id = "points";
+    for ( size_t i = 0; i < 100; ++i )
+    {
+        points.x.push_back( (double)( i % 10 ) );
+        points.y.push_back( (double)( i / 10 ) );
+    }
+
+    MemoryGPUdb db( "127.0.0.1", 9191, "BINARY" );
+    CHECK( db.status() == gpudb::OK );
+    db.transport().serve( points );
+
+    // A unary query, through call_binary
+    gpudb::bounding_box_response bb_response;
+    if ( CHECK( db.bounding_box( "points", "", 2, 4, 5, 9, "x", "y", bb_response ) ) )
+        CHECK( bb_response.count == 3 * 5 );
+
+    // The objects of a range, decoded whole, viewed and streamed
+    gpudb::get_set_response response;
+    if ( CHECK( db.get_set( "points", 10, 20, "", response ) ) &&
+         CHECK( response.list.size() == 10 ) )
+    {
+        CHECK( response.set_id == "points" );
+        CHECK( response.list[ 0 ] == points.object( 10 ) );
+        CHECK( response.list[ 9 ] == points.object( 19 ) );
+        CHECK( response.object_ids[ 9 ] == "19" );
+    }
+
+    gpudb::get_set_flat_response flat_response;
+    if ( CHECK( db.get_set( "points", 95, 200, "", flat_response ) ) &&
+         CHECK( flat_response.size() == 5 ) )
+    {
+        CHECK( flat_response.list[ 4 ].size == points.object( 99 ).size() );
+        CHECK( flat_response.buffer.get() != NULL );
+    }
+
+    collect_sink sink;
+    if ( CHECK( db.get_set( "points", 0, 100, "", sink ) ) &&
+         CHECK( sink.objects.size() == 100 ) )
+    {
+        CHECK( sink.set == "points" );
+        CHECK( sink.objects[ 42 ] == points.object( 42 ) );
+        CHECK( sink.object_ids[ 42 ] == "42" );
+    }
+
+    // The transport's errors reach the handle
+    gpudb::clear_response clear_response;
+    CHECK( !db.clear( "points", "", clear_response ) );
+    CHECK( db.status() == gpudb::ERROR );
+    CHECK( db.error_message().find( "not served in process" ) != std::string::npos );
+
+    CHECK( db.bounding_box( "points", "", 0, 9, 0, 9, "x", "y", bb_response ) );
+    CHECK( db.status() == gpudb::OK );
+    CHECK( bb_response.count == 100 );
+
+    CHECK( !db.get_set( "lines", 0, 10, "", sink ) );
+    CHECK( db.error_message().find( "no set lines" ) != std::string::npos );
+
+    // An object that cannot be encoded is reported, and nothing is sent
+    gpudb::add_object_response add_response;
+    checked_point point = { 1.5, 2.5 };
+    CHECK( !db.add_object( "points", point, gpudb::NONE, add_response ) );
+    CHECK( db.error_message().find( "endpoint /add is not served" ) != std::string::npos );
+    point.x = std::numeric_limits<double>::quiet_NaN();
+    CHECK( !db.add_object( "points", point, gpudb::NONE, add_response ) );
+    CHECK( db.status() == gpudb::ERROR );
+    CHECK( db.error_message().find( "add_object: " ) == 0 );
+    CHECK( db.error_message().find( "x is NaN" ) != std::string::npos );
+
+    CHECK( db.transport().calls == 9 );
+
+    return check::result( "check_transport_policy" );
+}  // end main
@@ -1,11 +1,104 @@
 #include "AvroTypes.h"
+#include "EndpointTraits.h"
 
+#include <stdint.h>
 #include <string.h>
 
 
 
 namespace gpudb {
 
+namespace
+{
+
+struct endpoint_entry
+{
+    const char* endpoint;
+    size_t      length;
+    avro_t      type;
+};
+
+template <class Treq>
+inline endpoint_entry make_entry()
+{
+    endpoint_entry e = { EndpointTraits<Treq>::endpoint().c_str(),
+                         EndpointTraits<Treq>::endpoint().size(),
+                         EndpointTraits<Treq>::avro_type };
+    return e;
+}
+
+/// A perfect hash table of the endpoints of the requests with EndpointTraits:
+/// the seed of the hash is chosen when the table is built so that no two
+/// endpoints share a slot, so a lookup is one hash and one comparison.
+class endpoint_table
+{
+public:
+
+    endpoint_table()
+    {
+        const endpoint_entry entries[] = {
+            make_entry<add_object_request>(),
+            make_entry<bulk_add_request>(),
+            make_entry<bounding_box_request>(),
+            make_entry<clear_request>(),
+            make_entry<get_set_request>(),
+            make_entry<new_set_request>(),
+            make_entry<register_parent_set_request>(),
+            make_entry<register_type_request>(),
+            make_entry<status_request>()
+        };
+        const size_t num_entries = sizeof( entries ) / sizeof( entries[0] );
+
+        for ( seed_ = 0; ; ++seed_ )
+        {
+            for ( size_t i = 0; i < SIZE; ++i )
+                slots_[i].endpoint = NULL;
+
+            size_t i = 0;
+            for ( ; i < num_entries; ++i )
+            {
+                endpoint_entry& slot = slots_[ hash( entries[i].endpoint, entries[i].length ) ];
+                if ( slot.endpoint != NULL )
+                    break; // a collision, try the next seed
+                slot = entries[i];
+            }
+            if ( i == num_entries )
+                break;
+        }
+    }
+
+    avro_t find( const std::string& endpoint ) const
+    {
+        const endpoint_entry& slot = slots_[ hash( endpoint.data(), endpoint.size() ) ];
+        if ( ( slot.endpoint != NULL ) && ( slot.length == endpoint.size() )
+             && ( memcmp( slot.endpoint, endpoint.data(), slot.length ) == 0 ) )
+            return slot.type;
+
+        // Unsupported request Avro type
+        return invalid_response_type_avro;
+    }
+
+private:
+
+    // A power of two, a few times the number of endpoints so a seed is found quickly
+    static const size_t SIZE = 64;
+
+    uint32_t       seed_;
+    endpoint_entry slots_[SIZE];
+
+    // FNV-1a, starting from the seed
+    inline size_t hash( const char* s, size_t len ) const
+    {
+        uint32_t h = 2166136261u ^ seed_;
+        for ( size_t i = 0; i < len; ++i )
+            h = ( h ^ (uint8_t)s[i] ) * 16777619u;
+        return h & ( SIZE - 1 );
+    }
+};
+
+} // end anonymous namespace
+
+
 avro_t get_response(avro_t request)
 {
   switch(request)
@@ -114,9 +207,13 @@ std::string get_endpoint(avro_t type)
 {
   switch (type)
   {
-     // case bulk_add_request_avro:                return "/bulkadd";
+     case add_object_request_avro:              return EndpointTraits<add_object_request>::endpoint();
+     case get_set_request_avro:                 return EndpointTraits<get_set_request>::endpoint();
+     case new_set_request_avro:                 return EndpointTraits<new_set_request>::endpoint();
+     case register_type_request_avro:           return EndpointTraits<register_type_request>::endpoint();
+     case bulk_add_request_avro:                return EndpointTraits<bulk_add_request>::endpoint();
      // case bulk_add_internal_request_avro:       return "/bulkadd";
-     // case bounding_box_request_avro:            return "/boundingbox";
+     case bounding_box_request_avro:            return EndpointTraits<bounding_box_request>::endpoint();
      // case join_request_avro:                    return "/join";
      // case filter_by_list_request_avro:          return "/filterbylist";
      // case filter_by_nai_request_avro:           return "/filterbynai";
@@ -137,7 +234,7 @@ std::string get_endpoint(avro_t type)
      // case plot2d_heatmap_request_avro:          return "/plot2heatmap";
      // case plot2d_heatmap_cb_request_avro:       return "/plot2heatmapcb";
      // case join_incremental_request_avro:        return "/joinincremental";
-     // case clear_request_avro:                   return "/clear";
+     case clear_request_avro:                   return EndpointTraits<clear_request>::endpoint();
      // case get_objects_request_avro:             return "/getobjects";
      // case delete_object_request_avro:           return "/deleteobject";
      // case get_tracks_request_avro:              return "/gettracks";
@@ -145,7 +242,7 @@ std::string get_endpoint(avro_t type)
      // case get_sorted_set_request_avro:          return "/getsortedset";
      // case random_request_avro:                  return "/random";
      // case clear_auth_cache_request_avro:        return "/clearauthcache";
-     case status_request_avro:                  return "/status";
+     case status_request_avro:                  return EndpointTraits<status_request>::endpoint();
      // case get_set_sizes_request_avro:           return "/getsetsizes";
      // case update_object_request_avro:           return "/updateobject";
      // case unique_request_avro:                  return "/unique";
@@ -156,7 +253,7 @@ std::string get_endpoint(avro_t type)
      // case convex_hull_request_avro:             return "/convexhull";
      // case filter_by_set_request_avro:           return "/filterbyset";
      // case populate_full_tracks_request_avro:    return "/populatefulltracks";
-     // case register_parent_set_request_avro:     return "/registerparentset";
+     case register_parent_set_request_avro:     return EndpointTraits<register_parent_set_request>::endpoint();
      // case add_symbol_request_avro:              return "/addsymbol";
      // case update_set_metadata_request_avro:     return "/updatesetmetadata";
      // case get_set_metadata_request_avro:        return "/getsetmetadata";
@@ -175,75 +272,12 @@ std::string get_endpoint(avro_t type)
 }
 
 
-// Really do not like these functions; need to just rewrite this avro enum/class/endpoint
 /// Get the avro_t type corresponding to the given endpoint
 /// E.G. "/boundingbox" returns avro_t::bounding_box_request_avro
-avro_t get_avro_type(std::string endpoint)
+avro_t get_avro_type(const std::string& endpoint)
 {
-    if ( endpoint == "/add" )
-        return add_object_request_avro;
-    if ( endpoint == "/bulkadd" )
-        return bulk_add_request_avro;
-    if ( endpoint == "/boundingbox" )
-        return bounding_box_request_avro;
-    if ( endpoint == "/clear" )
-        return clear_request_avro;
-    if ( endpoint == "/getset" )
-        return get_set_request_avro;
-    if ( endpoint == "/newset" )
-        return new_set_request_avro;
-    if ( endpoint == "/registerparentset" )
-        return register_parent_set_request_avro;
-    if ( endpoint == "/registertype" )
-        return register_type_request_avro;
-    if ( endpoint == "/status" )
-        return status_request_avro;
-    // Unsupported request Avro type
-    return invalid_response_type_avro;
-    // case filter_by_list_request_avro:          return "/filterbylist";
-    // case filter_by_nai_request_avro:           return "/filterbynai";
-    // case filter_by_radius_request_avro:        return "/filterbyradius";
-    // case filter_by_bounds_request_avro:        return "/filterbybounds";
-    // case filter_by_string_request_avro:        return "/filterbystring";
-    // case filter_then_histogram_request_avro:   return "/filterthenhistogram";
-    // case max_min_request_avro:                 return "/maxmin";
-    // case statistics_request_avro:              return "/statistics";
-    // case select_request_avro:                  return "/select";
-    // case histogram_request_avro:               return "/histogram";
-    // case store_group_by_request_avro:          return "/storegroupby";
-    // case group_by_request_avro:                return "/groupby";
-    // case group_by_value_request_avro:          return "/groupbyvalue";
-    // case subset_match_request_avro:            return "/subsetmatch";
-    // case get_objects_request_avro:             return "/getobjects";
-    // case delete_object_request_avro:           return "/deleteobject";
-    // case get_tracks_request_avro:              return "/gettracks";
-    // case get_tracks2_request_avro:             return "/gettracks2";
-    // case get_sorted_set_request_avro:          return "/getsortedset";
-    // case random_request_avro:                  return "/random";
-    // case clear_auth_cache_request_avro:        return "/clearauthcache";
-    // case get_set_sizes_request_avro:           return "/getsetsizes";
-    // case update_object_request_avro:           return "/updateobject";
-    // case unique_request_avro:                  return "/unique";
-    // case generate_video_request_avro:          return "/generatevideo";
-    // case generate_heatmap_video_request_avro:  return "/generateheatmapvideo";
-    // case logger_request_avro:                  return "/logger";
-    // case server_status_request_avro:           return "/serverstatus";
-    // case convex_hull_request_avro:             return "/convexhull";
-    // case filter_by_set_request_avro:           return "/filterbyset";
-    // case populate_full_tracks_request_avro:    return "/populatefulltracks";
-    // case add_symbol_request_avro:              return "/addsymbol";
-    // case update_set_metadata_request_avro:     return "/updatesetmetadata";
-    // case get_set_metadata_request_avro:        return "/getsetmetadata";
-    // case update_set_properties_request_avro:   return "/updatesetproperties";
-    // case get_set_properties_request_avro:      return "/getsetproperties";
-    // case get_tom_set_stats_request_avro:       return "/gettomsetstats";
-    // case select_delete_request_avro:           return "/selectdelete";
-    // case select_update_request_avro:           return "/selectupdate";
-    // case filter_by_track_request_avro:         return "/filterbytrack";
-    // case filter_by_track_values_request_avro:  return "/filterbytrackvalues";
-    // case k_means_request_avro:                 return "/kmeans";
-    // case k_means_internal_request_avro:        return "/kmeansinternal";
-    // case bulk_update_request_avro:             return "/bulkupdate";
+    static const endpoint_table table;
+    return table.find( endpoint );
 } // end get_avrotype
 
 
@@ -126,15 +126,15 @@ namespace gpudb {
   /// Body of function is autogenerated in ../obj_defs/obj_defs.cpp
   std::string get_avro_name(avro_t avro_type);
 
-  // Really do not like these functions; need to just rewrite this avro enum/class/endpoint
-  /// Get the Gaia endpoint that handles the avro_t type.
+  /// Get the Gaia endpoint that handles the avro_t type, prefer
+  /// EndpointTraits<Treq>::endpoint() where the request type is known.
   /// E.G. avro_t::bounding_box_request_avro returns "/boundingbox"
   std::string get_endpoint(avro_t type);
 
-  // Really do not like these functions; need to just rewrite this avro enum/class/endpoint
-  /// Get the avro_t type corresponding to the given endpoint
+  /// Get the avro_t type corresponding to the given endpoint, looked up in a
+  /// perfect hash table of the endpoints of the requests with EndpointTraits
   /// E.G. "/boundingbox" returns avro_t::bounding_box_request_avro
-  avro_t get_avro_type(std::string endpoint);
+  avro_t get_avro_type(const std::string& endpoint);
 
 } // namespace gpudb
 
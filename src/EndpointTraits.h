@@ -0,0 +1,78 @@
+#ifndef __ENDPOINT_TRAITS_H__
+#define __ENDPOINT_TRAITS_H__
+
+#include <stddef.h>
+#include <string>
+
+#include "AvroTypes.h"
+
+#include "obj_defs/addobjectrequest.h"
+#include "obj_defs/addobjectresponse.h"
+#include "obj_defs/boundingboxrequest.h"
+#include "obj_defs/boundingboxresponse.h"
+#include "obj_defs/bulkaddrequest.h"
+#include "obj_defs/bulkaddresponse.h"
+#include "obj_defs/clearrequest.h"
+#include "obj_defs/clearresponse.h"
+#include "obj_defs/getsetrequest.h"
+#include "obj_defs/getsetresponse.h"
+#include "obj_defs/newsetrequest.h"
+#include "obj_defs/newsetresponse.h"
+#include "obj_defs/registerparentsetrequest.h"
+#include "obj_defs/registerparentsetresponse.h"
+#include "obj_defs/registertyperequest.h"
+#include "obj_defs/registertyperesponse.h"
+#include "obj_defs/statusrequest.h"
+#include "obj_defs/statusresponse.h"
+
+
+namespace gpudb {
+
+// --------------------------------------------------------------------------
+/// @class EndpointTraits Binds a request type at compile time to what GPUdb
+///        needs to make the call, so that GPUdb::query(request, response)
+///        takes no endpoint and nothing is looked up by string:
+///
+///        response_type          -- the type the response's data decodes to
+///        avro_type              -- the avro_t of the request
+///        idempotent             -- true if repeating the call is harmless;
+///                                  such a call is sent once more if it
+///                                  fails on a kept-alive connection that
+///                                  the server has closed
+///        expected_response_size -- a typical size of the encoded response,
+///                                  to size the receive buffer when the
+///                                  server does not send a content length
+///        endpoint()             -- the endpoint path, e.g. "/getset", a
+///                                  string made once rather than per call
+///
+///        Only requests with a specialization (below) can be queried.
+// --------------------------------------------------------------------------
+template <class Treq>
+struct EndpointTraits;
+
+#define GPUDB_ENDPOINT_TRAITS(request, response, path, is_idempotent, response_size) \
+    template <> \
+    struct EndpointTraits<request> \
+    { \
+        typedef response response_type; \
+        static const avro_t avro_type = request##_avro; \
+        static const bool   idempotent = is_idempotent; \
+        static const size_t expected_response_size = response_size; \
+        static inline const std::string& endpoint() { static const std::string e( path ); return e; } \
+    };
+
+GPUDB_ENDPOINT_TRAITS( add_object_request,          add_object_response,          "/add",               false, 256 )
+GPUDB_ENDPOINT_TRAITS( bulk_add_request,            bulk_add_response,            "/bulkadd",           false, 64 * 1024 )
+GPUDB_ENDPOINT_TRAITS( bounding_box_request,        bounding_box_response,        "/boundingbox",       false, 256 )
+GPUDB_ENDPOINT_TRAITS( clear_request,               clear_response,               "/clear",             true,  256 )
+GPUDB_ENDPOINT_TRAITS( get_set_request,             get_set_response,             "/getset",            true,  1024 * 1024 )
+GPUDB_ENDPOINT_TRAITS( new_set_request,             new_set_response,             "/newset",            false, 256 )
+GPUDB_ENDPOINT_TRAITS( register_parent_set_request, register_parent_set_response, "/registerparentset", false, 256 )
+GPUDB_ENDPOINT_TRAITS( register_type_request,       register_type_response,       "/registertype",      false, 4096 )
+GPUDB_ENDPOINT_TRAITS( status_request,              status_response,              "/status",            true,  4096 )
+
+#undef GPUDB_ENDPOINT_TRAITS
+
+} // namespace gpudb
+
+#endif // __ENDPOINT_TRAITS_H__
@@ -1,6 +1,6 @@
 /* **********************************
  * GPUdb C++ API
- * Header file for class GPUdb
+ * Header file for class BasicGPUdb (and GPUdb)
  *
  * @author Meem Mahmud
  * GIS Federal, Inc.
@@ -13,9 +13,19 @@
 
 #include <stdio.h>
 #include <string>
+#include <map>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
 
 #include "Utils/HTTPUtils.h"
 #include "Utils/AvroUtils.h"
+#include "Utils/AvroColumns.h"
+#include "Utils/WorkerPool.h"
+#include "EndpointTraits.h"
+#include "GPUdbPolicies.h"
+#include "PreparedQuery.h"
+#include "SetScanner.h"
 
 #include "obj_defs/addobjectrequest.h"
 #include "obj_defs/addobjectresponse.h"
@@ -27,6 +37,7 @@
 #include "obj_defs/clearresponse.h"
 #include "obj_defs/getsetrequest.h"
 #include "obj_defs/getsetresponse.h"
+#include "obj_defs/getsetflatresponse.h"
 #include "obj_defs/newsetrequest.h"
 #include "obj_defs/newsetresponse.h"
 #include "obj_defs/registerparentsetrequest.h"
@@ -57,6 +68,84 @@ namespace gpudb
     };  // end enum add_parameter
 
 
+    /// Receives the objects of a /getset response one at a time, as
+    /// GPUdb::get_set() decodes them from the connection, so the response is
+    /// never held in memory as a whole. The data passed to each call is only
+    /// valid during the call; the items of each list are numbered from 0.
+    class get_set_sink
+    {
+    public:
+        virtual ~get_set_sink() {}
+
+        /// A binary encoded object (the response's list)
+        virtual void object( size_t i, const bytes_view& data ) = 0;
+
+        /// A JSON encoded object (the response's list_str)
+        virtual void object_str( size_t i, const bytes_view& data ) {}
+
+        virtual void type_id( size_t i, const bytes_view& type_id ) {}
+        virtual void set_id( const std::string& set_id ) {}
+        virtual void object_id( size_t i, const bytes_view& object_id ) {}
+    };  // end class get_set_sink
+
+
+    /// Binary encodes objects into the presized list of a /bulkadd request
+    template <class T>
+    class bulk_add_binary_task : public WorkerPool::ItemTask
+    {
+    public:
+        bulk_add_binary_task( const std::vector<T>& objects,
+                              std::vector<std::vector<uint8_t> >& list,
+                              size_t grain )
+            : ItemTask( objects.size(), grain ), objects_( objects ), list_( list ) {}
+
+    protected:
+        virtual void process( size_t& i, size_t end )
+        {
+            for ( ; i < end; ++i )
+            {
+                if ( false == AvroUtils::convert_to_bytes<T>( objects_[ i ], list_[ i ] ) )
+                    return;
+            }
+        }
+
+    private:
+        const std::vector<T>& objects_;
+        std::vector<std::vector<uint8_t> >& list_;
+    };  // end class bulk_add_binary_task
+
+
+    /// JSON encodes objects into the presized list_str of a /bulkadd request
+    template <class T>
+    class bulk_add_json_task : public WorkerPool::ItemTask
+    {
+    public:
+        bulk_add_json_task( const std::vector<T>& objects,
+                            const avro::ValidSchema& schema,
+                            std::vector<std::string>& list_str,
+                            size_t grain )
+            : ItemTask( objects.size(), grain ), objects_( objects ), schema_( schema ), list_str_( list_str ) {}
+
+    protected:
+        virtual void process( size_t& i, size_t end )
+        {
+            // The json encoder is expensive to create, so share it among the range's objects
+            AvroCodecPool::Encoder encoder( schema_ );
+            for ( ; i < end; ++i )
+            {
+                if ( false == AvroUtils::convert_to_json_by_encoder<T>( objects_[ i ], encoder.ptr(), list_str_[ i ] ) )
+                    return;
+            }
+            encoder.release();
+        }
+
+    private:
+        const std::vector<T>& objects_;
+        const avro::ValidSchema& schema_;
+        std::vector<std::string>& list_str_;
+    };  // end class bulk_add_json_task
+
+
 }  // end namespace gpudb
 
 
@@ -65,33 +154,100 @@ namespace gpudb
 
 
 
-class GPUdb
+// A handler of a GPUdb server. The encoding of requests and objects
+// (gpudb::BinaryEncoding, JsonEncoding or RuntimeEncoding) and how requests
+// reach GPUdb (gpudb::PocoTransport) are policies chosen at compile time,
+// any that provide the calls of those in GPUdbPolicies.h. The definitions
+// are in GPUdb.ipp (included below); the configurations built into the
+// library are compiled once, in GPUdb.cpp. GPUdb, below, is the usual one.
+//
+// A handle is not thread safe: it keeps its connection to GPUdb (and that
+// connection's buffers) and the last query's status between calls, so each
+// thread should use its own handle (copies open their own connection).
+template <class EncodingPolicy, class TransportPolicy>
+class BasicGPUdb
 {
 private:
 
     std::string g_ip;  // The IP address of the GPUdb
     std::string g_port;  // The port at which GPUdb listens
-    std::string g_encoding; // The encoding of this GPUdb handler instance
+    EncodingPolicy g_encoding; // The encoding of this GPUdb handler instance
+    TransportPolicy g_transport; // Makes the calls to GPUdb
     std::string g_username; // Username for the GPUdb
     std::string g_password; // Password for the GPUdb
     std::string g_error_message; // Holds the last query's error message, if any
     gpudb::status_code g_status; // Indicates if the last query was successful or a failure
     bool g_throw_exceptions; // Make exception throwing optional; suppressed by default (not ideal C++ practice)
+    size_t g_num_workers; // Threads encoding the objects of a bulk_add; 0 for one per core
+    boost::shared_ptr<gpudb::WorkerPool> g_workers; // Pool of g_num_workers threads, if not the shared one
+
+    // Objects per range of a bulk_add's encoding; batches of at most two
+    // ranges are encoded on the calling thread
+    static const size_t BULK_ADD_GRAIN = 256;
+
+    // Make an HTTP request to GPUdb with the given endpoint and binary encoded
+    // request data and extract the response data
+    // (response_size_hint sizes the receive buffer if the server does not
+    // send the response's length; an idempotent request may be sent twice,
+    // see EndpointTraits)
+    template <class Tresp>
+    bool query_binary( const std::vector<uint8_t>& avro_data, const std::string& endpoint, Tresp& response,
+                       size_t response_size_hint = 0, bool idempotent = false );
+
+    // Make an HTTP request to GPUdb with the given endpoint and JSON encoded
+    // request data and extract the response data
+    template <class Tresp>
+    bool query_json( const std::string& json_data, const std::string& endpoint, Tresp& response,
+                     bool idempotent = false );
+
+    // query() with the size hint and idempotence of query_binary()
+    template <class Treq, class Tresp>
+    bool query( const Treq& request_data, const std::string& endpoint,
+                size_t response_size_hint, bool idempotent, Tresp& response );
+
+    // Make a prepared query, to the endpoint that handles Treq
+    template <class Treq, class Tresp>
+    bool query_prepared( gpudb::PreparedQuery<Treq>& prepared, Tresp& response );
+
+    // Store the status and error message of a query's response
+    bool set_query_status( const gpudb::gpudb_response& gresponse );
+
+    // Store the given error message and status; returns false
+    // (or throws if exceptions are enabled)
+    bool set_error( const std::string& message );
+
+    // Run the encoding of a bulk_add's objects on the worker pool (if it
+    // is large enough); returns false and sets the error naming the first
+    // object that could not be encoded, if any
+    bool run_bulk_add_task( gpudb::WorkerPool::ItemTask& task );
+
+    // Make a JSON encoded /bulkadd of the already JSON encoded objects; the
+    // request is written around them rather than encoded from a request
+    bool bulk_add_json( const std::string& set_id,
+                        const std::vector<std::string>& object_json_list,
+                        const std::map<std::string, std::string>& params,
+                        gpudb::bulk_add_response& response );
+
+    // Translate an /add or /bulkadd parameter into the request's params map
+    static void set_add_parameter( const gpudb::add_parameter& param,
+                                   std::map<std::string, std::string>& params );
 
 public:
     // Create a connection with a local running GPUdb by default
-    GPUdb() : g_ip( "127.0.0.1" ), g_port( "9191" ), g_encoding( "BINARY" ),
-              g_username ( "" ), g_password ( "" ),
-              g_error_message( "" ), g_status( gpudb::OK ), g_throw_exceptions( false ) {}
+    BasicGPUdb() : g_ip( "127.0.0.1" ), g_port( "9191" ),
+                   g_username ( "" ), g_password ( "" ),
+                   g_error_message( "" ), g_status( gpudb::OK ), g_throw_exceptions( false ),
+                   g_num_workers( 0 ) {}
 
     // Create a connection with a GPUdb server at the specified location
     // Optional parameters:
     //     username -- username for the GPUdb
     //     password -- password for the GPUdb
     //     throw_exceptions -- for enabling exception throwing (disabled by default)
-    GPUdb( std::string ip, int port, std::string encoding,
-           std::string username = "", std::string password = "",
-           bool throw_exceptions = false );
+    // The encoding must be one the encoding policy supports
+    BasicGPUdb( std::string ip, int port, std::string encoding,
+                std::string username = "", std::string password = "",
+                bool throw_exceptions = false );
 
 
     // Make an HTTP request to GPUdb with the given endpoint and data
@@ -101,12 +257,24 @@ public:
     template <class Treq, class Tresp>
     bool query( const Treq& request_data, const std::string& endpoint, Tresp& response );
 
+    // The same for the endpoint that handles Treq, from gpudb::EndpointTraits
+    template <class Treq, class Tresp>
+    bool query( const Treq& request_data, Tresp& response );
+
     // Returns the current status of this GPUdb handler instance
     gpudb::status_code status();
 
     // Returns the current error message, if any (empty string otherwise)
     std::string error_message();
 
+    // The transport policy that makes this handle's calls, e.g. to configure it
+    TransportPolicy& transport() { return g_transport; }
+
+    // Set the number of threads that encode the objects of a bulk_add
+    // (1 encodes them on the calling thread; 0, the default, shares a
+    // pool of one thread per core among all GPUdb instances)
+    void set_num_workers( size_t num_workers );
+
 
 
     // Ping GPUdb
@@ -126,6 +294,16 @@ public:
     bool add_object( const gpudb::add_object_request &request,
                      gpudb::add_object_response &response );
 
+    // Add an object to an existing set in GPUdb
+    // T is any type with an avro::codec_traits specialization and a static
+    // schema() (e.g. the generated obj_defs); the object is binary encoded
+    // directly, without going through JSON (unless JSON encoding is used)
+    template <class T>
+    bool add_object( const std::string &set_id,
+                     const T &object,
+                     const gpudb::add_parameter& param,
+                     gpudb::add_object_response &response );
+
     // Add multiple objects to an existing set in GPUdb
     bool bulk_add( const std::string& set_id,
                    const std::vector<std::string>& object_json_list,
@@ -134,6 +312,25 @@ public:
                    gpudb::bulk_add_response& response );
 
 
+    // Add multiple objects to an existing set in GPUdb
+    // T is any type with an avro::codec_traits specialization and a static
+    // schema() (e.g. the generated obj_defs); the objects are binary encoded
+    // directly, without going through JSON (unless JSON encoding is used)
+    template <class T>
+    bool bulk_add( const std::string& set_id,
+                   const std::vector<T>& objects,
+                   const gpudb::add_parameter& param,
+                   gpudb::bulk_add_response& response );
+
+    // Add multiple objects, given as columns (see gpudb::AvroColumns), to an
+    // existing set in GPUdb; the objects are encoded straight from the column
+    // buffers into the request (requires BINARY encoding)
+    bool bulk_add( const std::string& set_id,
+                   const gpudb::AvroColumns& columns,
+                   const std::string& type_definition,
+                   const gpudb::add_parameter& param,
+                   gpudb::bulk_add_response& response );
+
     // Add multiple objects to an existing set in GPUdb
     // Note: all parameter checking is done in GPUdb internally and
     //        not here; so use this version at your own risk
@@ -158,6 +355,11 @@ public:
     bool bounding_box( const gpudb::bounding_box_request& request,
                        gpudb::bounding_box_response& response );
 
+    // Do a prepared bounding box filter; only the box's coordinates are
+    // encoded on each call (see gpudb::PreparedQuery)
+    bool bounding_box( gpudb::PreparedQuery<gpudb::bounding_box_request>& request,
+                       gpudb::bounding_box_response& response );
+
     // Clear an existing set in GPUdb
     bool clear( const std::string &set_id,
                 const std::string &authorization,
@@ -180,6 +382,44 @@ public:
     bool get_set( const gpudb::get_set_request& request,
                   gpudb::get_set_response& response );
 
+    // Get a prepared range of the data of an existing set in GPUdb; only
+    // start and end are encoded on each call (see gpudb::PreparedQuery)
+    bool get_set( gpudb::PreparedQuery<gpudb::get_set_request>& request,
+                  gpudb::get_set_response& response );
+
+    // Get the data from an existing set in GPUdb into a flat response whose
+    // objects and ids are each stored in one contiguous arena
+    bool get_set( const std::string& set_id,
+                  const int64_t& start,
+                  const int64_t& end,
+                  const std::string& semantic_type,
+                  gpudb::get_set_flat_response& response );
+
+    // Get the data from an existing set in GPUdb into a flat response
+    // Note: all parameter checking is done in GPUdb internally and
+    //        not here; so use this version at your own risk
+    bool get_set( const gpudb::get_set_request& request,
+                  gpudb::get_set_flat_response& response );
+
+    // Get a prepared range of the data of an existing set into a flat response
+    bool get_set( gpudb::PreparedQuery<gpudb::get_set_request>& request,
+                  gpudb::get_set_flat_response& response );
+
+    // Get the data from an existing set in GPUdb, handing each object to
+    // the sink as it is received; memory use is bounded by the size of an
+    // object rather than of the response (with BINARY encoding)
+    bool get_set( const std::string& set_id,
+                  const int64_t& start,
+                  const int64_t& end,
+                  const std::string& semantic_type,
+                  gpudb::get_set_sink& sink );
+
+    // Get the data from an existing set in GPUdb into a sink
+    // Note: all parameter checking is done in GPUdb internally and
+    //        not here; so use this version at your own risk
+    bool get_set( const gpudb::get_set_request& request,
+                  gpudb::get_set_sink& sink );
+
     // Create a new set in GPUdb
     bool new_set( const std::string &set_id,
                   const std::string &parent_set_id,
@@ -224,7 +464,146 @@ public:
     //        not here; so use this version at your own risk
     bool status( const gpudb::status_request &request, gpudb::status_response &response );
 
-};  // end class GPUdb
+};  // end class BasicGPUdb
+
+
+// A GPUdb handler with BINARY or JSON encoding, as named to its constructor,
+// over HTTP
+typedef BasicGPUdb<gpudb::RuntimeEncoding, gpudb::PocoTransport> GPUdb;
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Template function definitions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+// Add an object to an existing set in GPUdb
+// In: set_id -- name of the set to which the object will be added (required)
+//     object -- The object; encoded with its avro::codec_traits
+//     param -- /add parameter
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::add_object_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+template <class T>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::add_object( const std::string &set_id,
+                                                              const T &object,
+                                                              const gpudb::add_parameter& param,
+                                                              gpudb::add_object_response &response )
+{
+    gpudb::add_object_request request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+
+    // The error is set outside of the try, as set_error() may throw
+    std::string error;
+    try
+    {
+        if ( g_encoding.binary() )
+        {
+            request.object_encoding = "BINARY";
+            if ( false == gpudb::AvroUtils::convert_to_bytes<T>( object, request.object_data ) )
+                error = "add_object: the object could not be encoded as BINARY";
+        }
+        else
+        {
+            request.object_encoding = "JSON";
+            if ( false == gpudb::AvroUtils::convert_to_json_by_schema<T>( object,
+                                                                         T::schema(),
+                                                                         request.object_data_str ) )
+                error = "add_object: the object could not be encoded as JSON";
+        }
+    }
+    catch ( const std::exception &e )
+    {
+        error = std::string( "add_object: " ) + e.what();
+    }
+    if ( !error.empty() )
+        return set_error( error );
+
+    set_add_parameter( param, request.params );
+
+    // Make an HTTP call to GPUdb and return the response
+    return add_object( request, response );
+}   // end add_object with typed object
+
+
+
+// Add multiple objects to an existing set in GPUdb
+// In: set_id -- name of the set to which the objects will be added (required)
+//     objects -- The objects; each is encoded with its avro::codec_traits
+//     param -- /bulkadd parameter
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::bulk_add_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+template <class T>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bulk_add( const std::string& set_id,
+                                                            const std::vector<T>& objects,
+                                                            const gpudb::add_parameter& param,
+                                                            gpudb::bulk_add_response& response )
+{
+    gpudb::bulk_add_request request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+
+    // Get the number of objects to add
+    size_t num_objs = objects.size();
+
+    // GPUdb derives the number of objects to add from the size of the
+    // binary container; the unused container holds empty things.
+    // The objects are encoded in place, in order, by the worker pool
+    request.list_str.resize( num_objs );
+
+    if ( g_encoding.binary() )
+    {
+        request.list.resize( num_objs );
+        request.list_encoding = "BINARY";
+        gpudb::bulk_add_binary_task<T> task( objects, request.list, BULK_ADD_GRAIN );
+        if ( false == run_bulk_add_task( task ) )
+            return false;
+    }
+    else
+    {
+
+        const avro::ValidSchema* schema;
+        try
+        {
+            schema = &T::schema();
+        }
+        catch ( const std::exception &e )
+        {
+            return set_error( std::string( "bulk_add: " ) + e.what() );
+        }
+
+        gpudb::bulk_add_json_task<T> task( objects, *schema, request.list_str, BULK_ADD_GRAIN );
+        if ( false == run_bulk_add_task( task ) )
+            return false;
+
+        // The objects' json is written into the request as it is
+        set_add_parameter( param, request.params );
+        return bulk_add_json( set_id, request.list_str, request.params, response );
+    }
+
+    set_add_parameter( param, request.params );
+
+    // Make an HTTP call to GPUdb and return the response
+    return bulk_add( request, response );
+}   // end bulk_add with typed objects
+
+
+
+#include "GPUdb.ipp"
+
+// The configurations built into the library are compiled there, not here
+#if __cplusplus >= 201103L
+extern template class BasicGPUdb<gpudb::RuntimeEncoding, gpudb::PocoTransport>;
+extern template class BasicGPUdb<gpudb::BinaryEncoding, gpudb::PocoTransport>;
+extern template class BasicGPUdb<gpudb::JsonEncoding, gpudb::PocoTransport>;
+#endif
 
 
 #endif
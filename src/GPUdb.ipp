@@ -0,0 +1,1281 @@
+/* **********************************
+ * GPUdb C++ API
+ * Class BasicGPUdb Implementation
+ *
+ * Included by GPUdb.h, so that BasicGPUdb can be instantiated with any
+ * encoding and transport policies; the configurations built into the
+ * library are instantiated once, in GPUdb.cpp.
+ *
+ * @author Meem Mahmud
+ * GIS Federal, Inc.
+ * **********************************
+ */
+
+#ifndef _GPUDB_IPP_
+#define _GPUDB_IPP_
+
+#include <stdio.h>
+#include <exception>
+#include <sstream>
+#include <map>
+
+#include "Utils/GPUdbExceptions.h"
+#include "Utils/AvroVarint.h"
+#include "Utils/AvroJsonWriter.h"
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Constructors and other function(s)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Create a connection with a GPUdb server at the specified location
+// Optional parameters:
+//     username -- username for the GPUdb
+//     password -- password for the GPUdb
+//     throw_exceptions -- for enabling exception throwing (disabled by default)
+template <class EncodingPolicy, class TransportPolicy>
+BasicGPUdb<EncodingPolicy, TransportPolicy>::BasicGPUdb( std::string ip, int port, std::string encoding,
+                                                         std::string username, std::string password,
+                                                         bool throw_exceptions )
+{
+    // Set the username and password
+    g_username = username;
+    g_password = password;
+
+    // Set status and error messages to OK by default
+    g_error_message = "";
+    g_status = gpudb::OK;
+
+    // Perhaps not ideal C++, but lets the user decide if they want exceptions
+    g_throw_exceptions = throw_exceptions;
+
+    // Encode bulk_adds on the shared worker pool
+    g_num_workers = 0;
+
+    // Set the IP address and the port (need to conver to string)
+    g_ip = ip;
+    std::stringstream ss;
+    ss << port;
+    g_port = ss.str();
+
+
+    // TODO: Support SNAPPY encoding
+    // The encoding policy accepts the encodings it supports
+    if ( false == g_encoding.set( encoding ) )
+    {
+        g_error_message = "Invalid encoding provided: " + encoding;
+        g_status = gpudb::ERROR;
+        if ( g_throw_exceptions )
+            throw gpudb::InvalidEncodingException();
+    }
+
+    // TODO: Support HTTP and HTTPS
+
+
+    // Check that a connection can be established at the given IP address & port
+    // by making an HTTP call to GPUdb
+    try
+    {
+        g_transport.call_json( "{\"\"}", "/serverstatus",
+                               g_ip, g_port, g_username, g_password, true );
+    }
+    catch ( const std::exception &e )
+    {   // Set the error message and status, throw if needed
+        std::stringstream err_ss;
+        err_ss << "Could not connect to GPUdb (" << e.what() << ")";
+        g_error_message = err_ss.str();
+        g_status = gpudb::ERROR;
+        if ( g_throw_exceptions )
+            throw;
+    }
+
+}   // end constructor
+
+
+
+// Returns the current status of this GPUdb handler instance
+template <class EncodingPolicy, class TransportPolicy>
+gpudb::status_code BasicGPUdb<EncodingPolicy, TransportPolicy>::status()
+{
+    return g_status;
+} // end status
+
+
+// Returns the current error message, if any (empty string otherwise)
+template <class EncodingPolicy, class TransportPolicy>
+std::string BasicGPUdb<EncodingPolicy, TransportPolicy>::error_message()
+{
+    return g_error_message;
+}  // end error_message
+
+
+// Set the number of threads that encode the objects of a bulk_add
+template <class EncodingPolicy, class TransportPolicy>
+void BasicGPUdb<EncodingPolicy, TransportPolicy>::set_num_workers( size_t num_workers )
+{
+    g_num_workers = num_workers;
+
+    // 0 uses the shared pool and 1 the calling thread
+    if ( num_workers > 1 )
+        g_workers.reset( new gpudb::WorkerPool( num_workers ) );
+    else
+        g_workers.reset();
+}  // end set_num_workers
+
+
+
+
+
+// Make an HTTP request to GPUdb with the given endpoint and data
+// and extract the response data
+// Also stores any error message internally for the user's future use
+// Returns success or failure or throws exceptions if enabled in the constructor
+template <class EncodingPolicy, class TransportPolicy>
+template <class Treq, class Tresp>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::query( const Treq& request_data,
+                                                         const std::string& endpoint,
+                                                         Tresp& response )
+{
+    return query( request_data, endpoint, 0, false, response );
+}  // end query
+
+
+
+// Make an HTTP request to GPUdb with the endpoint that handles the request
+// type and extract the response data; an idempotent request is sent again if
+// it finds the kept-alive connection closed
+template <class EncodingPolicy, class TransportPolicy>
+template <class Treq, class Tresp>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::query( const Treq& request_data,
+                                                         Tresp& response )
+{
+    typedef gpudb::EndpointTraits<Treq> traits;
+    return query( request_data, traits::endpoint(), traits::expected_response_size, traits::idempotent, response );
+}  // end query
+
+
+
+template <class EncodingPolicy, class TransportPolicy>
+template <class Treq, class Tresp>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::query( const Treq& request_data,
+                                                         const std::string& endpoint,
+                                                         size_t response_size_hint,
+                                                         bool idempotent,
+                                                         Tresp& response )
+{
+    // For binary encoding, convert the object before the HTTP call
+    if ( g_encoding.binary() )
+    {
+        // The request is encoded into a pooled buffer, so repeated queries
+        // reuse its memory
+        gpudb::AvroCodecPool::Bytes avro_data;
+
+        // Convert the data to Avro format
+        gpudb::AvroUtils::convert_to_bytes<Treq>( request_data, *avro_data );
+
+        return query_binary( *avro_data, endpoint, response, response_size_hint, idempotent );
+    }  // end binary encoding
+    else
+    {   // for JSON encoding, convert the object to a JSON formatted string
+        // then make the HTTP call
+        std::string json_data;
+        
+        // Convert the data to JSON formatted string
+        gpudb::AvroUtils::convert_to_json_by_schema<Treq>( request_data, Treq::schema(), json_data );
+
+        return query_json( json_data, endpoint, response, idempotent );
+    }  // end json encoding
+}  // end query
+
+
+
+// Make an HTTP request to GPUdb with the given endpoint and the already
+// JSON encoded request data and extract the response data
+// Returns success or failure or throws exceptions if enabled in the constructor
+template <class EncodingPolicy, class TransportPolicy>
+template <class Tresp>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::query_json( const std::string& json_data,
+                                                              const std::string& endpoint,
+                                                              Tresp& response,
+                                                              bool idempotent )
+{
+    // Make an HTTP call to GPUdb
+    gpudb::gpudb_response gresponse = g_transport.call_json( json_data, endpoint, g_ip, g_port, g_username, g_password,
+                                                             idempotent );
+
+    // Upon success, convert the returned data to human readable data
+    if ( gresponse.status == "OK" )
+    {
+        gpudb::SchemaHandle response_schema = gpudb::AvroUtils::intern_known_schema( Tresp::schema_str(), Tresp::fingerprint() );
+        if ( gpudb::AvroUtils::convert_to_object( gresponse.data_str, response_schema, response ) == false )
+        {
+            // Indicate that there was a decoding error
+            gresponse.status = "ERROR";
+            gresponse.message = "Problem decoding Avro object for " + response.schema_name();
+        }
+    }
+
+    return set_query_status( gresponse );
+}  // end query_json
+
+
+
+// Make an HTTP request to GPUdb with the given endpoint and the already
+// binary encoded request data and extract the response data
+// Returns success or failure or throws exceptions if enabled in the constructor
+template <class EncodingPolicy, class TransportPolicy>
+template <class Tresp>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::query_binary( const std::vector<uint8_t>& avro_data,
+                                                                const std::string& endpoint,
+                                                                Tresp& response,
+                                                                size_t response_size_hint,
+                                                                bool idempotent )
+{
+    // Make an HTTP call to GPUdb; the response data is not copied out of
+    // the received buffer but decoded straight from it
+    gpudb::gpudb_response_view gresponse = g_transport.call_binary( avro_data, endpoint, g_ip, g_port, g_username, g_password,
+                                                                   response_size_hint, idempotent );
+
+    if ( gresponse.status == "ERROR" )
+        return set_error( gresponse.message.str() );
+
+    // Upon success, convert the returned data to human readable data
+    if ( gresponse.status == "OK" )
+    {
+        // Responses that view the data (e.g. get_set_flat_response) keep the buffer
+        gpudb::set_response_buffer( response, gresponse.buffer );
+
+        if( gpudb::AvroUtils::convert_to_object( gresponse.data.data, gresponse.data.size, response ) == false )
+            return set_error( "Problem decoding Avro object for " + response.schema_name() );
+    }
+
+    // successfully made the GPUdb query; reset the error status and message
+    g_status = gpudb::OK;
+    g_error_message = "";
+
+    return true;
+}  // end query_binary
+
+
+
+// Make a prepared query to the endpoint that handles the request type; with
+// binary encoding only the request's numeric fields are encoded
+// Returns success or failure or throws exceptions if enabled in the constructor
+template <class EncodingPolicy, class TransportPolicy>
+template <class Treq, class Tresp>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::query_prepared( gpudb::PreparedQuery<Treq>& prepared,
+                                                                  Tresp& response )
+{
+    if ( !g_encoding.binary() )
+        return query( prepared.request(), response );
+
+    const std::vector<uint8_t>& avro_data = prepared.bytes();
+    if ( avro_data.empty() )
+        return set_error( "Problem encoding Avro object for " + Treq::schema_name() );
+
+    typedef gpudb::EndpointTraits<Treq> traits;
+    return query_binary( avro_data, traits::endpoint(), response, traits::expected_response_size, traits::idempotent );
+}  // end query_prepared
+
+
+
+// Store the status and error message of a query's response
+// Returns success or failure or throws exceptions if enabled in the constructor
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::set_query_status( const gpudb::gpudb_response& gresponse )
+{
+    if ( gresponse.status == "ERROR" )
+        return set_error( gresponse.message );
+
+    // successfully made the GPUdb query; reset the error status and message
+    g_status = gpudb::OK;
+    g_error_message = "";
+
+    return true;
+}  // end set_query_status
+
+
+
+// Store the given error message and status
+// Returns false or throws exceptions if enabled in the constructor
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::set_error( const std::string& message )
+{
+    g_status = gpudb::ERROR;
+    g_error_message = message;
+
+    // Perhaps not ideal C++, but lets the user decide if they want exceptions
+    if ( g_throw_exceptions )
+        throw gpudb::QueryException( g_error_message );
+
+    return false;
+}  // end set_error
+
+
+
+
+// Run the encoding of a bulk_add's objects on the worker pool
+// Returns false and sets the error naming the first object that
+// could not be encoded, if any
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::run_bulk_add_task( gpudb::WorkerPool::ItemTask& task )
+{
+    // Small batches are not worth handing out
+    gpudb::WorkerPool* pool = NULL;
+    if ( ( task.size() > 2 * task.grain() ) && ( g_num_workers != 1 ) )
+        pool = g_workers ? g_workers.get() : &gpudb::WorkerPool::shared();
+
+    try
+    {
+        task.run_on( pool );
+    }
+    catch ( const std::exception &e )
+    {   // e.g. the workers could not be started
+        return set_error( std::string( "bulk_add: " ) + e.what() );
+    }
+
+    size_t failed = task.first_failed();
+    if ( failed != gpudb::WorkerPool::ItemTask::NONE )
+    {
+        std::stringstream err_ss;
+        err_ss << "bulk_add: object " << failed << " could not be encoded";
+        return set_error( err_ss.str() );
+    }
+
+    return true;
+}  // end run_bulk_add_task
+
+
+
+// Translate an /add or /bulkadd parameter into the request's params map
+//static
+template <class EncodingPolicy, class TransportPolicy>
+void BasicGPUdb<EncodingPolicy, TransportPolicy>::set_add_parameter( const gpudb::add_parameter& param,
+                                                                     std::map<std::string, std::string>& params )
+{
+    switch ( param ) // parse parameter options
+    {
+        case gpudb::UPDATE_ON_EXISTING_PK:
+            // Add this parameter to be true
+            params.insert( std::pair<std::string, std::string >( "update_on_existing_pk", "true" ) );
+            break;
+        case gpudb::NONE:
+        default:
+            // nothing to do; params will be empty
+            break;
+    }  // end switch on param
+}  // end set_add_parameter
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Constructors and other function(s) (end)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// GPUdb Endpoint API Wrapper Functions
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+
+// Ping GPUdb
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::ping( std::string &response )
+{
+    // Ping GPUdb
+    response = g_transport.ping( g_ip, g_port );
+
+    // Response should not be empty
+    if ( response == "" )
+        return false;
+    return true;
+
+}  // end ping
+
+
+// Add an object to an existing set in GPUdb
+// In: set_id -- name of the set to which the object will be added (required)
+//     object_data_json -- The object data in JSON format
+//     type_definition -- Defines the data type (may be needed to convert object
+//                        to binary format)
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::add_object_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::add_object( const std::string &set_id,
+                                                              const std::string &object_data_json,
+                                                              const std::string &type_definition,
+                                                              const gpudb::add_parameter& param,
+                                                              gpudb::add_object_response &response )
+{
+    gpudb::add_object_request request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+
+    if ( g_encoding.binary() )
+    {
+        request.object_data_str = "";
+        request.object_encoding = "BINARY";
+        if ( false == gpudb::AvroUtils::convert_json_to_binary_by_schema_str( object_data_json,
+                                                                       type_definition,
+                                                                       request.object_data ) )
+            return false;
+    }
+    else
+    {
+        request.object_data_str = object_data_json;
+        request.object_encoding = "JSON";
+    }
+
+    set_add_parameter( param, request.params );
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end add_object
+
+
+
+// Add an object to an existing set in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::add_object_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::add_object( const gpudb::add_object_request &request,
+                                                              gpudb::add_object_response &response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end add_object with request struct
+
+
+
+namespace gpudb {
+namespace detail {
+
+// Converts json objects to binary into the presized list of a /bulkadd request
+class json_to_binary_task : public gpudb::WorkerPool::ItemTask
+{
+public:
+    json_to_binary_task( const std::vector<std::string>& object_json_list,
+                         const gpudb::SchemaHandle& type_schema,
+                         std::vector<std::vector<uint8_t> >& list,
+                         size_t grain )
+        : ItemTask( object_json_list.size(), grain ),
+          object_json_list_( object_json_list ), type_schema_( type_schema ), list_( list ) {}
+
+protected:
+    virtual void process( size_t& i, size_t end )
+    {
+        for ( ; i < end; ++i )
+        {
+            if ( false == gpudb::AvroUtils::convert_json_to_binary_by_schema( object_json_list_[ i ],
+                                                                              type_schema_,
+                                                                              list_[ i ] ) )
+                return;
+        }
+    }
+
+private:
+    const std::vector<std::string>& object_json_list_;
+    const gpudb::SchemaHandle& type_schema_;
+    std::vector<std::vector<uint8_t> >& list_;
+};  // end class json_to_binary_task
+
+}  // end namespace detail
+}  // end namespace gpudb
+
+
+// Add multiple objects to an existing set in GPUdb
+// In: set_id -- name of the set to which the objects will be added (required)
+//     object_json_list -- A list of the object data in JSON format
+//     type_definition -- Defines the data type (may be needed to convert object
+//                        to binary format)
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::bulk_add_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bulk_add( const std::string& set_id,
+                                                            const std::vector<std::string>& object_json_list,
+                                                            const std::string& type_definition,
+                                                            const gpudb::add_parameter& param,
+                                                            gpudb::bulk_add_response& response )
+{
+    gpudb::bulk_add_request request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    set_add_parameter( param, request.params );
+
+    // Get the number of objects to add
+    size_t num_objs = object_json_list.size();
+
+    if ( g_encoding.binary() )
+    {
+        request.list_encoding = "BINARY";
+
+        // Compile (or look up) the type schema once for all the objects
+        gpudb::SchemaHandle type_schema;
+        try
+        {
+            type_schema = gpudb::AvroUtils::intern_schema( type_definition );
+        }
+        catch ( const std::exception &e )
+        {
+            return set_error( std::string( "bulk_add: " ) + e.what() );
+        }
+
+        // The objects are converted in place, in order, by the worker pool;
+        // list_str is used for JSON encoding only
+        request.list.resize( num_objs );
+        request.list_str.resize( num_objs );
+        gpudb::detail::json_to_binary_task task( object_json_list, type_schema, request.list, BULK_ADD_GRAIN );
+        if ( false == run_bulk_add_task( task ) )
+            return false;
+    }
+    else
+    {
+        // The objects' json is written into the request as it is
+        return bulk_add_json( set_id, object_json_list, request.params, response );
+    }
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end bulk_add
+
+
+namespace gpudb {
+namespace detail {
+
+// Write the avro binary encoding of a gpudb::bulk_add_request of the rows
+// of columns, encoded straight from the column buffers; the fields in order
+// are set_id, list, list_str, list_encoding and params
+inline void write_bulk_add_columns( const std::string& set_id,
+                                    const gpudb::AvroColumns& columns,
+                                    const std::map<std::string, std::string>& params,
+                                    std::vector<uint8_t>& avro_data )
+{
+    avro_data.reserve( set_id.size() + columns.encoded_array_size() + columns.num_rows() + 64 );
+
+    gpudb::AvroVarint::append_bytes( set_id.data(), set_id.size(), avro_data );
+
+    size_t pos = avro_data.size();
+    avro_data.resize( pos + columns.encoded_array_size() );
+    columns.encode_array( &avro_data[ pos ] );
+
+    // list_str is only used for JSON encoding; GPUdb expects one empty string per object
+    size_t num_objs = columns.num_rows();
+    if ( num_objs > 0 )
+    {
+        gpudb::AvroVarint::append( (int64_t)num_objs, avro_data );
+        avro_data.insert( avro_data.end(), num_objs, 0 );
+    }
+    avro_data.push_back( 0 );
+
+    const std::string list_encoding( "BINARY" );
+    gpudb::AvroVarint::append_bytes( list_encoding.data(), list_encoding.size(), avro_data );
+
+    if ( !params.empty() )
+    {
+        gpudb::AvroVarint::append( (int64_t)params.size(), avro_data );
+        for ( std::map<std::string, std::string>::const_iterator it = params.begin(); it != params.end(); ++it )
+        {
+            gpudb::AvroVarint::append_bytes( it->first.data(), it->first.size(), avro_data );
+            gpudb::AvroVarint::append_bytes( it->second.data(), it->second.size(), avro_data );
+        }
+    }
+    avro_data.push_back( 0 );
+}  // end write_bulk_add_columns
+
+}  // end namespace detail
+}  // end namespace gpudb
+
+
+// Add multiple objects, given as columns, to an existing set in GPUdb
+// The objects are encoded straight from the column buffers into the
+// /bulkadd request (only with BINARY encoding)
+// In: set_id -- name of the set to which the objects will be added (required)
+//     columns -- The object data, one column per type field in field order
+//     type_definition -- Defines the data type; the columns must match it
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::bulk_add_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bulk_add( const std::string& set_id,
+                                                            const gpudb::AvroColumns& columns,
+                                                            const std::string& type_definition,
+                                                            const gpudb::add_parameter& param,
+                                                            gpudb::bulk_add_response& response )
+{
+    if ( !g_encoding.binary() )
+        return set_error( "Adding objects from columns requires BINARY encoding" );
+
+    gpudb::SchemaHandle type_schema;
+    try
+    {
+        type_schema = gpudb::AvroUtils::intern_schema( type_definition );
+    }
+    catch ( const std::exception &e )
+    {
+        return set_error( e.what() );
+    }
+
+    if ( false == columns.matches( type_schema.schema() ) )
+        return set_error( "The columns do not match the type definition" );
+
+    std::map<std::string, std::string> params;
+    set_add_parameter( param, params );
+
+    std::vector<uint8_t> avro_data;
+    gpudb::detail::write_bulk_add_columns( set_id, columns, params, avro_data );
+
+    // Make an HTTP call to GPUdb and return the response
+    typedef gpudb::EndpointTraits<gpudb::bulk_add_request> traits;
+    return query_binary( avro_data, traits::endpoint(), response, traits::expected_response_size );
+}   // end bulk_add with columns
+
+
+namespace gpudb {
+namespace detail {
+
+// Write the avro json encoding of a gpudb::bulk_add_request of JSON encoded
+// objects straight from the objects' strings, each escaped once into the
+// request; the list of empty binary objects, there only for GPUdb to count
+// the objects, is written from the count
+inline void write_bulk_add_json( const std::string& set_id,
+                                 const std::vector<std::string>& object_json_list,
+                                 const std::map<std::string, std::string>& params,
+                                 std::string& json )
+{
+    const size_t num_objs = object_json_list.size();
+
+    // Room for the objects with an escape for every eighth character
+    size_t json_size = 0;
+    for ( size_t i = 0; i < num_objs; ++i )
+        json_size += object_json_list[ i ].size();
+    json.reserve( json.size() + json_size + ( json_size / 8 ) + ( 8 * num_objs ) + set_id.size() + 128 );
+
+    json.append( "{\"set_id\":" );
+    gpudb::AvroJsonWriter::write_string( set_id.data(), set_id.size(), json );
+
+    json.append( ",\"list\":[" );
+    for ( size_t i = 0; i < num_objs; ++i )
+        json.append( ( i == 0 ) ? "\"\"" : ",\"\"" );
+
+    json.append( "],\"list_str\":[" );
+    for ( size_t i = 0; i < num_objs; ++i )
+    {
+        if ( i > 0 )
+            json.push_back( ',' );
+        const std::string& object_json = object_json_list[ i ];
+        gpudb::AvroJsonWriter::write_string( object_json.data(), object_json.size(), json );
+    }
+
+    json.append( "],\"list_encoding\":\"JSON\",\"params\":{" );
+    for ( std::map<std::string, std::string>::const_iterator it = params.begin(); it != params.end(); ++it )
+    {
+        if ( it != params.begin() )
+            json.push_back( ',' );
+        gpudb::AvroJsonWriter::write_string( it->first.data(), it->first.size(), json );
+        json.push_back( ':' );
+        gpudb::AvroJsonWriter::write_string( it->second.data(), it->second.size(), json );
+    }
+    json.append( "}}" );
+}  // end write_bulk_add_json
+
+}  // end namespace detail
+}  // end namespace gpudb
+
+
+// Make a JSON encoded /bulkadd of the already JSON encoded objects
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::bulk_add_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bulk_add_json( const std::string& set_id,
+                                                                 const std::vector<std::string>& object_json_list,
+                                                                 const std::map<std::string, std::string>& params,
+                                                                 gpudb::bulk_add_response& response )
+{
+    std::string json_data;
+    gpudb::detail::write_bulk_add_json( set_id, object_json_list, params, json_data );
+
+    // Make an HTTP call to GPUdb and return the response
+    typedef gpudb::EndpointTraits<gpudb::bulk_add_request> traits;
+    return query_json( json_data, traits::endpoint(), response );
+}   // end bulk_add_json
+
+
+// Add multiple objects to an existing set in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::bulk_add_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bulk_add( const gpudb::bulk_add_request& request,
+                                                            gpudb::bulk_add_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end bulk_add with request struct
+
+
+
+
+// Do a bounding box filter on a given set
+// In: set_id -- name of the set on which the filter will be performed (required)
+//     result_set_id -- name of the resultant set
+//     min_x -- minimum x attribute value for the bounding box
+//     max_x -- maximum x attribute value for the bounding box
+//     min_y -- minimum y attribute value for the bounding box
+//     max_y -- maximum y attribute value for the bounding box
+//     x_attr_name -- name of the attribute that will be treated as the 'x' (1st) attribute
+//     y_attr_name -- name of the attribute that will be treated as the 'y' (2nd) attribute
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::bounding_box_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bounding_box( const std::string& set_id,
+                                                                const std::string& result_set_id,
+                                                                const double& min_x,
+                                                                const double& max_x,
+                                                                const double& min_y,
+                                                                const double& max_y,
+                                                                const std::string& x_attr_name,
+                                                                const std::string& y_attr_name,
+                                                                gpudb::bounding_box_response& response )
+{
+    gpudb::bounding_box_request request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    request.result_set_id = result_set_id;
+    request.min_x = min_x;
+    request.max_x = max_x;
+    request.min_y = min_y;
+    request.max_y = max_y;
+    request.x_attr_name = x_attr_name;
+    request.y_attr_name = y_attr_name;
+    request.user_auth_string = "";
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end bounding_box
+
+
+// Do a bounding box filter on a given set
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::bounding_box_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bounding_box( const gpudb::bounding_box_request& request,
+                                                                gpudb::bounding_box_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end bounding_box with request struct
+
+
+// Do a prepared bounding box filter on a given set
+// In: request -- The prepared request, with the box's coordinates set
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::bounding_box_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::bounding_box( gpudb::PreparedQuery<gpudb::bounding_box_request>& request,
+                                                                gpudb::bounding_box_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query_prepared( request, response );
+}   // end bounding_box with prepared request
+
+
+
+// Clear an existing set in GPUdb
+// In: set_id -- name of the set to be deleted/cleared (required)
+//     authorization -- deprecated parameter, user should pass an empty string
+//                      (any non-empty string will be disregarded)
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::clear_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::clear( const std::string &set_id,
+                                                         const std::string &authorization,
+                                                         gpudb::clear_response &response )
+{
+    gpudb::clear_request  request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    request.authorization = authorization;
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end clear
+
+
+// Clear an existing set in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::clear_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::clear( const gpudb::clear_request &request,
+                                                         gpudb::clear_response &response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end clear with request struct
+
+
+
+// Get the data from an existing set in GPUdb
+// In: set_id -- name of the set from which data is to be retrieved (required)
+//     start -- first index of the range of objects to retrieve
+//     end -- last index of the range of objects to retrieve
+//     semantic_type -- The type of objects to retrieve (relevant only for
+//                      parent sets that have child sets of different types)
+//                      Can be left empty.
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::get_set_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( const std::string& set_id,
+                                                           const int64_t& start,
+                                                           const int64_t& end,
+                                                           const std::string& semantic_type,
+                                                           gpudb::get_set_response& response )
+{
+    gpudb::get_set_request  request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    request.start = start;
+    request.end = end;
+    request.semantic_type = semantic_type;
+    request.user_auth_string = "";
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end get_set
+
+
+// Get the data from an existing set in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::get_set_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( const gpudb::get_set_request& request,
+                                                           gpudb::get_set_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end get_set with request struct
+
+
+// Get the data from an existing set in GPUdb
+// In: request -- The prepared request, with start and end set
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::get_set_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( gpudb::PreparedQuery<gpudb::get_set_request>& request,
+                                                           gpudb::get_set_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query_prepared( request, response );
+}   // end get_set with prepared request
+
+
+
+// Get the data from an existing set in GPUdb into a flat response
+// In: set_id -- name of the set from which data is to be retrieved (required)
+//     start -- first index of the range of objects to retrieve
+//     end -- last index of the range of objects to retrieve
+//     semantic_type -- The type of objects to retrieve (relevant only for
+//                      parent sets that have child sets of different types)
+//                      Can be left empty.
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::get_set_flat_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( const std::string& set_id,
+                                                           const int64_t& start,
+                                                           const int64_t& end,
+                                                           const std::string& semantic_type,
+                                                           gpudb::get_set_flat_response& response )
+{
+    gpudb::get_set_request  request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    request.start = start;
+    request.end = end;
+    request.semantic_type = semantic_type;
+    request.user_auth_string = "";
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end get_set with flat response
+
+
+// Get the data from an existing set in GPUdb into a flat response
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::get_set_flat_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( const gpudb::get_set_request& request,
+                                                           gpudb::get_set_flat_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end get_set with request struct and flat response
+
+
+// Get the data from an existing set in GPUdb into a flat response
+// In: request -- The prepared request, with start and end set
+// Out: Returns boolean value indicating failure/success
+//      Sets gpudb::get_set_flat_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( gpudb::PreparedQuery<gpudb::get_set_request>& request,
+                                                           gpudb::get_set_flat_response& response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query_prepared( request, response );
+}   // end get_set with prepared request and flat response
+
+
+
+namespace gpudb {
+namespace detail {
+
+// Decodes the get_set_response data of a /getset response straight
+// into a sink, item by item
+class get_set_stream_decoder : public gpudb::ResponseStreamDecoder
+{
+public:
+    explicit get_set_stream_decoder( gpudb::get_set_sink& sink ) : sink_( sink ) {}
+
+    virtual void decode( gpudb::AvroBufferDecoder& d, const std::string& data_type )
+    {
+        decode_items( d, &gpudb::get_set_sink::object );
+        decode_items( d, &gpudb::get_set_sink::object_str );
+        decode_items( d, &gpudb::get_set_sink::type_id );
+
+        std::string set_id;
+        avro::decode( d, set_id );
+        sink_.set_id( set_id );
+
+        decode_items( d, &gpudb::get_set_sink::object_id );
+    }
+
+private:
+    typedef void ( gpudb::get_set_sink::*item_fn )( size_t, const gpudb::bytes_view& );
+
+    gpudb::get_set_sink& sink_;
+    std::vector<uint8_t> scratch_; // holds items that span chunks of the stream
+
+    // Decode an array of bytes or strings, handing each to the sink
+    void decode_items( gpudb::AvroBufferDecoder& d, item_fn fn )
+    {
+        size_t i = 0;
+        for ( size_t n = d.arrayStart(); n != 0; n = d.arrayNext() )
+        {
+            for ( ; n > 0; --n, ++i )
+                ( sink_.*fn )( i, d.decode_bytes_view( scratch_ ) );
+        }
+    }
+};  // end class get_set_stream_decoder
+
+
+// Hand the items of an arena to a sink
+inline void sink_items( const gpudb::AvroArena& items,
+                        gpudb::get_set_sink& sink,
+                        void ( gpudb::get_set_sink::*fn )( size_t, const gpudb::bytes_view& ) )
+{
+    for ( size_t i = 0; i < items.size(); ++i )
+        ( sink.*fn )( i, items[ i ] );
+}
+
+}  // end namespace detail
+}  // end namespace gpudb
+
+
+// Get the data from an existing set in GPUdb into a sink
+// In: set_id -- name of the set from which data is to be retrieved (required)
+//     start -- first index of the range of objects to retrieve
+//     end -- last index of the range of objects to retrieve
+//     semantic_type -- The type of objects to retrieve (relevant only for
+//                      parent sets that have child sets of different types)
+//                      Can be left empty.
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success
+//      Hands the objects, type ids, set id and object ids returned by GPUdb
+//      to the sink as they are received
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( const std::string& set_id,
+                                                           const int64_t& start,
+                                                           const int64_t& end,
+                                                           const std::string& semantic_type,
+                                                           gpudb::get_set_sink& sink )
+{
+    gpudb::get_set_request  request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    request.start = start;
+    request.end = end;
+    request.semantic_type = semantic_type;
+    request.user_auth_string = "";
+
+    // Make an HTTP call to GPUdb and stream the response into the sink
+    return get_set( request, sink );
+}   // end get_set with sink
+
+
+// Get the data from an existing set in GPUdb into a sink
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success
+//      Hands the objects, type ids, set id and object ids returned by GPUdb
+//      to the sink as they are received
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::get_set( const gpudb::get_set_request& request,
+                                                           gpudb::get_set_sink& sink )
+{
+    if ( !g_encoding.binary() )
+    {
+        // JSON responses are not streamed; get the whole of it first
+        gpudb::get_set_flat_response response;
+        if ( false == get_set( request, response ) )
+            return false;
+
+        gpudb::detail::sink_items( response.list, sink, &gpudb::get_set_sink::object );
+        gpudb::detail::sink_items( response.list_str, sink, &gpudb::get_set_sink::object_str );
+        gpudb::detail::sink_items( response.type_ids, sink, &gpudb::get_set_sink::type_id );
+        sink.set_id( response.set_id );
+        gpudb::detail::sink_items( response.object_ids, sink, &gpudb::get_set_sink::object_id );
+        return true;
+    }
+
+    gpudb::AvroCodecPool::Bytes avro_data;
+    gpudb::AvroUtils::convert_to_bytes( request, *avro_data );
+
+    // Make an HTTP call to GPUdb; the objects reach the sink as they arrive
+    gpudb::detail::get_set_stream_decoder decoder( sink );
+    typedef gpudb::EndpointTraits<gpudb::get_set_request> traits;
+    gpudb::gpudb_response gresponse = g_transport.call_stream( *avro_data, traits::endpoint(), g_ip, g_port,
+                                                              decoder, g_username, g_password, traits::idempotent );
+    return set_query_status( gresponse );
+}   // end get_set with request struct and sink
+
+
+
+// Create a new set in GPUdb
+// In: type_id -- A string identifying the data type of the new set (required)
+//     set_id -- name of the set to be created (required)
+//     parent_set_id -- Name of an optional parent set (can be an empty string)
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::new_set_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::new_set( const std::string &type_id,
+                                                           const std::string &set_id,
+                                                           const std::string &parent_set_id,
+                                                           gpudb::new_set_response &response )
+{
+    gpudb::new_set_request  request;
+
+    // Set the request parameters
+    request.type_id = type_id;
+    request.set_id = set_id;
+    request.parent_set_id = parent_set_id;
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end new_set
+
+
+// Create a new set in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean value indicating failure/success 
+//      Sets gpudb::new_set_response structure member variables to
+//      values returned by GPUdb (only upon success)
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::new_set( const gpudb::new_set_request &request,
+                                                           gpudb::new_set_response &response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end new_set with request struct
+
+
+
+
+// Register a set as a parent set
+// In: set_id -- Name of an existing GPUdb set to be registered
+//               to be a parent set; required parameter
+//     allow_duplicate_children -- Allow/disallow duplicate children
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean failure/success 
+//      Sets gpudb::register_parent_set_response structure to
+//      values returned by GPUdb upon success
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::register_parent_set( const std::string &set_id,
+                                                                       bool allow_duplicate_children,
+                                                                       gpudb::register_parent_set_response &response )
+{
+    gpudb::register_parent_set_request request;
+
+    // Set the request parameters
+    request.set_id = set_id;
+    request.allow_duplicate_children = allow_duplicate_children;
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end register_parent_set
+
+
+// Register a set as a parent set
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean failure/success 
+//      Sets gpudb::register_parent_set_response structure to
+//      values returned by GPUdb upon success
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::register_parent_set( const gpudb::register_parent_set_request &request,
+                                                                       gpudb::register_parent_set_response &response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end register_parent_set with request struct
+
+
+
+// Register a data type definition in GPUdb
+// In: type definition -- required
+//     annotation -- optional (i.e. can be an empty string)
+//     label -- optional (i.e. can be an empty string)
+//     semantic_type -- required
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean failure/success 
+//      Sets gpudb::register_type_response structure to
+//      values returned by GPUdb upon success
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::register_type( const std::string &type_definition,
+                                                                 const std::string &annotation,
+                                                                 const std::string &label,
+                                                                 const std::string &semantic_type,
+                                                                 gpudb::register_type_response &response )
+{
+    gpudb::register_type_request  request;
+
+    // Set the request parameters
+    request.type_definition = type_definition;
+    request.annotation = annotation;
+    request.label = label;
+    request.semantic_type = semantic_type;
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end register_type
+
+
+// Register a data type definition in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean failure/success 
+//      Sets gpudb::register_type_response structure to
+//      values returned by GPUdb upon success
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::register_type( const gpudb::register_type_request &request,
+                                                                 gpudb::register_type_response &response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end register_type with request struct
+
+
+
+// Retrieve the status of a set in GPUdb
+// In: set_id -- Name of the set whose status is to be retrieved; required
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean failure/success 
+//      Sets gpudb::status_response structure to
+//      values returned by GPUdb upon success
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::status( std::string set_id, gpudb::status_response &response )
+{
+    gpudb::status_request  request;
+
+    request.set_id = set_id;
+
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end status
+
+
+// Retrieve the status of a set in GPUdb
+// In: requst -- Contains all parameters for the query
+// (Note: all parameter checking is done in GPUdb internally and
+//        not here.)
+// Out: Returns boolean failure/success 
+//      Sets gpudb::status_response structure to
+//      values returned by GPUdb upon success
+template <class EncodingPolicy, class TransportPolicy>
+bool BasicGPUdb<EncodingPolicy, TransportPolicy>::status( const gpudb::status_request &request,
+                                                          gpudb::status_response &response )
+{
+    // Make an HTTP call to GPUdb and return the response
+    return query( request, response );
+}   // end status with request struct
+
+#endif // _GPUDB_IPP_
@@ -0,0 +1,159 @@
+/* **********************************
+ * GPUdb C++ API
+ * Encoding and transport policies of class BasicGPUdb
+ * **********************************
+ */
+
+#ifndef _GPUDB_POLICIES_H_
+#define _GPUDB_POLICIES_H_
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <boost/scoped_ptr.hpp>
+
+#include "Utils/HTTPUtils.h"
+
+
+namespace gpudb
+{
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Encoding policies: how requests and objects are encoded.
+//
+// binary() is true for BINARY and false for JSON encoding; set() checks
+// the encoding named to the constructor. The fixed policies make binary()
+// a constant, so the unused encoding's code is compiled out.
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/// Always BINARY encoding
+struct BinaryEncoding
+{
+    static inline bool binary() { return true; }
+    static inline const char* name() { return "BINARY"; }
+    static inline bool set( const std::string& encoding ) { return encoding == name(); }
+};  // end struct BinaryEncoding
+
+
+/// Always JSON encoding
+struct JsonEncoding
+{
+    static inline bool binary() { return false; }
+    static inline const char* name() { return "JSON"; }
+    static inline bool set( const std::string& encoding ) { return encoding == name(); }
+};  // end struct JsonEncoding
+
+
+/// BINARY or JSON encoding, as named to the constructor (the GPUdb default);
+/// the name is only compared once, not on every call
+class RuntimeEncoding
+{
+public:
+    RuntimeEncoding() : binary_( true ) {}
+
+    inline bool binary() const { return binary_; }
+    inline const char* name() const { return binary_ ? BinaryEncoding::name() : JsonEncoding::name(); }
+
+    inline bool set( const std::string& encoding )
+    {
+        if ( BinaryEncoding::set( encoding ) )
+            binary_ = true;
+        else if ( JsonEncoding::set( encoding ) )
+            binary_ = false;
+        else
+            return false;
+        return true;
+    }
+
+private:
+    bool binary_;
+};  // end class RuntimeEncoding
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// Transport policies: how requests reach GPUdb.
+//
+// A transport provides the calls of PocoTransport, which behave as the
+// HTTPUtils functions they forward to; e.g. an in-process stand-in for
+// testing without a server only needs to implement these. Each call is told
+// whether its request is idempotent (EndpointTraits::idempotent), i.e.
+// whether it may be sent again after a failure that left it unanswered.
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+/// HTTP through Poco::Net (the GPUdb default); the connection to GPUdb is
+/// kept alive between calls, and reopened when the server closes it (an
+/// idempotent request that found it closed is sent again).
+/// Copies open their own connection.
+class PocoTransport
+{
+public:
+    PocoTransport() {}
+    PocoTransport( const PocoTransport& ) {}
+    PocoTransport& operator=( const PocoTransport& ) { connection_.reset(); return *this; }
+
+    // Ping GPUdb; returns an empty string if it could not be reached
+    inline std::string ping( const std::string& ip, const std::string& port )
+    {
+        return HTTPUtils::ping( ip, port );
+    }
+
+    // Make a JSON encoded call
+    inline gpudb_response call_json( const std::string& json_data,
+                                     const std::string& endpoint,
+                                     const std::string& ip,
+                                     const std::string& port,
+                                     const std::string& username,
+                                     const std::string& password,
+                                     bool idempotent )
+    {
+        return HTTPUtils::call_gpudb( json_data, endpoint, connection( ip, port ), idempotent );
+    }
+
+    // Make a binary encoded call; the response views the received buffer
+    inline gpudb_response_view call_binary( const std::vector<uint8_t>& binary_data,
+                                            const std::string& endpoint,
+                                            const std::string& ip,
+                                            const std::string& port,
+                                            const std::string& username,
+                                            const std::string& password,
+                                            size_t response_size_hint,
+                                            bool idempotent )
+    {
+        return HTTPUtils::call_gpudb_view( binary_data, endpoint, connection( ip, port ), response_size_hint,
+                                           idempotent );
+    }
+
+    // Make a binary encoded call, decoding the response's data as it is received
+    inline gpudb_response call_stream( const std::vector<uint8_t>& binary_data,
+                                       const std::string& endpoint,
+                                       const std::string& ip,
+                                       const std::string& port,
+                                       ResponseStreamDecoder& data_decoder,
+                                       const std::string& username,
+                                       const std::string& password,
+                                       bool idempotent )
+    {
+        return HTTPUtils::call_gpudb_stream( binary_data, endpoint, connection( ip, port ), data_decoder,
+                                             idempotent );
+    }
+
+private:
+    boost::scoped_ptr<HTTPConnection> connection_;
+
+    // The open connection to ip:port, opening it on first use
+    inline HTTPConnection& connection( const std::string& ip, const std::string& port )
+    {
+        if ( !connection_ || ( connection_->ip() != ip ) || ( connection_->port() != port ) )
+            connection_.reset( new HTTPConnection( ip, port ) );
+        return *connection_;
+    }
+};  // end class PocoTransport
+
+
+}  // end namespace gpudb
+
+#endif
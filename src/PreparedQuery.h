@@ -0,0 +1,136 @@
+#ifndef __PREPARED_QUERY_H__
+#define __PREPARED_QUERY_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include "EndpointTraits.h"
+#include "Utils/AvroUtils.h"
+#include "Utils/AvroVarint.h"
+
+
+namespace gpudb {
+
+// --------------------------------------------------------------------------
+/// @class PreparedRequestTraits The numeric fields a prepared request may
+///        change between executions. They lead the request's schema, so
+///        their encoding (the head) is a prefix of the request's:
+///
+///        MAX_HEAD_SIZE  -- the most bytes the fields encode to
+///        encode_head()  -- writes their avro binary encoding to out and
+///                          returns its size
+///
+///        Only requests with a specialization (below) can be prepared.
+// --------------------------------------------------------------------------
+template <class Treq>
+struct PreparedRequestTraits;
+
+template <>
+struct PreparedRequestTraits<bounding_box_request>
+{
+    static const size_t MAX_HEAD_SIZE = 4 * sizeof( double );
+
+    static inline size_t encode_head( const bounding_box_request& r, uint8_t* out )
+    {
+        // avro doubles are 8 little endian bytes, as on the host
+        memcpy( out,                        &r.min_x, sizeof( double ) );
+        memcpy( out + 1 * sizeof( double ), &r.max_x, sizeof( double ) );
+        memcpy( out + 2 * sizeof( double ), &r.min_y, sizeof( double ) );
+        memcpy( out + 3 * sizeof( double ), &r.max_y, sizeof( double ) );
+        return MAX_HEAD_SIZE;
+    }
+};
+
+template <>
+struct PreparedRequestTraits<get_set_request>
+{
+    static const size_t MAX_HEAD_SIZE = 2 * AvroVarint::MAX_ENCODED_SIZE;
+
+    static inline size_t encode_head( const get_set_request& r, uint8_t* out )
+    {
+        size_t n = AvroVarint::encode( r.start, out );
+        return n + AvroVarint::encode( r.end, out + n );
+    }
+};
+
+
+
+// --------------------------------------------------------------------------
+/// @class PreparedQuery A request that is made many times with only its
+///        numeric fields (see PreparedRequestTraits) changing, e.g. a
+///        dashboard's bounding box or page of a set.
+///
+///        The request is binary encoded once, by prepare(); each execution
+///        (e.g. GPUdb::bounding_box(prepared, response)) only encodes the
+///        numeric fields over the start of that encoding, moving the rest
+///        if a varint changed length, and sends it to the endpoint from
+///        EndpointTraits. Changes to the request's other fields are not
+///        sent until prepare() is called again. With JSON encoding the
+///        request is encoded in full each time.
+///
+///        Not thread safe; each thread should have its own.
+// --------------------------------------------------------------------------
+template <class Treq>
+class PreparedQuery
+{
+    typedef PreparedRequestTraits<Treq> layout;
+
+public:
+    typedef typename EndpointTraits<Treq>::response_type response_type;
+
+    explicit PreparedQuery( const Treq& request ) : request_( request ), head_size_( 0 )
+    {
+        prepare();
+    }
+
+    /// The request; set its numeric fields before each execution.
+    inline Treq& request() { return request_; }
+    inline const Treq& request() const { return request_; }
+
+    /// Encode the whole request again, after changing its other fields.
+    /// Returns false if it could not be encoded.
+    bool prepare()
+    {
+        bytes_.clear();
+        head_size_ = 0;
+        if ( !AvroUtils::convert_to_bytes( request_, bytes_ ) )
+        {
+            bytes_.clear();
+            return false;
+        }
+
+        uint8_t head[ layout::MAX_HEAD_SIZE ];
+        head_size_ = layout::encode_head( request_, head );
+        return true;
+    }
+
+    /// The binary encoding of the request with its current numeric fields;
+    /// empty if prepare() failed.
+    const std::vector<uint8_t>& bytes()
+    {
+        if ( bytes_.empty() )
+            return bytes_;
+
+        uint8_t head[ layout::MAX_HEAD_SIZE ];
+        size_t head_size = layout::encode_head( request_, head );
+        if ( head_size > head_size_ )
+            bytes_.insert( bytes_.begin(), head_size - head_size_, 0 );
+        else if ( head_size < head_size_ )
+            bytes_.erase( bytes_.begin(), bytes_.begin() + ( head_size_ - head_size ) );
+        head_size_ = head_size;
+
+        memcpy( &bytes_[0], head, head_size );
+        return bytes_;
+    }
+
+private:
+    Treq                 request_;
+    std::vector<uint8_t> bytes_;     // The encoded request, as of the last bytes()
+    size_t               head_size_; // The size of the numeric fields in bytes_
+};
+
+} // namespace gpudb
+
+#endif // __PREPARED_QUERY_H__
@@ -0,0 +1,219 @@
+/* **********************************
+ * GPUdb C++ API
+ * Class SetScanner Implementation
+ * **********************************
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SetScanner.h"
+
+
+namespace gpudb {
+
+struct SetScanner::state
+{
+    struct fetched_page
+    {
+        get_set_flat_response* page;
+        int64_t                start; ///< The index of its first object
+    };
+
+    std::unique_ptr<page_source> source; ///< Used by the fetching thread only
+    get_set_request              request;
+    size_t                       page_size;
+    size_t                       max_ahead; ///< Pages fetched ahead of the caller's
+
+    mutable std::mutex      mutex; ///< Guards the rest
+    std::condition_variable page_ready;
+    std::condition_variable page_taken;
+
+    std::deque<fetched_page>            ready; ///< Fetched pages, in order
+    std::vector<get_set_flat_response*> spare; ///< Pages to fetch into
+    int64_t                             position;
+    bool                                done;  ///< No more pages will be fetched
+    bool                                stop;
+    std::string                         error;
+
+    std::thread fetcher;
+
+    state() : page_size( 0 ), max_ahead( 1 ), position( 0 ), done( false ), stop( false ) {}
+
+    ~state()
+    {
+        for ( size_t i = 0; i < ready.size(); ++i )
+            delete ready[i].page;
+        for ( size_t i = 0; i < spare.size(); ++i )
+            delete spare[i];
+    }
+
+    // Fetch pages until the end of the set, an error or stop; each page
+    // starts after the objects of the last, as GPUdb may return fewer than
+    // were asked for (e.g. when it caps the size of a page)
+    void fetch_loop()
+    {
+        for ( int64_t start = request.start; ; )
+        {
+            get_set_flat_response* page;
+            {
+                std::unique_lock<std::mutex> lock( mutex );
+                while ( !stop && ( ready.size() >= max_ahead ) )
+                    page_taken.wait( lock );
+                if ( stop )
+                    return;
+
+                if ( spare.empty() )
+                    page = new get_set_flat_response();
+                else
+                {
+                    page = spare.back();
+                    spare.pop_back();
+                }
+            }
+
+            get_set_request page_request( request );
+            page_request.start = start;
+            page_request.end = start + (int64_t)page_size - 1; // inclusive
+
+            page->clear();
+            std::string page_error;
+            try
+            {
+                if ( !source->get_set( page_request, *page ) )
+                {
+                    page_error = source->error_message();
+                    if ( page_error.empty() )
+                        page_error = "Unable to get a page of the set";
+                }
+            }
+            catch ( const std::exception& e )
+            {
+                page_error = e.what();
+            }
+            catch ( ... )
+            {
+                // Nothing may escape the thread, or the program terminates
+                page_error = "Unknown error getting a page of the set";
+            }
+            if ( page_error.empty() && ( page->size() > page_size ) )
+                page_error = "GPUdb returned more objects than were asked for";
+
+            std::lock_guard<std::mutex> lock( mutex );
+            if ( !page_error.empty() )
+            {
+                spare.push_back( page );
+                error = page_error;
+                done = true;
+                page_ready.notify_one();
+                return;
+            }
+
+            // Only an empty page ends the set; a short one may be a capped one
+            if ( page->size() > 0 )
+            {
+                fetched_page fetched = { page, start };
+                ready.push_back( fetched );
+                start += (int64_t)page->size();
+            }
+            else
+            {
+                spare.push_back( page );
+                done = true;
+            }
+
+            page_ready.notify_one();
+            if ( done )
+                return;
+        }
+    }  // end fetch_loop
+};  // end struct SetScanner::state
+
+
+
+void SetScanner::start( page_source* source,
+                        const std::string& set_id,
+                        size_t page_size,
+                        size_t num_buffers,
+                        const std::string& semantic_type )
+{
+    std::unique_ptr<state> s( new state() );
+    s->source.reset( source );
+    s->request.set_id = set_id;
+    s->request.semantic_type = semantic_type;
+    s->request.user_auth_string = "";
+    s->request.start = 0;
+    s->page_size = std::max( page_size, (size_t)1 );
+    s->max_ahead = std::max( num_buffers, (size_t)2 ) - 1;
+
+    s->fetcher = std::thread( &state::fetch_loop, s.get() );
+    state_ = s.release();
+}  // end start
+
+
+SetScanner::~SetScanner()
+{
+    {
+        std::lock_guard<std::mutex> lock( state_->mutex );
+        state_->stop = true;
+    }
+    state_->page_taken.notify_one();
+    state_->fetcher.join();
+
+    delete state_;
+}
+
+
+bool SetScanner::next( get_set_flat_response& page )
+{
+    std::unique_lock<std::mutex> lock( state_->mutex );
+    while ( state_->ready.empty() && !state_->done )
+        state_->page_ready.wait( lock );
+
+    if ( state_->ready.empty() )
+    {
+        page.clear();
+        return false;
+    }
+
+    // Hand over the fetched page and keep the caller's for the next fetch
+    state::fetched_page fetched = state_->ready.front();
+    state_->ready.pop_front();
+    std::swap( page, *fetched.page );
+    fetched.page->clear();
+    state_->spare.push_back( fetched.page );
+    state_->position = fetched.start;
+    lock.unlock();
+
+    state_->page_taken.notify_one();
+    return true;
+}  // end next
+
+
+int64_t SetScanner::position() const
+{
+    std::lock_guard<std::mutex> lock( state_->mutex );
+    return state_->position;
+}
+
+
+bool SetScanner::failed() const
+{
+    std::lock_guard<std::mutex> lock( state_->mutex );
+    return !state_->error.empty();
+}
+
+
+std::string SetScanner::error_message() const
+{
+    std::lock_guard<std::mutex> lock( state_->mutex );
+    return state_->error;
+}
+
+} // namespace gpudb
@@ -0,0 +1,115 @@
+#ifndef __SET_SCANNER_H__
+#define __SET_SCANNER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "obj_defs/getsetrequest.h"
+#include "obj_defs/getsetflatresponse.h"
+
+
+namespace gpudb {
+
+// --------------------------------------------------------------------------
+/// @class SetScanner Reads a whole set from GPUdb a page (of page_size
+///        objects) at a time, fetching the next pages on a background thread
+///        while the caller processes the current one, so a scan takes about
+///        as long as the slower of the network and the processing rather
+///        than both added up:
+///
+///            gpudb::SetScanner scanner( gpudb, "my_set", 10000 );
+///            gpudb::get_set_flat_response page;
+///            while ( scanner.next( page ) )
+///                process( page );
+///            if ( scanner.failed() )
+///                std::cerr << scanner.error_message() << std::endl;
+///
+///        num_buffers pages are held at once: the caller's and up to
+///        num_buffers - 1 fetched ahead (2 for double buffering, 3 for
+///        triple, which hides an occasional slow page). The pages are
+///        swapped with the caller's, so their memory is reused.
+///
+///        The scanner queries a copy of the GPUdb handle, which makes its own
+///        connection; the handle passed in can still be used meanwhile. Each
+///        page starts after the last object returned, so pages GPUdb caps
+///        below page_size still cover the set, and the scan ends at the
+///        first empty page (one request past the last object).
+///        Destroying the scanner stops it, after any fetch in progress.
+// --------------------------------------------------------------------------
+class SetScanner
+{
+public:
+
+    /// Start fetching the set through a copy of gpudb (any BasicGPUdb).
+    template <class TGPUdb>
+    SetScanner( const TGPUdb& gpudb,
+                const std::string& set_id,
+                size_t page_size,
+                size_t num_buffers = 2,
+                const std::string& semantic_type = "" ) : state_( NULL )
+    {
+        start( new page_source_of<TGPUdb>( gpudb ), set_id, page_size, num_buffers, semantic_type );
+    }
+
+    ~SetScanner();
+
+    /// Swap the next page into page, waiting for it if it has not arrived
+    /// yet. Returns false at the end of the set or if a page could not be
+    /// fetched (see failed()); page is then left empty.
+    bool next( get_set_flat_response& page );
+
+    /// The index in the set of the first object of the last page returned.
+    int64_t position() const;
+
+    /// True if the scan stopped because a page could not be fetched.
+    bool failed() const;
+
+    /// Why a page could not be fetched, if one could not.
+    std::string error_message() const;
+
+private:
+
+    /// Fetches pages for the background thread.
+    class page_source
+    {
+    public:
+        virtual ~page_source() {}
+
+        /// Fetch a page; returns false (or throws) if it could not.
+        virtual bool get_set( const get_set_request& request, get_set_flat_response& page ) = 0;
+        virtual std::string error_message() = 0;
+    };
+
+    template <class TGPUdb>
+    class page_source_of : public page_source
+    {
+    public:
+        explicit page_source_of( const TGPUdb& gpudb ) : gpudb_( gpudb ) {}
+
+        virtual bool get_set( const get_set_request& request, get_set_flat_response& page )
+        {
+            return gpudb_.get_set( request, page );
+        }
+        virtual std::string error_message() { return gpudb_.error_message(); }
+
+    private:
+        TGPUdb gpudb_;
+    };
+
+    struct state;
+    state* state_;
+
+    void start( page_source* source,
+                const std::string& set_id,
+                size_t page_size,
+                size_t num_buffers,
+                const std::string& semantic_type );
+
+    SetScanner( const SetScanner& );
+    SetScanner& operator=( const SetScanner& );
+};
+
+} // namespace gpudb
+
+#endif // __SET_SCANNER_H__
@@ -0,0 +1,110 @@
+#include "AvroArena.h"
+#include "AvroBufferDecoder.h"
+
+#include <algorithm>
+
+
+namespace gpudb
+{
+
+void AvroArena::decode(avro::Decoder& d, bool as_string)
+{
+    clear();
+
+    // The buffer decoder appends each item's data straight into the arena
+    AvroBufferDecoder* buffer_decoder = dynamic_cast<AvroBufferDecoder*>(&d);
+    std::string str_value;
+    std::vector<uint8_t> bytes_value;
+
+    for (size_t n = d.arrayStart(); n != 0; n = d.arrayNext())
+    {
+        // Size the arena for the whole block up front when the block is in
+        // memory; the scan also validates the count, so it can be trusted
+        size_t block_bytes;
+        if ((buffer_decoder != NULL) && buffer_decoder->peek_bytes_size(n, block_bytes))
+        {
+            offsets_.reserve(offsets_.size() + n);
+            data_.reserve(data_.size() + block_bytes);
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (buffer_decoder != NULL)
+                buffer_decoder->append_decoded_bytes(data_);
+            else if (as_string)
+            {
+                d.decodeString(str_value);
+                data_.insert(data_.end(), str_value.begin(), str_value.end());
+            }
+            else
+            {
+                d.decodeBytes(bytes_value);
+                data_.insert(data_.end(), bytes_value.begin(), bytes_value.end());
+            }
+            offsets_.push_back(data_.size());
+        }
+    }
+}
+
+void AvroArena::decode_views(AvroBufferDecoder& d, const buffer_ptr& buffer)
+{
+    clear();
+    owner_ = buffer;
+
+    for (size_t n = d.arrayStart(); n != 0; n = d.arrayNext())
+    {
+        // Every item takes at least a byte, don't trust the count any further
+        views_.reserve(views_.size() + std::min(n, (size_t)(d.end() - d.position())));
+
+        for (size_t i = 0; i < n; ++i)
+            views_.push_back(d.decode_bytes_view());
+    }
+}
+
+size_t AvroArena::bytes() const
+{
+    if (!owner_)
+        return data_.size();
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < views_.size(); ++i)
+        bytes += views_[i].size;
+    return bytes;
+}
+
+void AvroArena::copy_views()
+{
+    std::vector<bytes_view> views;
+    views.swap(views_);
+    buffer_ptr owner = owner_; // keeps the views valid while copying
+    owner_.reset();
+
+    for (size_t i = 0; i < views.size(); ++i)
+        push_back(views[i]);
+}
+
+void AvroArena::encode(avro::Encoder& e, bool as_string) const
+{
+    std::string str_value;
+
+    e.arrayStart();
+    if (!empty())
+    {
+        e.setItemCount(size());
+        for (size_t i = 0; i < size(); ++i)
+        {
+            e.startItem();
+            bytes_view item = (*this)[i];
+            if (as_string)
+            {
+                str_value.assign(item.c_data(), item.size);
+                e.encodeString(str_value);
+            }
+            else
+                e.encodeBytes(item.data, item.size);
+        }
+    }
+    e.arrayEnd();
+}
+
+} // end namespace gpudb
@@ -0,0 +1,141 @@
+#ifndef _AVRO_ARENA_H_
+#define _AVRO_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <avro/Decoder.hh>
+#include <avro/Encoder.hh>
+
+#include "BytesView.h"
+
+
+namespace gpudb
+{
+
+class AvroBufferDecoder;
+
+// --------------------------------------------------------------------------
+/// @class AvroArena A list of byte strings stored back to back in a single
+///        buffer with a table of offsets, rather than one heap allocation per
+///        item as in a std::vector<std::vector<uint8_t> > or std::vector<std::string>.
+///
+///        Alternatively (see decode_views()) the items may be views into a
+///        shared buffer, e.g. a received response, that the arena keeps alive.
+///
+///        Items are accessed as bytes_views which stay valid until the arena
+///        is modified.
+// --------------------------------------------------------------------------
+class AvroArena
+{
+public:
+
+    typedef boost::shared_ptr<const std::vector<uint8_t> > buffer_ptr;
+
+    AvroArena() : offsets_(1, 0) { }
+
+    inline size_t size() const  { return owner_ ? views_.size() : offsets_.size() - 1; }
+    inline bool   empty() const { return size() == 0; }
+
+    /// The total number of bytes of all the items.
+    size_t bytes() const;
+
+    inline bytes_view operator[](size_t i) const
+    {
+        if (owner_)
+            return views_[i];
+        return bytes_view(data_.empty() ? NULL : &data_[0] + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    }
+
+    /// A copy of item i as a string.
+    inline std::string str(size_t i) const { return (*this)[i].str(); }
+
+    /// True if the items are views into a shared buffer.
+    inline bool is_view() const { return owner_.get() != NULL; }
+
+    inline void clear()
+    {
+        data_.clear();
+        offsets_.resize(1);
+        views_.clear();
+        owner_.reset();
+    }
+
+    inline void reserve(size_t items, size_t bytes)
+    {
+        offsets_.reserve(items + 1);
+        data_.reserve(bytes);
+    }
+
+    inline void push_back(const uint8_t* data, size_t len)
+    {
+        if (owner_)
+            copy_views();
+        data_.insert(data_.end(), data, data + len);
+        offsets_.push_back(data_.size());
+    }
+
+    inline void push_back(const std::string& s) { push_back((const uint8_t*)s.data(), s.size()); }
+    inline void push_back(const bytes_view& b)  { push_back(b.data, b.size); }
+
+    /// Decode an avro array of bytes (or of string if as_string) into the
+    /// arena, replacing its contents.
+    void decode(avro::Decoder& d, bool as_string);
+
+    /// Decode an avro array of bytes or string as views into buffer, which
+    /// the decoder must be reading and which the arena keeps alive; the item
+    /// data is not copied.
+    void decode_views(AvroBufferDecoder& d, const buffer_ptr& buffer);
+
+    /// Encode the arena as an avro array of bytes (or of string if as_string).
+    void encode(avro::Encoder& e, bool as_string) const;
+
+    // ----------------------------------------------------------------------
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef bytes_view                value_type;
+        typedef ptrdiff_t                 difference_type;
+        typedef const bytes_view*         pointer;
+        typedef bytes_view                reference;
+
+        const_iterator() : arena_(NULL), i_(0) { }
+        const_iterator(const AvroArena* arena, size_t i) : arena_(arena), i_(i) { }
+
+        inline bytes_view operator*() const { return (*arena_)[i_]; }
+        inline const_iterator& operator++() { ++i_; return *this; }
+        inline const_iterator operator++(int) { const_iterator it(*this); ++i_; return it; }
+        inline bool operator==(const const_iterator& other) const { return i_ == other.i_; }
+        inline bool operator!=(const const_iterator& other) const { return i_ != other.i_; }
+
+    private:
+        const AvroArena* arena_;
+        size_t           i_;
+    };
+
+    inline const_iterator begin() const { return const_iterator(this, 0); }
+    inline const_iterator end() const   { return const_iterator(this, size()); }
+
+private:
+
+    std::vector<uint8_t>    data_;
+    std::vector<size_t>     offsets_; ///< size()+1 offsets into data_, the last is data_.size()
+
+    buffer_ptr              owner_;   ///< The buffer views_ point into, if any
+    std::vector<bytes_view> views_;
+
+    /// Copy the viewed items into the arena's own buffer.
+    void copy_views();
+};
+
+} // end namespace gpudb
+
+#endif
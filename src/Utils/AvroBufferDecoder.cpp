@@ -0,0 +1,221 @@
+#include "AvroBufferDecoder.h"
+
+#include <avro/Exception.hh>
+
+
+namespace gpudb
+{
+
+void AvroBufferDecoder::init(avro::InputStream& is)
+{
+    in_ = &is;
+    p_ = end_ = NULL;
+}
+
+void AvroBufferDecoder::drain()
+{
+    if ((in_ != NULL) && (p_ != end_))
+        in_->backup((size_t)(end_ - p_));
+    p_ = end_;
+}
+
+bool AvroBufferDecoder::next_chunk()
+{
+    const uint8_t* data;
+    size_t len;
+    if ((in_ == NULL) || !in_->next(&data, &len))
+        return false;
+
+    p_ = data;
+    end_ = data + len;
+    return true;
+}
+
+void AvroBufferDecoder::read_slow(uint8_t* out, size_t n)
+{
+    while (n > 0)
+    {
+        if ((p_ == end_) && !next_chunk())
+            throw avro::Exception("EOF reached");
+
+        size_t len = std::min(n, (size_t)(end_ - p_));
+        memcpy(out, p_, len);
+        p_ += len;
+        out += len;
+        n -= len;
+    }
+}
+
+void AvroBufferDecoder::skip(size_t n)
+{
+    while (n > 0)
+    {
+        if ((p_ == end_) && !next_chunk())
+            throw avro::Exception("EOF reached");
+
+        size_t len = std::min(n, (size_t)(end_ - p_));
+        p_ += len;
+        n -= len;
+    }
+}
+
+int64_t AvroBufferDecoder::decode_long_slow()
+{
+    // One byte at a time since the varint may span chunks
+    uint64_t n = 0;
+    for (int shift = 0; shift < 70; shift += 7)
+    {
+        uint8_t b;
+        read(&b, 1);
+        n |= (uint64_t)(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return AvroVarint::zigzag_decode(n);
+    }
+    throw avro::Exception("Invalid Avro varint");
+}
+
+bool AvroBufferDecoder::decodeBool()
+{
+    uint8_t b;
+    read(&b, 1);
+    if (b > 1)
+        throw avro::Exception("Invalid value for bool");
+    return b == 1;
+}
+
+int32_t AvroBufferDecoder::decodeInt()
+{
+    int64_t v = decodeLong();
+    if ((v < -2147483647LL - 1) || (v > 2147483647LL))
+        throw avro::Exception("Value out of range for Avro int");
+    return (int32_t)v;
+}
+
+size_t AvroBufferDecoder::decode_size()
+{
+    int64_t len = decodeLong();
+    if (len < 0)
+        throw avro::Exception("Cannot have negative length");
+    return (size_t)len;
+}
+
+void AvroBufferDecoder::decodeString(std::string& value)
+{
+    size_t len = decode_size();
+    if ((size_t)(end_ - p_) >= len)
+    {
+        value.assign((const char*)p_, len);
+        p_ += len;
+    }
+    else
+    {
+        value.resize(len);
+        read_slow((uint8_t*)&value[0], len);
+    }
+}
+
+void AvroBufferDecoder::decodeBytes(std::vector<uint8_t>& value)
+{
+    size_t len = decode_size();
+    if ((size_t)(end_ - p_) >= len)
+    {
+        value.assign(p_, p_ + len);
+        p_ += len;
+    }
+    else
+    {
+        value.resize(len);
+        read_slow(&value[0], len);
+    }
+}
+
+void AvroBufferDecoder::append_decoded_bytes(std::vector<uint8_t>& out)
+{
+    size_t len = decode_size();
+    if ((size_t)(end_ - p_) >= len)
+    {
+        out.insert(out.end(), p_, p_ + len);
+        p_ += len;
+    }
+    else
+    {
+        size_t pos = out.size();
+        out.resize(pos + len);
+        read_slow(&out[pos], len);
+    }
+}
+
+bytes_view AvroBufferDecoder::decode_bytes_view()
+{
+    size_t len = decode_size();
+    if ((size_t)(end_ - p_) < len)
+        throw avro::Exception("Bytes do not lie in the current chunk");
+
+    bytes_view view(p_, len);
+    p_ += len;
+    return view;
+}
+
+bytes_view AvroBufferDecoder::decode_bytes_view(std::vector<uint8_t>& scratch)
+{
+    size_t len = decode_size();
+    if ((size_t)(end_ - p_) >= len)
+    {
+        bytes_view view(p_, len);
+        p_ += len;
+        return view;
+    }
+
+    scratch.resize(len);
+    read_slow(&scratch[0], len); // len > 0, as it spans chunks
+    return bytes_view(&scratch[0], len);
+}
+
+bool AvroBufferDecoder::peek_bytes_size(size_t n, size_t& total) const
+{
+    const uint8_t* p = p_;
+    total = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        int64_t len;
+        if (!AvroVarint::decode(p, end_, len) || (len < 0) || ((uint64_t)len > (uint64_t)(end_ - p)))
+            return false;
+        p += len;
+        total += (size_t)len;
+    }
+    return true;
+}
+
+void AvroBufferDecoder::decodeFixed(size_t n, std::vector<uint8_t>& value)
+{
+    value.resize(n);
+    if (n > 0)
+        read(&value[0], n);
+}
+
+size_t AvroBufferDecoder::decode_item_count()
+{
+    // A negative count is followed by the size of the block in bytes
+    int64_t count = decodeLong();
+    if (count < 0)
+    {
+        decodeLong();
+        count = -count;
+    }
+    return (size_t)count;
+}
+
+size_t AvroBufferDecoder::skip_blocks()
+{
+    // Skip the blocks whose size in bytes is known, the caller skips the
+    // items of the first block that does not give its size
+    for (;;)
+    {
+        int64_t count = decodeLong();
+        if (count >= 0)
+            return (size_t)count;
+        skip(decode_size());
+    }
+}
+
+} // end namespace gpudb
@@ -0,0 +1,265 @@
+#ifndef _AVRO_BUFFER_DECODER_H_
+#define _AVRO_BUFFER_DECODER_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <avro/Decoder.hh>
+#include <avro/Encoder.hh>
+#include <avro/Specific.hh>
+#include <avro/Stream.hh>
+
+#include "AvroVarint.h"
+#include "BytesView.h"
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroBufferDecoder An avro binary decoder that reads directly from
+///        contiguous memory rather than pulling bytes through an
+///        avro::InputStream, and decodes arrays of int and long in batches
+///        (see the codec_traits specializations below).
+///
+///        Use init(data, len) for a buffer; init(InputStream&) is supported
+///        and reads the stream a chunk at a time.
+// --------------------------------------------------------------------------
+class AvroBufferDecoder : public avro::Decoder
+{
+public:
+
+    AvroBufferDecoder() : in_(NULL), p_(NULL), end_(NULL) { }
+    AvroBufferDecoder(const uint8_t* data, size_t len) : in_(NULL), p_(data), end_(data + len) { }
+
+    /// Decode from the buffer, which must outlive the decoding.
+    inline void init(const uint8_t* data, size_t len)
+    {
+        in_ = NULL;
+        p_ = data;
+        end_ = data + len;
+    }
+
+    virtual void init(avro::InputStream& is);
+
+    /// Return the unread part of the current chunk to the stream, if any.
+    void drain();
+
+    /// The next byte to be decoded and the end of the current chunk.
+    inline const uint8_t* position() const { return p_; }
+    inline const uint8_t* end() const { return end_; }
+
+    // ----------------------------------------------------------------------
+    // avro::Decoder
+
+    using avro::Decoder::decodeString;
+    using avro::Decoder::decodeBytes;
+
+    virtual void decodeNull() { }
+    virtual bool decodeBool();
+    virtual int32_t decodeInt();
+
+    virtual int64_t decodeLong()
+    {
+        const uint8_t* p = p_;
+        int64_t v;
+        if (!AvroVarint::decode(p, end_, v))
+            return decode_long_slow(); // spans chunks or invalid
+        p_ = p;
+        return v;
+    }
+
+    virtual float decodeFloat()
+    {
+        float v;
+        read((uint8_t*)&v, sizeof(v)); // avro is little endian, as is the host
+        return v;
+    }
+
+    virtual double decodeDouble()
+    {
+        double v;
+        read((uint8_t*)&v, sizeof(v));
+        return v;
+    }
+
+    virtual void decodeString(std::string& value);
+    virtual void skipString() { skip(decode_size()); }
+    virtual void decodeBytes(std::vector<uint8_t>& value);
+    virtual void skipBytes() { skip(decode_size()); }
+    virtual void decodeFixed(size_t n, std::vector<uint8_t>& value);
+    virtual void skipFixed(size_t n) { skip(n); }
+    virtual size_t decodeEnum() { return (size_t)decodeLong(); }
+    virtual size_t arrayStart() { return decode_item_count(); }
+    virtual size_t arrayNext() { return decode_item_count(); }
+    virtual size_t skipArray() { return skip_blocks(); }
+    virtual size_t mapStart() { return decode_item_count(); }
+    virtual size_t mapNext() { return decode_item_count(); }
+    virtual size_t skipMap() { return skip_blocks(); }
+    virtual size_t decodeUnionIndex() { return (size_t)decodeLong(); }
+
+    // ----------------------------------------------------------------------
+
+    /// Decode a bytes or string value and append its data to out, which
+    /// saves the temporary of decodeBytes() when collecting many values.
+    void append_decoded_bytes(std::vector<uint8_t>& out);
+
+    /// Decode a bytes or string value as a view into the input, without
+    /// copying it. Throws if the value does not lie in the current chunk,
+    /// so this is meant for buffers given to init(data, len).
+    bytes_view decode_bytes_view();
+
+    /// Decode a bytes or string value as a view into the input if it lies in
+    /// the current chunk, otherwise as a copy in scratch, e.g. when decoding
+    /// a stream. The view is valid until the next value is decoded.
+    bytes_view decode_bytes_view(std::vector<uint8_t>& scratch);
+
+    /// Find the total data size of the next n bytes or string values without
+    /// decoding them; false if they do not all lie in the current chunk.
+    bool peek_bytes_size(size_t n, size_t& total) const;
+
+    /// Decode an avro array of int or long into the vector, replacing its
+    /// contents, with AvroVarint::decode_array().
+    template <class T>
+    void decode_varint_array(std::vector<T>& values);
+
+private:
+
+    avro::InputStream* in_; ///< The stream the chunks come from, may be NULL
+    const uint8_t*     p_;
+    const uint8_t*     end_;
+
+    /// Get the next chunk from the stream, false if there is none.
+    bool next_chunk();
+
+    /// Copy n bytes to out, throws at the end of the input.
+    inline void read(uint8_t* out, size_t n)
+    {
+        if ((size_t)(end_ - p_) >= n)
+        {
+            memcpy(out, p_, n);
+            p_ += n;
+        }
+        else
+            read_slow(out, n);
+    }
+
+    void    read_slow(uint8_t* out, size_t n);
+    void    skip(size_t n);
+    int64_t decode_long_slow();
+    size_t  decode_size();
+    size_t  decode_item_count();
+    size_t  skip_blocks();
+
+    inline void decode_one(int64_t& v) { v = decodeLong(); }
+    inline void decode_one(int32_t& v) { v = decodeInt(); }
+};
+
+template <class T>
+void AvroBufferDecoder::decode_varint_array(std::vector<T>& values)
+{
+    values.clear();
+    for (size_t n = arrayStart(); n != 0; n = arrayNext())
+    {
+        while (n > 0)
+        {
+            // Every item takes at least a byte, so the block count is only
+            // trusted as far as the input can hold that many items
+            size_t count = std::min(n, std::max((size_t)(end_ - p_), (size_t)1));
+            size_t pos = values.size();
+            values.resize(pos + count);
+
+            size_t done = AvroVarint::decode_array(p_, end_, &values[pos], count);
+            if (done < count)
+            {
+                // The varint spans chunks or is invalid, which decode_one() throws for
+                decode_one(values[pos + done]);
+                count = done + 1;
+                values.resize(pos + count);
+            }
+            n -= count;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------
+/// Codec for arrays (e.g. of string or bytes): the same encoding as the
+/// generic avro::codec_traits<std::vector<T> >, but decoding overwrites the
+/// vector's items in place, so they keep their memory when a vector is
+/// decoded into again, rather than decoding each into a temporary that is
+/// copied in. Room for the items of each block is reserved up front.
+// --------------------------------------------------------------------------
+template <class T>
+struct AvroArrayCodec
+{
+    /// Block counts come from the input, so at most this many items are reserved at once.
+    static const size_t MAX_RESERVED_ITEMS = 1 << 16;
+
+    static void encode(avro::Encoder& e, const std::vector<T>& values)
+    {
+        e.arrayStart();
+        if (!values.empty())
+        {
+            e.setItemCount(values.size());
+            for (typename std::vector<T>::const_iterator it = values.begin(); it != values.end(); ++it)
+            {
+                e.startItem();
+                avro::encode(e, *it);
+            }
+        }
+        e.arrayEnd();
+    }
+
+    static void decode(avro::Decoder& d, std::vector<T>& values)
+    {
+        size_t size = 0;
+        for (size_t n = d.arrayStart(); n != 0; n = d.arrayNext())
+        {
+            if (values.capacity() < size + n)
+                values.reserve(size + std::min(n, (size_t)MAX_RESERVED_ITEMS));
+
+            for (size_t i = 0; i < n; ++i, ++size)
+            {
+                if (size == values.size())
+                    values.resize(size + 1);
+                avro::decode(d, values[size]);
+            }
+        }
+        values.resize(size);
+    }
+};
+
+// --------------------------------------------------------------------------
+/// Codec for arrays of int and long: AvroArrayCodec, decoded in batches
+/// when the decoder is an AvroBufferDecoder.
+// --------------------------------------------------------------------------
+template <class T>
+struct AvroVarintArrayCodec : public AvroArrayCodec<T>
+{
+    static void decode(avro::Decoder& d, std::vector<T>& values)
+    {
+        AvroBufferDecoder* buffer_decoder = dynamic_cast<AvroBufferDecoder*>(&d);
+        if (buffer_decoder != NULL)
+            buffer_decoder->decode_varint_array(values);
+        else
+            AvroArrayCodec<T>::decode(d, values);
+    }
+};
+
+} // end namespace gpudb
+
+
+// Must be seen before any use of avro::codec_traits<std::vector<int64_t> >,
+// <std::vector<int32_t> > and so on, which is why AvroUtils.h includes this header.
+namespace avro
+{
+template <> struct codec_traits<std::vector<int64_t> > : public gpudb::AvroVarintArrayCodec<int64_t> { };
+template <> struct codec_traits<std::vector<int32_t> > : public gpudb::AvroVarintArrayCodec<int32_t> { };
+template <> struct codec_traits<std::vector<std::string> > : public gpudb::AvroArrayCodec<std::string> { };
+template <> struct codec_traits<std::vector<std::vector<uint8_t> > > : public gpudb::AvroArrayCodec<std::vector<uint8_t> > { };
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "AvroChunkPool.h"
+
+#include <mutex>
+#include <vector>
+
+
+namespace gpudb
+{
+
+namespace
+{
+
+const size_t NUM_SIZE_CLASSES = 14; // MIN_CHUNK_SIZE << 13 == MAX_CHUNK_SIZE
+
+// Each class keeps at most this many bytes of free chunks (but at least one).
+const size_t MAX_POOLED_BYTES_PER_CLASS = 16 << 20;
+
+struct size_class
+{
+    std::mutex            mutex;
+    std::vector<uint8_t*> free_chunks;
+};
+
+// Never destroyed, streams in static objects may release chunks at exit.
+inline size_class* size_classes()
+{
+    static size_class* classes = new size_class[NUM_SIZE_CLASSES];
+    return classes;
+}
+
+// The size class of a chunk_size() that is at most MAX_CHUNK_SIZE.
+inline size_t class_index(size_t chunk_size)
+{
+    size_t index = 0;
+    for (size_t size = AvroChunkPool::MIN_CHUNK_SIZE; size < chunk_size; size <<= 1)
+        ++index;
+    return index;
+}
+
+} // end anonymous namespace
+
+
+//static
+size_t AvroChunkPool::chunk_size(size_t size)
+{
+    if (size > MAX_CHUNK_SIZE)
+        return size;
+
+    size_t chunk = MIN_CHUNK_SIZE;
+    while (chunk < size)
+        chunk <<= 1;
+    return chunk;
+}
+
+//static
+uint8_t* AvroChunkPool::allocate(size_t size)
+{
+    size_t chunk = chunk_size(size);
+    if (chunk <= MAX_CHUNK_SIZE)
+    {
+        size_class& sc = size_classes()[class_index(chunk)];
+        std::lock_guard<std::mutex> lock(sc.mutex);
+        if (!sc.free_chunks.empty())
+        {
+            uint8_t* p = sc.free_chunks.back();
+            sc.free_chunks.pop_back();
+            return p;
+        }
+    }
+
+    return new uint8_t[chunk];
+}
+
+//static
+void AvroChunkPool::release(uint8_t* chunk, size_t size)
+{
+    size_t chunk_bytes = chunk_size(size);
+    if (chunk_bytes <= MAX_CHUNK_SIZE)
+    {
+        size_class& sc = size_classes()[class_index(chunk_bytes)];
+        std::lock_guard<std::mutex> lock(sc.mutex);
+        if ((sc.free_chunks.size() + 1) * chunk_bytes <= MAX_POOLED_BYTES_PER_CLASS)
+        {
+            sc.free_chunks.push_back(chunk);
+            return;
+        }
+    }
+
+    delete[] chunk;
+}
+
+//static
+void AvroChunkPool::trim()
+{
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; ++i)
+    {
+        std::vector<uint8_t*> chunks;
+        {
+            std::lock_guard<std::mutex> lock(size_classes()[i].mutex);
+            chunks.swap(size_classes()[i].free_chunks);
+        }
+        for (size_t j = 0; j < chunks.size(); ++j)
+            delete[] chunks[j];
+    }
+}
+
+} // end namespace gpudb
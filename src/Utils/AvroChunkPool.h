@@ -0,0 +1,45 @@
+#ifndef _AVRO_CHUNK_POOL_H_
+#define _AVRO_CHUNK_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroChunkPool A process wide pool of the memory chunks that
+///        AvroMemoryOutputStreams encode into.
+///
+///        Chunks come in power of two size classes; a released chunk is kept
+///        on its class's free list for the next allocation of that class, so
+///        in steady state encoding does not call the allocator. Chunks larger
+///        than the largest class are not pooled. Thread safe.
+// --------------------------------------------------------------------------
+class AvroChunkPool
+{
+    AvroChunkPool();
+
+public:
+
+    static const size_t MIN_CHUNK_SIZE = 512;
+    static const size_t MAX_CHUNK_SIZE = 4 << 20; ///< The largest pooled size class
+
+    /// The size of the chunk allocate() hands out for size bytes, i.e. the
+    /// size class (or size itself if larger than MAX_CHUNK_SIZE).
+    static size_t chunk_size(size_t size);
+
+    /// Get a chunk of chunk_size(size) bytes.
+    static uint8_t* allocate(size_t size);
+
+    /// Return a chunk from allocate(size) to the pool.
+    static void release(uint8_t* chunk, size_t size);
+
+    /// Free all of the pooled chunks.
+    static void trim();
+};
+
+} // end namespace gpudb
+
+#endif
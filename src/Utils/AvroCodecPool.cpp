@@ -0,0 +1,202 @@
+#include "AvroCodecPool.h"
+#include "AvroJsonWriter.h"
+#include "AvroUtils.h"
+
+#include <map>
+#include <vector>
+
+
+namespace gpudb
+{
+
+namespace
+{
+
+// Objects are pooled per thread, so nothing here needs a lock.
+// The lists only grow as deep as conversions nest, which is rarely past one.
+const size_t MAX_POOLED_PER_LIST = 4;
+
+// Json codecs of at most this many schemas are kept.
+const size_t MAX_POOLED_SCHEMAS = 64;
+
+// A stream or buffer holding more than this is freed rather than kept.
+const size_t MAX_POOLED_STREAM_BYTES = 1 << 20;
+
+struct schema_codecs
+{
+    avro::ValidSchema             schema; ///< Keeps the node used as the key alive
+    std::vector<avro::EncoderPtr> json_encoders;
+    std::vector<avro::DecoderPtr> json_decoders;
+};
+
+// The json codecs are keyed by the root node of their schema, schemas
+// interned by AvroUtils share it for as long as they live.
+typedef std::map<const avro::Node*, schema_codecs> map_node_to_codecs;
+
+struct codec_pool
+{
+    std::vector<AvroMemoryOutputStream*> streams;
+    std::vector<std::vector<uint8_t>*>   byte_buffers;
+    std::vector<avro::EncoderPtr>        binary_encoders;
+    map_node_to_codecs                   by_schema;
+
+    ~codec_pool() { clear(); }
+
+    void clear()
+    {
+        for (size_t i = 0; i < streams.size(); ++i)
+            delete streams[i];
+        streams.clear();
+        for (size_t i = 0; i < byte_buffers.size(); ++i)
+            delete byte_buffers[i];
+        byte_buffers.clear();
+        binary_encoders.clear();
+        by_schema.clear();
+    }
+
+    schema_codecs& codecs(const avro::ValidSchema& schema)
+    {
+        const avro::Node* key = schema.root().get();
+        map_node_to_codecs::iterator it = by_schema.find(key);
+        if (it != by_schema.end())
+            return it->second;
+
+        if (by_schema.size() >= MAX_POOLED_SCHEMAS)
+            by_schema.clear();
+
+        schema_codecs& codecs = by_schema[key];
+        codecs.schema = schema;
+        return codecs;
+    }
+};
+
+thread_local codec_pool pool;
+
+template <class T>
+inline T take(std::vector<T>& list)
+{
+    T t = list.back();
+    list.pop_back();
+    return t;
+}
+
+template <class T>
+inline void give_back(std::vector<T>& list, const T& t)
+{
+    if (list.size() < MAX_POOLED_PER_LIST)
+        list.push_back(t);
+}
+
+} // end anonymous namespace
+
+
+//static
+void AvroCodecPool::clear()
+{
+    pool.clear();
+}
+
+// --------------------------------------------------------------------------
+
+AvroCodecPool::OutputStream::OutputStream()
+{
+    if (pool.streams.empty())
+        stream_ = new AvroMemoryOutputStream(AvroMemoryOutputStream::DEFAULT_CHUNK_SIZE);
+    else
+        stream_ = take(pool.streams);
+}
+
+AvroCodecPool::OutputStream::~OutputStream()
+{
+    if ((pool.streams.size() < MAX_POOLED_PER_LIST) &&
+        (stream_->capacity() <= MAX_POOLED_STREAM_BYTES))
+    {
+        stream_->reset(AvroMemoryOutputStream::DEFAULT_CHUNK_SIZE);
+        pool.streams.push_back(stream_);
+    }
+    else
+        delete stream_;
+}
+
+// --------------------------------------------------------------------------
+
+AvroCodecPool::Bytes::Bytes()
+{
+    if (pool.byte_buffers.empty())
+        bytes_ = new std::vector<uint8_t>();
+    else
+        bytes_ = take(pool.byte_buffers);
+}
+
+AvroCodecPool::Bytes::~Bytes()
+{
+    if ((pool.byte_buffers.size() < MAX_POOLED_PER_LIST) &&
+        (bytes_->capacity() <= MAX_POOLED_STREAM_BYTES))
+    {
+        bytes_->clear();
+        pool.byte_buffers.push_back(bytes_);
+    }
+    else
+        delete bytes_;
+}
+
+// --------------------------------------------------------------------------
+
+AvroCodecPool::Encoder::Encoder() : key_(NULL), reusable_(false)
+{
+    if (pool.binary_encoders.empty())
+        encoder_ = avro::binaryEncoder(); // cheap, but still a few allocations
+    else
+        encoder_ = take(pool.binary_encoders);
+}
+
+AvroCodecPool::Encoder::Encoder(const avro::ValidSchema& schema) :
+    schema_(schema), key_(schema.root().get()), reusable_(false)
+{
+    schema_codecs& codecs = pool.codecs(schema);
+    if (codecs.json_encoders.empty())
+    {
+        try
+        {
+            encoder_.reset(new AvroJsonWriter(schema));
+        }
+        catch (const std::exception&)
+        {
+            encoder_ = avro::jsonEncoder(schema); // for what the writer does not support
+        }
+    }
+    else
+        encoder_ = take(codecs.json_encoders);
+}
+
+AvroCodecPool::Encoder::~Encoder()
+{
+    // An encoder that stopped mid-value would carry its state into the next use
+    if (!reusable_)
+        return;
+
+    if (key_ == NULL)
+        give_back(pool.binary_encoders, encoder_);
+    else
+        give_back(pool.codecs(schema_).json_encoders, encoder_);
+}
+
+// --------------------------------------------------------------------------
+
+AvroCodecPool::JsonDecoder::JsonDecoder(const avro::ValidSchema& schema) :
+    schema_(schema), reusable_(false)
+{
+    schema_codecs& codecs = pool.codecs(schema);
+    if (codecs.json_decoders.empty())
+        decoder_ = avro::jsonDecoder(schema);
+    else
+        decoder_ = take(codecs.json_decoders);
+}
+
+AvroCodecPool::JsonDecoder::~JsonDecoder()
+{
+    if (reusable_)
+        give_back(pool.codecs(schema_).json_decoders, decoder_);
+}
+
+} // end namespace gpudb
@@ -0,0 +1,125 @@
+#ifndef _AVRO_CODEC_POOL_H_
+#define _AVRO_CODEC_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <avro/Decoder.hh>
+#include <avro/Encoder.hh>
+#include <avro/Node.hh>
+#include <avro/ValidSchema.hh>
+
+
+namespace gpudb
+{
+
+class AvroMemoryOutputStream;
+
+// --------------------------------------------------------------------------
+/// @class AvroCodecPool Per thread pools of the avro encoders, json decoders
+///        and memory output streams used by AvroUtils, so that converting a
+///        small object does not cost more in setting up than in encoding.
+///
+///        Each is leased for the lifetime of one of the nested classes and
+///        handed back to the calling thread's pool when the lease ends. An
+///        encoder or decoder is only reused if release() was called, i.e. it
+///        finished a whole value; after an exception it is dropped instead.
+// --------------------------------------------------------------------------
+class AvroCodecPool
+{
+    AvroCodecPool();
+
+public:
+
+    /// Free the calling thread's pooled objects.
+    static void clear();
+
+    // ----------------------------------------------------------------------
+
+    /// An empty AvroMemoryOutputStream.
+    class OutputStream
+    {
+    public:
+        OutputStream();
+        ~OutputStream();
+
+        inline AvroMemoryOutputStream& operator*() const  { return *stream_; }
+        inline AvroMemoryOutputStream* operator->() const { return stream_; }
+
+    private:
+        AvroMemoryOutputStream* stream_;
+
+        OutputStream(const OutputStream&);
+        OutputStream& operator=(const OutputStream&);
+    };
+
+    /// An empty byte buffer, e.g. for json transcoded to binary.
+    class Bytes
+    {
+    public:
+        Bytes();
+        ~Bytes();
+
+        inline std::vector<uint8_t>& operator*() const  { return *bytes_; }
+        inline std::vector<uint8_t>* operator->() const { return bytes_; }
+
+    private:
+        std::vector<uint8_t>* bytes_;
+
+        Bytes(const Bytes&);
+        Bytes& operator=(const Bytes&);
+    };
+
+    /// An avro::binaryEncoder() or a json encoder for the schema, an
+    /// AvroJsonWriter where it supports the schema.
+    class Encoder
+    {
+    public:
+        Encoder();
+        explicit Encoder(const avro::ValidSchema& schema);
+        ~Encoder();
+
+        inline avro::Encoder& operator*() const  { return *encoder_; }
+        inline avro::Encoder* operator->() const { return encoder_.get(); }
+        inline const avro::EncoderPtr& ptr() const { return encoder_; }
+
+        /// Let the encoder be reused, call after its flush().
+        inline void release() { reusable_ = true; }
+
+    private:
+        avro::ValidSchema schema_; ///< Keeps the key alive, unset for binary
+        const avro::Node* key_;
+        avro::EncoderPtr  encoder_;
+        bool              reusable_;
+
+        Encoder(const Encoder&);
+        Encoder& operator=(const Encoder&);
+    };
+
+    /// An avro::jsonDecoder(schema).
+    class JsonDecoder
+    {
+    public:
+        explicit JsonDecoder(const avro::ValidSchema& schema);
+        ~JsonDecoder();
+
+        inline avro::Decoder& operator*() const  { return *decoder_; }
+        inline avro::Decoder* operator->() const { return decoder_.get(); }
+
+        /// Let the decoder be reused, call after decoding a whole value.
+        inline void release() { reusable_ = true; }
+
+    private:
+        avro::ValidSchema schema_;
+        avro::DecoderPtr  decoder_;
+        bool              reusable_;
+
+        JsonDecoder(const JsonDecoder&);
+        JsonDecoder& operator=(const JsonDecoder&);
+    };
+};
+
+} // end namespace gpudb
+
+#endif
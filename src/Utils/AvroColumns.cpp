@@ -0,0 +1,145 @@
+#include "AvroColumns.h"
+#include "AvroVarint.h"
+
+#include <string.h>
+
+#include <avro/Node.hh>
+#include <avro/Types.hh>
+
+
+namespace gpudb
+{
+
+bool AvroColumns::matches(const avro::ValidSchema& schema) const
+{
+    const avro::NodePtr& root = schema.root();
+    if ((root->type() != avro::AVRO_RECORD) || (root->leaves() != columns_.size()))
+        return false;
+
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+        avro::Type type = root->leafAt((int)i)->type();
+        bool ok = false;
+
+        switch (columns_[i].type)
+        {
+            case COL_DOUBLE: ok = (type == avro::AVRO_DOUBLE); break;
+            case COL_FLOAT:  ok = (type == avro::AVRO_FLOAT);  break;
+            case COL_INT:    ok = (type == avro::AVRO_INT);    break;
+            case COL_LONG:   ok = (type == avro::AVRO_LONG);   break;
+            case COL_STRING: ok = (type == avro::AVRO_STRING) || (type == avro::AVRO_BYTES); break;
+        }
+
+        // Every row is read from each column
+        if (!ok || ((num_rows_ > 0) && (columns_[i].values == NULL)))
+            return false;
+    }
+
+    return true;
+}
+
+size_t AvroColumns::fixed_row_size() const
+{
+    size_t size = 0;
+    for (size_t c = 0; c < columns_.size(); ++c)
+    {
+        if (columns_[c].type == COL_DOUBLE)
+            size += sizeof(double);
+        else if (columns_[c].type == COL_FLOAT)
+            size += sizeof(float);
+    }
+    return size;
+}
+
+size_t AvroColumns::row_size(size_t fixed_size, size_t i) const
+{
+    size_t size = fixed_size;
+    for (size_t c = 0; c < columns_.size(); ++c)
+    {
+        const column& col = columns_[c];
+        switch (col.type)
+        {
+            case COL_INT:
+                size += AvroVarint::encoded_size(((const int32_t*)col.values)[i]);
+                break;
+            case COL_LONG:
+                size += AvroVarint::encoded_size(((const int64_t*)col.values)[i]);
+                break;
+            case COL_STRING:
+            {
+                size_t len = ((const std::string*)col.values)[i].size();
+                size += AvroVarint::encoded_size((int64_t)len) + len;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return size;
+}
+
+size_t AvroColumns::encoded_array_size() const
+{
+    if (num_rows_ == 0)
+        return 1; // the terminating empty block
+
+    size_t fixed_size = fixed_row_size();
+    size_t size = AvroVarint::encoded_size((int64_t)num_rows_) + 1;
+    for (size_t i = 0; i < num_rows_; ++i)
+    {
+        size_t row = row_size(fixed_size, i);
+        size += AvroVarint::encoded_size((int64_t)row) + row;
+    }
+    return size;
+}
+
+size_t AvroColumns::encode_array(uint8_t* out) const
+{
+    uint8_t* p = out;
+    size_t fixed_size = fixed_row_size();
+
+    // The whole array is written as a single block
+    if (num_rows_ > 0)
+        p += AvroVarint::encode((int64_t)num_rows_, p);
+
+    for (size_t i = 0; i < num_rows_; ++i)
+    {
+        // Each record is an item of bytes, so it is prefixed by its size
+        p += AvroVarint::encode((int64_t)row_size(fixed_size, i), p);
+
+        for (size_t c = 0; c < columns_.size(); ++c)
+        {
+            const column& col = columns_[c];
+            switch (col.type)
+            {
+                case COL_DOUBLE: // avro is little endian, as is the host
+                    memcpy(p, (const double*)col.values + i, sizeof(double));
+                    p += sizeof(double);
+                    break;
+                case COL_FLOAT:
+                    memcpy(p, (const float*)col.values + i, sizeof(float));
+                    p += sizeof(float);
+                    break;
+                case COL_INT:
+                    p += AvroVarint::encode(((const int32_t*)col.values)[i], p);
+                    break;
+                case COL_LONG:
+                    p += AvroVarint::encode(((const int64_t*)col.values)[i], p);
+                    break;
+                case COL_STRING:
+                {
+                    const std::string& s = ((const std::string*)col.values)[i];
+                    p += AvroVarint::encode((int64_t)s.size(), p);
+                    memcpy(p, s.data(), s.size());
+                    p += s.size();
+                    break;
+                }
+            }
+        }
+    }
+
+    *p++ = 0; // end of the array
+    return (size_t)(p - out);
+}
+
+} // end namespace gpudb
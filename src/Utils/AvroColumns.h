@@ -0,0 +1,91 @@
+#ifndef _AVRO_COLUMNS_H_
+#define _AVRO_COLUMNS_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <avro/ValidSchema.hh>
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroColumns A batch of records held as columns (struct of arrays)
+///        that encodes the records straight from the column buffers into
+///        the avro binary encoding, one record after another.
+///
+///        The columns are not copied, so the buffers must outlive the object
+///        and each must hold num_rows() values. Columns are added in the order
+///        of the fields of the record schema they will be encoded with.
+// --------------------------------------------------------------------------
+class AvroColumns
+{
+public:
+
+    explicit AvroColumns(size_t num_rows) : num_rows_(num_rows) { }
+
+    /// Add the next column; double, float, int, long and string/bytes fields
+    /// take double, float, int32_t, int64_t and std::string values.
+    AvroColumns& add(const double* values)      { return add_column(COL_DOUBLE, values); }
+    AvroColumns& add(const float* values)       { return add_column(COL_FLOAT,  values); }
+    AvroColumns& add(const int32_t* values)     { return add_column(COL_INT,    values); }
+    AvroColumns& add(const int64_t* values)     { return add_column(COL_LONG,   values); }
+    AvroColumns& add(const std::string* values) { return add_column(COL_STRING, values); }
+
+    template <class T>
+    inline AvroColumns& add(const std::vector<T>& values) { return add(values.empty() ? (const T*)NULL : &values[0]); }
+
+    inline size_t num_rows() const    { return num_rows_; }
+    inline size_t num_columns() const { return columns_.size(); }
+
+    /// True if the columns match the fields of the record schema in number,
+    /// order and type (see add()).
+    bool matches(const avro::ValidSchema& schema) const;
+
+    /// The size of the binary encoding of the records as an avro array of
+    /// bytes, i.e. as the list of a bulk_add_request.
+    size_t encoded_array_size() const;
+
+    /// Write the records as an avro array of bytes into out, which MUST have
+    /// room for encoded_array_size() bytes, returns the number of bytes written.
+    size_t encode_array(uint8_t* out) const;
+
+private:
+
+    enum column_type
+    {
+        COL_DOUBLE,
+        COL_FLOAT,
+        COL_INT,
+        COL_LONG,
+        COL_STRING
+    };
+
+    struct column
+    {
+        column_type type;
+        const void* values;
+    };
+
+    size_t num_rows_;
+    std::vector<column> columns_;
+
+    inline AvroColumns& add_column(column_type type, const void* values)
+    {
+        column c = { type, values };
+        columns_.push_back(c);
+        return *this;
+    }
+
+    /// The size of the encoding of the fixed width columns of any row.
+    size_t fixed_row_size() const;
+
+    /// The size of the encoding of row i.
+    size_t row_size(size_t fixed_size, size_t i) const;
+};
+
+} // end namespace gpudb
+
+#endif
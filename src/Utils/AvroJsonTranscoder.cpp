@@ -0,0 +1,910 @@
+#include "AvroJsonTranscoder.h"
+#include "AvroVarint.h"
+#include "JsonScanner.h"
+
+#include <float.h>
+#include <locale.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+
+#include <avro/Node.hh>
+#include <avro/NodeImpl.hh>
+#include <avro/Types.hh>
+
+
+namespace gpudb
+{
+
+struct AvroJsonTranscoder::context
+{
+    const char* p;
+    const char* end;
+    std::vector<uint8_t>& out;
+
+    context(const char* json, size_t len, std::vector<uint8_t>& bytes) :
+        p(json), end(json + len), out(bytes) { }
+};
+
+
+namespace
+{
+
+// Exact powers of ten representable by a double, for the fast number path.
+const double POW10[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                         1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                         1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+// Records with more fields than this use a heap buffer for out of order fields.
+const size_t MAX_STACK_FIELDS = 64;
+
+inline bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+inline const char* skip_ws(const char* p, const char* end)
+{
+    return JsonScanner::skip_ws(p, end);
+}
+
+inline bool match_literal(const char*& p, const char* end, const char* lit, size_t lit_len)
+{
+    if ((size_t)(end - p) < lit_len || memcmp(p, lit, lit_len) != 0)
+        return false;
+    p += lit_len;
+    return true;
+}
+
+// Skip the json string whose opening quote is at p.
+// Returns the position after the closing quote or NULL if unterminated.
+const char* skip_string(const char* p, const char* end)
+{
+    for (++p; ; p += 2) // step over the escape and the escaped character
+    {
+        if (p >= end)
+            return NULL;
+        p = JsonScanner::find_quote_or_escape(p, end);
+        if (p == end)
+            return NULL;
+        if (*p == '"')
+            return p + 1;
+    }
+}
+
+// Skip any json value starting at p, returns the position after it or NULL.
+// Nested values are only checked for balanced brackets; a skipped value is
+// always parsed properly when it is transcoded later.
+const char* skip_value(const char* p, const char* end)
+{
+    p = skip_ws(p, end);
+    if (p == end)
+        return NULL;
+
+    if (*p == '"')
+        return skip_string(p, end);
+
+    if (*p == '{' || *p == '[')
+    {
+        int depth = 0;
+        for (;;)
+        {
+            p = JsonScanner::find_structural(p, end);
+            if (p == end)
+                return NULL;
+
+            char c = *p;
+            if (c == '"')
+            {
+                p = skip_string(p, end);
+                if (p == NULL)
+                    return NULL;
+                continue;
+            }
+            if (c == '{' || c == '[')
+                ++depth;
+            else if (--depth == 0)
+                return p + 1;
+            ++p;
+        }
+    }
+
+    // number or literal
+    const char* start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && !JsonScanner::is_ws(*p))
+        ++p;
+    return (p == start) ? NULL : p;
+}
+
+// Parse a json integer; fractions and exponents are rejected like avro::jsonDecoder does.
+bool parse_int64(const char*& p, const char* end, int64_t& v)
+{
+    bool neg = false;
+    if (p < end && *p == '-')
+    {
+        neg = true;
+        ++p;
+    }
+    if (p == end || !is_digit(*p))
+        return false;
+
+    const uint64_t limit = neg ? (uint64_t)1 << 63 : ((uint64_t)1 << 63) - 1;
+    uint64_t n = 0;
+
+    // Eight digits at a time can never overflow for the first sixteen digits
+    for (int i = 0; i < 2 && end - p >= 8 && JsonScanner::is_eight_digits(p); ++i, p += 8)
+        n = n * 100000000 + JsonScanner::parse_eight_digits(p);
+
+    while (p < end && is_digit(*p))
+    {
+        uint64_t d = (uint64_t)(*p - '0');
+        if (n > (limit - d) / 10)
+            return false; // overflow
+        n = n * 10 + d;
+        ++p;
+    }
+    if (p < end && (*p == '.' || *p == 'e' || *p == 'E'))
+        return false;
+
+    v = neg ? (int64_t)(0 - n) : (int64_t)n;
+    return true;
+}
+
+// Parse a json number into a double.
+// Numbers with at most 15 significant digits and a small exponent are exact
+// with one multiplication or division; everything else goes through strtod.
+bool parse_double(const char*& p, const char* end, double& v)
+{
+    const char* start = p;
+    bool neg = false;
+    if (p < end && *p == '-')
+    {
+        neg = true;
+        ++p;
+    }
+    if (p == end || !is_digit(*p))
+        return false;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exp10 = 0;
+
+    for (; p < end && is_digit(*p); ++p)
+    {
+        // Eight digits at a time once past any leading zeros
+        while (mantissa != 0 && digits <= 11 && end - p >= 8 && JsonScanner::is_eight_digits(p))
+        {
+            mantissa = mantissa * 100000000 + JsonScanner::parse_eight_digits(p);
+            digits += 8;
+            p += 8;
+        }
+        if (p == end || !is_digit(*p))
+            break;
+
+        if (mantissa != 0 || *p != '0')
+        {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            ++digits;
+        }
+        if (digits > 19)
+            break;
+    }
+    if (p < end && *p == '.')
+    {
+        ++p;
+        if (p == end || !is_digit(*p))
+            return false;
+        for (; p < end && is_digit(*p); ++p)
+        {
+            while (mantissa != 0 && digits <= 11 && end - p >= 8 && JsonScanner::is_eight_digits(p))
+            {
+                mantissa = mantissa * 100000000 + JsonScanner::parse_eight_digits(p);
+                digits += 8;
+                exp10 -= 8;
+                p += 8;
+            }
+            if (p == end || !is_digit(*p))
+                break;
+            if (mantissa != 0 || *p != '0')
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                ++digits;
+            }
+            --exp10;
+            if (digits > 19)
+                break;
+        }
+    }
+    if (digits <= 19 && p < end && (*p == 'e' || *p == 'E'))
+    {
+        ++p;
+        bool exp_neg = false;
+        if (p < end && (*p == '+' || *p == '-'))
+            exp_neg = (*p++ == '-');
+        if (p == end || !is_digit(*p))
+            return false;
+        int e = 0;
+        for (; p < end && is_digit(*p); ++p)
+            if (e < 10000)
+                e = e * 10 + (*p - '0');
+        exp10 += exp_neg ? -e : e;
+    }
+
+    // The single rounding argument only holds when doubles are evaluated in
+    // double precision, not e.g. in x87 extended precision.
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+    if (digits <= 15 && exp10 >= -22 && exp10 <= 22)
+    {
+        double d = (double)mantissa;
+        d = (exp10 < 0) ? d / POW10[-exp10] : d * POW10[exp10];
+        v = neg ? -d : d;
+        return true;
+    }
+#endif
+
+    // Slow path: find the end of the number and let strtod round it.
+    p = start;
+    const char* num_end = skip_value(p, end);
+    if (num_end == NULL)
+        return false;
+
+    // strtod reads the decimal point of the LC_NUMERIC locale (e.g. ',' in
+    // de_DE), so json's '.' is handed to it as that
+    std::string num(p, num_end);
+    std::string::size_type dot = num.find('.');
+    const char* point = localeconv()->decimal_point;
+    if (dot != std::string::npos && strcmp(point, ".") != 0)
+        num.replace(dot, 1, point);
+    char* parsed_end = NULL;
+    v = strtod(num.c_str(), &parsed_end);
+    if (parsed_end != num.c_str() + num.size())
+        return false;
+    p = num_end;
+    return true;
+}
+
+inline void append_utf8(uint32_t cp, std::vector<uint8_t>& out)
+{
+    if (cp < 0x80)
+        out.push_back((uint8_t)cp);
+    else if (cp < 0x800)
+    {
+        out.push_back((uint8_t)(0xC0 | (cp >> 6)));
+        out.push_back((uint8_t)(0x80 | (cp & 0x3F)));
+    }
+    else if (cp < 0x10000)
+    {
+        out.push_back((uint8_t)(0xE0 | (cp >> 12)));
+        out.push_back((uint8_t)(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back((uint8_t)(0x80 | (cp & 0x3F)));
+    }
+    else
+    {
+        out.push_back((uint8_t)(0xF0 | (cp >> 18)));
+        out.push_back((uint8_t)(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back((uint8_t)(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back((uint8_t)(0x80 | (cp & 0x3F)));
+    }
+}
+
+inline bool parse_hex4(const char*& p, const char* end, uint32_t& v)
+{
+    if (end - p < 4)
+        return false;
+    v = 0;
+    for (int i = 0; i < 4; ++i, ++p)
+    {
+        char c = *p;
+        v <<= 4;
+        if (c >= '0' && c <= '9')      v |= (uint32_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (uint32_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (uint32_t)(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+// Parse the json string whose opening quote is at p and append its contents
+// to out: as utf-8 for avro strings, or as one byte per code point for avro
+// bytes and fixed (which the avro json encoding stores as ISO-8859-1).
+bool append_string(const char*& p, const char* end, std::vector<uint8_t>& out, bool latin1)
+{
+    if (p == end || *p != '"')
+        return false;
+    ++p;
+
+    for (;;)
+    {
+        // Copy the run of plain characters in one go
+        const char* run = p;
+        p = latin1 ? JsonScanner::find_quote_escape_or_non_ascii(p, end)
+                   : JsonScanner::find_quote_or_escape(p, end);
+        out.insert(out.end(), (const uint8_t*)run, (const uint8_t*)p);
+
+        if (p == end)
+            return false;
+
+        uint8_t c = (uint8_t)*p;
+        if (c == '"')
+        {
+            ++p;
+            return true;
+        }
+
+        uint32_t cp;
+        if (c == '\\')
+        {
+            if (++p == end)
+                return false;
+            switch (*p++)
+            {
+                case '"':  cp = '"';  break;
+                case '\\': cp = '\\'; break;
+                case '/':  cp = '/';  break;
+                case 'b':  cp = '\b'; break;
+                case 'f':  cp = '\f'; break;
+                case 'n':  cp = '\n'; break;
+                case 'r':  cp = '\r'; break;
+                case 't':  cp = '\t'; break;
+                case 'u':
+                {
+                    if (!parse_hex4(p, end, cp))
+                        return false;
+                    if (cp >= 0xD800 && cp < 0xDC00 && !latin1)
+                    {   // surrogate pair
+                        uint32_t lo;
+                        if (end - p < 6 || p[0] != '\\' || p[1] != 'u')
+                            return false;
+                        p += 2;
+                        if (!parse_hex4(p, end, lo) || lo < 0xDC00 || lo > 0xDFFF)
+                            return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        else
+        {   // non-ascii utf-8 sequence in latin1 mode, only U+0080..U+00FF fit in a byte
+            if ((c & 0xE0) != 0xC0 || end - p < 2 || ((uint8_t)p[1] & 0xC0) != 0x80)
+                return false;
+            cp = ((uint32_t)(c & 0x1F) << 6) | ((uint8_t)p[1] & 0x3F);
+            p += 2;
+        }
+
+        if (latin1)
+        {
+            if (cp > 0xFF)
+                return false;
+            out.push_back((uint8_t)cp);
+        }
+        else
+            append_utf8(cp, out);
+    }
+}
+
+// Reserve room for a varint prefix (a length or a block count) whose value is
+// not known yet, returns the position of the prefix.
+inline size_t begin_prefix(std::vector<uint8_t>& out, size_t reserved)
+{
+    size_t pos = out.size();
+    out.resize(pos + reserved);
+    return pos;
+}
+
+// Write the varint prefix reserved by begin_prefix(), moving the data that
+// follows it if the varint needs more or fewer bytes than were reserved.
+inline void end_prefix(std::vector<uint8_t>& out, size_t pos, size_t reserved, int64_t value)
+{
+    uint8_t buf[AvroVarint::MAX_ENCODED_SIZE];
+    size_t n = AvroVarint::encode(value, buf);
+    if (n > reserved)
+        out.insert(out.begin() + pos + reserved, n - reserved, 0);
+    else if (n < reserved)
+        out.erase(out.begin() + pos + n, out.begin() + pos + reserved);
+    memcpy(&out[pos], buf, n);
+}
+
+// Get the raw text of a json string without escapes (field names, enum
+// symbols and union branch names), p must be at the opening quote.
+inline bool parse_name(const char*& p, const char* end, const char*& name, size_t& len)
+{
+    if (p == end || *p != '"')
+        return false;
+    name = ++p;
+    p = JsonScanner::find_quote_or_escape(p, end);
+    if (p == end || *p != '"')
+        return false; // unterminated, or escaped which names never are
+    len = p - name;
+    ++p;
+    return true;
+}
+
+inline bool find_name(const std::vector<std::string>& names, size_t hint,
+                      const char* name, size_t len, size_t& idx)
+{
+    if (hint < names.size() && names[hint].size() == len && memcmp(names[hint].data(), name, len) == 0)
+    {
+        idx = hint;
+        return true;
+    }
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        if (names[i].size() == len && memcmp(names[i].data(), name, len) == 0)
+        {
+            idx = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* branch_name(const avro::NodePtr& n)
+{
+    switch (n->type())
+    {
+        case avro::AVRO_NULL:   return "null";
+        case avro::AVRO_BOOL:   return "boolean";
+        case avro::AVRO_INT:    return "int";
+        case avro::AVRO_LONG:   return "long";
+        case avro::AVRO_FLOAT:  return "float";
+        case avro::AVRO_DOUBLE: return "double";
+        case avro::AVRO_STRING: return "string";
+        case avro::AVRO_BYTES:  return "bytes";
+        case avro::AVRO_ARRAY:  return "array";
+        case avro::AVRO_MAP:    return "map";
+        default:                return NULL; // named type
+    }
+}
+
+} // end anonymous namespace
+
+
+AvroJsonTranscoder::AvroJsonTranscoder(const avro::ValidSchema& schema)
+{
+    std::vector<std::pair<const avro::Node*, size_t> > named;
+    compile(schema.root(), named);
+}
+
+
+// Compile the schema node (and its children) into nodes_, returns its index.
+size_t AvroJsonTranscoder::compile(const avro::NodePtr& schema_node,
+                                   std::vector<std::pair<const avro::Node*, size_t> >& named)
+{
+    avro::NodePtr n = (schema_node->type() == avro::AVRO_SYMBOLIC) ? avro::resolveSymbol(schema_node) : schema_node;
+
+    // Named types may be referenced more than once, or recursively
+    for (size_t i = 0; i < named.size(); ++i)
+    {
+        if (named[i].first == n.get())
+            return named[i].second;
+    }
+
+    size_t idx = nodes_.size();
+    nodes_.push_back(node());
+    nodes_[idx].type = n->type();
+    nodes_[idx].fixed_size = 0;
+
+    switch (n->type())
+    {
+        case avro::AVRO_NULL:
+        case avro::AVRO_BOOL:
+        case avro::AVRO_INT:
+        case avro::AVRO_LONG:
+        case avro::AVRO_FLOAT:
+        case avro::AVRO_DOUBLE:
+        case avro::AVRO_STRING:
+        case avro::AVRO_BYTES:
+            break;
+
+        case avro::AVRO_FIXED:
+            named.push_back(std::make_pair(n.get(), idx));
+            nodes_[idx].fixed_size = n->fixedSize();
+            break;
+
+        case avro::AVRO_ENUM:
+            named.push_back(std::make_pair(n.get(), idx));
+            for (size_t i = 0; i < n->names(); ++i)
+                nodes_[idx].names.push_back(n->nameAt(i));
+            break;
+
+        case avro::AVRO_RECORD:
+        {
+            named.push_back(std::make_pair(n.get(), idx));
+            for (size_t i = 0; i < n->leaves(); ++i)
+            {
+                size_t child = compile(n->leafAt(i), named);
+                nodes_[idx].children.push_back(child); // compile() may have grown nodes_
+                nodes_[idx].names.push_back(n->nameAt(i));
+            }
+            break;
+        }
+
+        case avro::AVRO_ARRAY:
+        {
+            size_t child = compile(n->leafAt(0), named);
+            nodes_[idx].children.push_back(child);
+            break;
+        }
+
+        case avro::AVRO_MAP:
+        {
+            size_t child = compile(n->leafAt(1), named);
+            nodes_[idx].children.push_back(child);
+            break;
+        }
+
+        case avro::AVRO_UNION:
+        {
+            for (size_t i = 0; i < n->leaves(); ++i)
+            {
+                avro::NodePtr branch = n->leafAt(i);
+                if (branch->type() == avro::AVRO_SYMBOLIC)
+                    branch = avro::resolveSymbol(branch);
+                const char* name = branch_name(branch);
+
+                size_t child = compile(branch, named);
+                nodes_[idx].children.push_back(child);
+                nodes_[idx].names.push_back(name ? std::string(name) : branch->name().fullname());
+            }
+            break;
+        }
+
+        default:
+            throw std::runtime_error("AvroJsonTranscoder: unsupported avro type in schema");
+    }
+
+    return idx;
+}
+
+
+bool AvroJsonTranscoder::transcode(const char* json, size_t len, std::vector<uint8_t>& bytes) const
+{
+    bytes.clear();
+    bytes.reserve(len); // the binary encoding is almost always smaller than the json
+
+    context ctx(json, len, bytes);
+    if (!transcode_value(ctx, 0))
+        return false;
+
+    // Only whitespace may follow the object
+    return skip_ws(ctx.p, ctx.end) == ctx.end;
+}
+
+
+bool AvroJsonTranscoder::transcode_value(context& ctx, size_t node_idx) const
+{
+    const node& n = nodes_[node_idx];
+    std::vector<uint8_t>& out = ctx.out;
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+
+    switch (n.type)
+    {
+        case avro::AVRO_NULL:
+            return match_literal(ctx.p, ctx.end, "null", 4);
+
+        case avro::AVRO_BOOL:
+            if (match_literal(ctx.p, ctx.end, "true", 4))
+                out.push_back(1);
+            else if (match_literal(ctx.p, ctx.end, "false", 5))
+                out.push_back(0);
+            else
+                return false;
+            return true;
+
+        case avro::AVRO_INT:
+        case avro::AVRO_LONG:
+        {
+            int64_t v;
+            if (!parse_int64(ctx.p, ctx.end, v))
+                return false;
+            if (n.type == avro::AVRO_INT && (v < INT32_MIN || v > INT32_MAX))
+                return false;
+            AvroVarint::append(v, out);
+            return true;
+        }
+
+        case avro::AVRO_FLOAT:
+        {
+            double d;
+            if (!parse_double(ctx.p, ctx.end, d))
+                return false;
+            float f = (float)d;
+            const uint8_t* b = (const uint8_t*)&f; // avro is little endian, as is the host
+            out.insert(out.end(), b, b + sizeof(f));
+            return true;
+        }
+
+        case avro::AVRO_DOUBLE:
+        {
+            double d;
+            if (!parse_double(ctx.p, ctx.end, d))
+                return false;
+            const uint8_t* b = (const uint8_t*)&d;
+            out.insert(out.end(), b, b + sizeof(d));
+            return true;
+        }
+
+        case avro::AVRO_STRING:
+        case avro::AVRO_BYTES:
+        {
+            // The decoded length is at most the raw length, so reserving the
+            // raw length's varint size avoids moving the data afterwards
+            // except for strings with escapes right at a varint size boundary.
+            const char* str_end = (ctx.p < ctx.end && *ctx.p == '"') ? skip_string(ctx.p, ctx.end) : NULL;
+            if (str_end == NULL)
+                return false;
+            size_t reserved = AvroVarint::encoded_size(str_end - ctx.p - 2);
+            size_t pos = begin_prefix(out, reserved);
+            if (!append_string(ctx.p, ctx.end, out, n.type == avro::AVRO_BYTES))
+                return false;
+            end_prefix(out, pos, reserved, out.size() - pos - reserved);
+            return true;
+        }
+
+        case avro::AVRO_FIXED:
+        {
+            size_t pos = out.size();
+            if (!append_string(ctx.p, ctx.end, out, true))
+                return false;
+            return (out.size() - pos) == n.fixed_size;
+        }
+
+        case avro::AVRO_ENUM:
+        {
+            const char* name;
+            size_t len, idx;
+            if (!parse_name(ctx.p, ctx.end, name, len) || !find_name(n.names, 0, name, len, idx))
+                return false;
+            AvroVarint::append((int64_t)idx, out);
+            return true;
+        }
+
+        case avro::AVRO_RECORD:
+            return transcode_record(ctx, n);
+
+        case avro::AVRO_ARRAY:
+            return transcode_array(ctx, n);
+
+        case avro::AVRO_MAP:
+            return transcode_map(ctx, n);
+
+        case avro::AVRO_UNION:
+            return transcode_union(ctx, n);
+
+        default:
+            return false;
+    }
+}
+
+
+// Fields are transcoded as soon as they can be, i.e. when they arrive in
+// schema order; fields that arrive early are skipped and their position
+// remembered until all the fields before them have been written.
+bool AvroJsonTranscoder::transcode_record(context& ctx, const node& n) const
+{
+    if (ctx.p == ctx.end || *ctx.p != '{')
+        return false;
+    ++ctx.p;
+
+    const size_t num_fields = n.children.size();
+
+    const char* stack_starts[MAX_STACK_FIELDS];
+    std::vector<const char*> heap_starts;
+    const char** starts = stack_starts;
+    if (num_fields > MAX_STACK_FIELDS)
+    {
+        heap_starts.resize(num_fields);
+        starts = &heap_starts[0];
+    }
+    for (size_t i = 0; i < num_fields; ++i)
+        starts[i] = NULL;
+
+    size_t expected = 0; // the next field to write
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+    if (ctx.p < ctx.end && *ctx.p == '}')
+    {
+        ++ctx.p;
+        return num_fields == 0;
+    }
+
+    for (;;)
+    {
+        const char* name;
+        size_t len, idx;
+
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        if (!parse_name(ctx.p, ctx.end, name, len) || !find_name(n.names, expected, name, len, idx))
+            return false;
+
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        if (ctx.p == ctx.end || *ctx.p != ':')
+            return false;
+        ++ctx.p;
+
+        if (idx == expected)
+        {
+            if (!transcode_value(ctx, n.children[idx]))
+                return false;
+            ++expected;
+
+            // Now write any fields that arrived early and are next in line
+            while (expected < num_fields && starts[expected] != NULL)
+            {
+                const char* resume = ctx.p;
+                ctx.p = starts[expected];
+                if (!transcode_value(ctx, n.children[expected]))
+                    return false;
+                ctx.p = resume;
+                ++expected;
+            }
+        }
+        else if (idx > expected && starts[idx] == NULL)
+        {
+            starts[idx] = ctx.p;
+            ctx.p = skip_value(ctx.p, ctx.end);
+            if (ctx.p == NULL)
+                return false;
+        }
+        else
+            return false; // duplicate field
+
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        if (ctx.p == ctx.end)
+            return false;
+        if (*ctx.p == ',')
+        {
+            ++ctx.p;
+            continue;
+        }
+        if (*ctx.p != '}')
+            return false;
+        ++ctx.p;
+        break;
+    }
+
+    // Missing fields (i.e. defaults) are left to the validating path
+    return expected == num_fields;
+}
+
+
+bool AvroJsonTranscoder::transcode_array(context& ctx, const node& n) const
+{
+    if (ctx.p == ctx.end || *ctx.p != '[')
+        return false;
+    ++ctx.p;
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+    if (ctx.p < ctx.end && *ctx.p == ']')
+    {
+        ++ctx.p;
+        ctx.out.push_back(0); // empty array
+        return true;
+    }
+
+    // Write all the items as one block
+    size_t pos = begin_prefix(ctx.out, 1);
+    int64_t count = 0;
+    for (;;)
+    {
+        if (!transcode_value(ctx, n.children[0]))
+            return false;
+        ++count;
+
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        if (ctx.p == ctx.end)
+            return false;
+        if (*ctx.p == ',')
+        {
+            ++ctx.p;
+            continue;
+        }
+        if (*ctx.p != ']')
+            return false;
+        ++ctx.p;
+        break;
+    }
+    end_prefix(ctx.out, pos, 1, count);
+    ctx.out.push_back(0); // end of blocks
+    return true;
+}
+
+
+bool AvroJsonTranscoder::transcode_map(context& ctx, const node& n) const
+{
+    if (ctx.p == ctx.end || *ctx.p != '{')
+        return false;
+    ++ctx.p;
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+    if (ctx.p < ctx.end && *ctx.p == '}')
+    {
+        ++ctx.p;
+        ctx.out.push_back(0); // empty map
+        return true;
+    }
+
+    // Write all the entries as one block
+    size_t pos = begin_prefix(ctx.out, 1);
+    int64_t count = 0;
+    for (;;)
+    {
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        const char* key_end = (ctx.p < ctx.end && *ctx.p == '"') ? skip_string(ctx.p, ctx.end) : NULL;
+        if (key_end == NULL)
+            return false;
+        size_t reserved = AvroVarint::encoded_size(key_end - ctx.p - 2);
+        size_t key_pos = begin_prefix(ctx.out, reserved);
+        if (!append_string(ctx.p, ctx.end, ctx.out, false))
+            return false;
+        end_prefix(ctx.out, key_pos, reserved, ctx.out.size() - key_pos - reserved);
+
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        if (ctx.p == ctx.end || *ctx.p != ':')
+            return false;
+        ++ctx.p;
+
+        if (!transcode_value(ctx, n.children[0]))
+            return false;
+        ++count;
+
+        ctx.p = skip_ws(ctx.p, ctx.end);
+        if (ctx.p == ctx.end)
+            return false;
+        if (*ctx.p == ',')
+        {
+            ++ctx.p;
+            continue;
+        }
+        if (*ctx.p != '}')
+            return false;
+        ++ctx.p;
+        break;
+    }
+    end_prefix(ctx.out, pos, 1, count);
+    ctx.out.push_back(0); // end of blocks
+    return true;
+}
+
+
+// Unions are encoded in json as null or as {"branch name": value}.
+bool AvroJsonTranscoder::transcode_union(context& ctx, const node& n) const
+{
+    size_t idx;
+    const char* name;
+    size_t len;
+
+    if (match_literal(ctx.p, ctx.end, "null", 4))
+    {
+        if (!find_name(n.names, 0, "null", 4, idx))
+            return false;
+        AvroVarint::append((int64_t)idx, ctx.out);
+        return true;
+    }
+
+    if (ctx.p == ctx.end || *ctx.p != '{')
+        return false;
+    ++ctx.p;
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+    if (!parse_name(ctx.p, ctx.end, name, len) || !find_name(n.names, 0, name, len, idx))
+        return false;
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+    if (ctx.p == ctx.end || *ctx.p != ':')
+        return false;
+    ++ctx.p;
+
+    AvroVarint::append((int64_t)idx, ctx.out);
+    if (!transcode_value(ctx, n.children[idx]))
+        return false;
+
+    ctx.p = skip_ws(ctx.p, ctx.end);
+    if (ctx.p == ctx.end || *ctx.p != '}')
+        return false;
+    ++ctx.p;
+    return true;
+}
+
+} // end namespace gpudb
@@ -0,0 +1,68 @@
+#ifndef _AVRO_JSON_TRANSCODER_H_
+#define _AVRO_JSON_TRANSCODER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <avro/ValidSchema.hh>
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroJsonTranscoder Converts the avro json encoding of an object
+///        directly into its avro binary encoding in a single pass over the
+///        json text, without building an intermediate avro::GenericDatum.
+///
+///        The schema is compiled once into a flat table of nodes; a compiled
+///        transcoder is immutable and may be shared between threads.
+///        Record fields may appear in any order in the json text.
+///        Anything the transcoder does not understand (e.g. missing fields)
+///        makes transcode() return false so that the caller can fall back to
+///        the validating avro::jsonDecoder path for the error handling.
+// --------------------------------------------------------------------------
+class AvroJsonTranscoder
+{
+public:
+
+    /// Compile the transcoder for the given schema.
+    /// Throws if the schema uses a type the transcoder does not support.
+    explicit AvroJsonTranscoder(const avro::ValidSchema& schema);
+
+    /// Transcode the json text into bytes, replacing its contents.
+    /// Returns false if the json does not match the schema.
+    bool transcode(const char* json, size_t len, std::vector<uint8_t>& bytes) const;
+
+    inline bool transcode(const std::string& json, std::vector<uint8_t>& bytes) const
+    {
+        return transcode(json.data(), json.size(), bytes);
+    }
+
+private:
+
+    struct node
+    {
+        int type;                         ///< The avro::Type of the node (never AVRO_SYMBOLIC)
+        std::vector<size_t> children;     ///< Record fields, array items, map values or union branches
+        std::vector<std::string> names;   ///< Record field names, enum symbols or union branch names
+        size_t fixed_size;                ///< Size of AVRO_FIXED nodes
+    };
+
+    struct context;
+
+    std::vector<node> nodes_; // nodes_[0] is the root
+
+    size_t compile(const avro::NodePtr& n, std::vector<std::pair<const avro::Node*, size_t> >& named);
+
+    bool transcode_value(context& ctx, size_t node_idx) const;
+    bool transcode_record(context& ctx, const node& n) const;
+    bool transcode_array(context& ctx, const node& n) const;
+    bool transcode_map(context& ctx, const node& n) const;
+    bool transcode_union(context& ctx, const node& n) const;
+};
+
+} // end namespace gpudb
+
+#endif
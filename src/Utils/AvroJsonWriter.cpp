@@ -0,0 +1,618 @@
+#include "AvroJsonWriter.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+#include <avro/Exception.hh>
+#include <avro/Node.hh>
+#include <avro/NodeImpl.hh>
+#include <avro/Types.hh>
+
+
+namespace gpudb
+{
+
+namespace
+{
+
+// begin_value() for a map key rather than a node.
+const size_t MAP_KEY = (size_t)-1;
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+// The escape of each ascii character in a json string, 0 if none, 'u' for \u00XX.
+inline char escape_of(uint8_t c)
+{
+    switch (c)
+    {
+        case '"':  return '"';
+        case '\\': return '\\';
+        case '\b': return 'b';
+        case '\f': return 'f';
+        case '\n': return 'n';
+        case '\r': return 'r';
+        case '\t': return 't';
+        default:   return (c < 0x20) ? 'u' : 0;
+    }
+}
+
+inline void write_escape(uint8_t c, char escape, std::string& out)
+{
+    out.push_back('\\');
+    out.push_back(escape);
+    if (escape == 'u')
+    {
+        out.append("00", 2);
+        out.push_back(HEX_DIGITS[c >> 4]);
+        out.push_back(HEX_DIGITS[c & 0xF]);
+    }
+}
+
+// Append the decimal digits of v.
+inline void write_integer(int64_t v, std::string& out)
+{
+    char buf[24];
+    char* p = buf + sizeof(buf);
+    uint64_t u = (v < 0) ? (0 - (uint64_t)v) : (uint64_t)v;
+    do
+    {
+        *--p = (char)('0' + (u % 10));
+        u /= 10;
+    } while (u != 0);
+    if (v < 0)
+        *--p = '-';
+    out.append(p, buf + sizeof(buf) - p);
+}
+
+// Non finite numbers have no json text; written as strings like java's avro does.
+inline bool write_non_finite(double d, std::string& out)
+{
+    if (d != d)
+        out.append("\"NaN\"", 5);
+    else if (d == HUGE_VAL)
+        out.append("\"Infinity\"", 10);
+    else if (d == -HUGE_VAL)
+        out.append("\"-Infinity\"", 11);
+    else
+        return false;
+    return true;
+}
+
+// Append a number printf formatted in the current LC_NUMERIC locale, with
+// the locale's decimal point (e.g. "," in de_DE, or several bytes) written
+// as json's '.'; %g writes no thousands separators.
+inline void append_number(const char* buf, int len, std::string& out)
+{
+    const char* end = buf + len;
+    for (const char* p = buf; p < end; )
+    {
+        char c = *p;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e')
+        {
+            out.push_back(c);
+            ++p;
+            continue;
+        }
+        out.push_back('.');
+        while (p < end && !(*p >= '0' && *p <= '9') && *p != 'e')
+            ++p;
+    }
+}
+
+const char* branch_name(const avro::NodePtr& n)
+{
+    switch (n->type())
+    {
+        case avro::AVRO_BOOL:   return "boolean";
+        case avro::AVRO_INT:    return "int";
+        case avro::AVRO_LONG:   return "long";
+        case avro::AVRO_FLOAT:  return "float";
+        case avro::AVRO_DOUBLE: return "double";
+        case avro::AVRO_STRING: return "string";
+        case avro::AVRO_BYTES:  return "bytes";
+        case avro::AVRO_ARRAY:  return "array";
+        case avro::AVRO_MAP:    return "map";
+        default:                return NULL; // named type
+    }
+}
+
+void mismatch()
+{
+    throw avro::Exception("AvroJsonWriter: the value does not match the schema");
+}
+
+} // end anonymous namespace
+
+
+AvroJsonWriter::AvroJsonWriter(const avro::ValidSchema& schema) : out_(&buffer_), stream_(NULL)
+{
+    std::vector<std::pair<const avro::Node*, size_t> > named;
+    compile(schema.root(), named);
+}
+
+
+// Compile the schema node (and its children) into nodes_, returns its index.
+size_t AvroJsonWriter::compile(const avro::NodePtr& schema_node,
+                               std::vector<std::pair<const avro::Node*, size_t> >& named)
+{
+    avro::NodePtr n = (schema_node->type() == avro::AVRO_SYMBOLIC) ? avro::resolveSymbol(schema_node) : schema_node;
+
+    // Named types may be referenced more than once, or recursively
+    for (size_t i = 0; i < named.size(); ++i)
+    {
+        if (named[i].first == n.get())
+            return named[i].second;
+    }
+
+    size_t idx = nodes_.size();
+    nodes_.push_back(node());
+    nodes_[idx].type = n->type();
+    nodes_[idx].fixed_size = 0;
+
+    switch (n->type())
+    {
+        case avro::AVRO_NULL:
+        case avro::AVRO_BOOL:
+        case avro::AVRO_INT:
+        case avro::AVRO_LONG:
+        case avro::AVRO_FLOAT:
+        case avro::AVRO_DOUBLE:
+        case avro::AVRO_STRING:
+        case avro::AVRO_BYTES:
+            break;
+
+        case avro::AVRO_FIXED:
+            named.push_back(std::make_pair(n.get(), idx));
+            nodes_[idx].fixed_size = n->fixedSize();
+            break;
+
+        case avro::AVRO_ENUM:
+            named.push_back(std::make_pair(n.get(), idx));
+            for (size_t i = 0; i < n->names(); ++i)
+            {
+                std::string symbol;
+                write_string(n->nameAt(i).data(), n->nameAt(i).size(), symbol);
+                nodes_[idx].names.push_back(symbol);
+            }
+            break;
+
+        case avro::AVRO_RECORD:
+        {
+            named.push_back(std::make_pair(n.get(), idx));
+            if (n->leaves() == 0)
+                throw std::runtime_error("AvroJsonWriter: records without fields are not supported");
+            for (size_t i = 0; i < n->leaves(); ++i)
+            {
+                size_t child = compile(n->leafAt(i), named);
+                nodes_[idx].children.push_back(child); // compile() may have grown nodes_
+
+                std::string prefix;
+                write_string(n->nameAt(i).data(), n->nameAt(i).size(), prefix);
+                prefix.push_back(':');
+                nodes_[idx].names.push_back(prefix);
+            }
+            break;
+        }
+
+        case avro::AVRO_ARRAY:
+        {
+            size_t child = compile(n->leafAt(0), named);
+            nodes_[idx].children.push_back(child);
+            break;
+        }
+
+        case avro::AVRO_MAP:
+        {
+            size_t child = compile(n->leafAt(1), named);
+            nodes_[idx].children.push_back(child);
+            break;
+        }
+
+        case avro::AVRO_UNION:
+        {
+            for (size_t i = 0; i < n->leaves(); ++i)
+            {
+                avro::NodePtr branch = n->leafAt(i);
+                if (branch->type() == avro::AVRO_SYMBOLIC)
+                    branch = avro::resolveSymbol(branch);
+                const char* name = branch_name(branch);
+                std::string full_name = name ? std::string(name) : branch->name().fullname();
+
+                size_t child = compile(branch, named);
+                nodes_[idx].children.push_back(child);
+
+                std::string prefix("{");
+                write_string(full_name.data(), full_name.size(), prefix);
+                prefix.push_back(':');
+                nodes_[idx].names.push_back(prefix);
+            }
+            break;
+        }
+
+        default:
+            throw std::runtime_error("AvroJsonWriter: unsupported avro type in schema");
+    }
+
+    return idx;
+}
+
+
+void AvroJsonWriter::init(std::string& out)
+{
+    out_ = &out;
+    stream_ = NULL;
+    stack_.clear();
+}
+
+void AvroJsonWriter::init(avro::OutputStream& os)
+{
+    buffer_.clear();
+    out_ = &buffer_;
+    stream_ = &os;
+    stack_.clear();
+}
+
+void AvroJsonWriter::flush()
+{
+    if (stream_ == NULL)
+        return;
+
+    // Copy the buffered json into the stream's chunks
+    const char* p = buffer_.data();
+    size_t left = buffer_.size();
+    while (left > 0)
+    {
+        uint8_t* chunk;
+        size_t len;
+        if (!stream_->next(&chunk, &len))
+            throw avro::Exception("AvroJsonWriter: the output stream is full");
+        size_t n = std::min(len, left);
+        memcpy(chunk, p, n);
+        p += n;
+        left -= n;
+        if (n < len)
+            stream_->backup(len - n);
+    }
+    buffer_.clear();
+    stream_->flush();
+}
+
+// --------------------------------------------------------------------------
+
+size_t AvroJsonWriter::begin_value()
+{
+    for (;;)
+    {
+        size_t idx = 0; // the root, when nothing is open
+        if (!stack_.empty())
+        {
+            const frame& f = stack_.back();
+            const node& parent = nodes_[f.node];
+            switch (parent.type)
+            {
+                case avro::AVRO_RECORD: idx = parent.children[f.index]; break;
+                case avro::AVRO_UNION:  idx = parent.children[f.index]; break;
+                case avro::AVRO_MAP:
+                    if (f.in_key)
+                        return MAP_KEY;
+                    idx = parent.children[0];
+                    break;
+                default: // arrays
+                    if (f.index == 0)
+                        mismatch(); // an item without startItem()
+                    idx = parent.children[0];
+                    break;
+            }
+        }
+
+        const node& n = nodes_[idx];
+        if (n.type != avro::AVRO_RECORD)
+            return idx;
+
+        // Records are opened here, their fields are the values encoded
+        out_->push_back('{');
+        out_->append(n.names[0]);
+        frame f = { idx, 0, false };
+        stack_.push_back(f);
+    }
+}
+
+size_t AvroJsonWriter::expect(int type)
+{
+    size_t idx = begin_value();
+    if ((idx == MAP_KEY) || (nodes_[idx].type != type))
+        mismatch();
+    return idx;
+}
+
+void AvroJsonWriter::end_value()
+{
+    while (!stack_.empty())
+    {
+        frame& f = stack_.back();
+        const node& parent = nodes_[f.node];
+
+        switch (parent.type)
+        {
+            case avro::AVRO_RECORD:
+                if (++f.index < parent.children.size())
+                {
+                    out_->push_back(',');
+                    out_->append(parent.names[f.index]);
+                    return;
+                }
+                out_->push_back('}');
+                break;
+
+            case avro::AVRO_UNION:
+                if (nodes_[parent.children[f.index]].type != avro::AVRO_NULL)
+                    out_->push_back('}');
+                break;
+
+            default: // the next item or the end of the array or map follows
+                return;
+        }
+
+        stack_.pop_back(); // the record or union was the value that ended
+    }
+}
+
+// --------------------------------------------------------------------------
+
+void AvroJsonWriter::encodeNull()
+{
+    expect(avro::AVRO_NULL);
+    out_->append("null", 4);
+    end_value();
+}
+
+void AvroJsonWriter::encodeBool(bool b)
+{
+    expect(avro::AVRO_BOOL);
+    if (b)
+        out_->append("true", 4);
+    else
+        out_->append("false", 5);
+    end_value();
+}
+
+void AvroJsonWriter::encodeInt(int32_t i)
+{
+    size_t idx = begin_value();
+    if ((idx == MAP_KEY) || ((nodes_[idx].type != avro::AVRO_INT) && (nodes_[idx].type != avro::AVRO_LONG)))
+        mismatch();
+    write_integer(i, *out_);
+    end_value();
+}
+
+void AvroJsonWriter::encodeLong(int64_t l)
+{
+    expect(avro::AVRO_LONG);
+    write_integer(l, *out_);
+    end_value();
+}
+
+void AvroJsonWriter::encodeFloat(float f)
+{
+    expect(avro::AVRO_FLOAT);
+    write_float(f, *out_);
+    end_value();
+}
+
+void AvroJsonWriter::encodeDouble(double d)
+{
+    expect(avro::AVRO_DOUBLE);
+    write_double(d, *out_);
+    end_value();
+}
+
+void AvroJsonWriter::encodeString(const std::string& s)
+{
+    size_t idx = begin_value();
+    if (idx == MAP_KEY)
+    {
+        write_string(s.data(), s.size(), *out_);
+        out_->push_back(':');
+        stack_.back().in_key = false;
+        return;
+    }
+
+    if (nodes_[idx].type != avro::AVRO_STRING)
+        mismatch();
+    write_string(s.data(), s.size(), *out_);
+    end_value();
+}
+
+// Bytes are written as a string of the code points 0-255.
+void AvroJsonWriter::encodeBytes(const uint8_t* bytes, size_t len)
+{
+    size_t idx = begin_value();
+    if ((idx == MAP_KEY) || ((nodes_[idx].type != avro::AVRO_BYTES) &&
+                             !((nodes_[idx].type == avro::AVRO_FIXED) && (nodes_[idx].fixed_size == len))))
+        mismatch();
+
+    std::string& out = *out_;
+    out.push_back('"');
+    for (size_t i = 0; i < len; ++i)
+    {
+        uint8_t c = bytes[i];
+        char escape = (c < 0x80) ? escape_of(c) : 'u';
+        if (escape)
+            write_escape(c, escape, out);
+        else
+            out.push_back((char)c);
+    }
+    out.push_back('"');
+    end_value();
+}
+
+void AvroJsonWriter::encodeFixed(const uint8_t* bytes, size_t len)
+{
+    encodeBytes(bytes, len); // checks that the node is a fixed of len bytes
+}
+
+void AvroJsonWriter::encodeEnum(size_t e)
+{
+    size_t idx = expect(avro::AVRO_ENUM);
+    if (e >= nodes_[idx].names.size())
+        mismatch();
+    out_->append(nodes_[idx].names[e]);
+    end_value();
+}
+
+void AvroJsonWriter::arrayStart()
+{
+    frame f = { expect(avro::AVRO_ARRAY), 0, false };
+    out_->push_back('[');
+    stack_.push_back(f);
+}
+
+void AvroJsonWriter::arrayEnd()
+{
+    if (stack_.empty() || (nodes_[stack_.back().node].type != avro::AVRO_ARRAY))
+        mismatch();
+    out_->push_back(']');
+    stack_.pop_back();
+    end_value();
+}
+
+void AvroJsonWriter::mapStart()
+{
+    frame f = { expect(avro::AVRO_MAP), 0, false };
+    out_->push_back('{');
+    stack_.push_back(f);
+}
+
+void AvroJsonWriter::mapEnd()
+{
+    if (stack_.empty() || (nodes_[stack_.back().node].type != avro::AVRO_MAP) || stack_.back().in_key)
+        mismatch();
+    out_->push_back('}');
+    stack_.pop_back();
+    end_value();
+}
+
+void AvroJsonWriter::startItem()
+{
+    if (stack_.empty())
+        mismatch();
+    frame& f = stack_.back();
+    int type = nodes_[f.node].type;
+    if ((type != avro::AVRO_ARRAY) && (type != avro::AVRO_MAP))
+        mismatch();
+
+    if (f.index++ > 0)
+        out_->push_back(',');
+    f.in_key = (type == avro::AVRO_MAP);
+}
+
+void AvroJsonWriter::encodeUnionIndex(size_t e)
+{
+    size_t idx = expect(avro::AVRO_UNION);
+    const node& n = nodes_[idx];
+    if (e >= n.children.size())
+        mismatch();
+
+    // null is written as it is, anything else as {"branch":value}
+    if (nodes_[n.children[e]].type != avro::AVRO_NULL)
+        out_->append(n.names[e]);
+    frame f = { idx, e, false };
+    stack_.push_back(f);
+}
+
+// --------------------------------------------------------------------------
+
+//static
+void AvroJsonWriter::write_double(double d, std::string& out)
+{
+    if (write_non_finite(d, out))
+        return;
+
+    // Whole numbers, common in coordinates and counts, skip the formatting
+    if ((d > -1e15) && (d < 1e15) && (d == (double)(int64_t)d) && ((d != 0) || !signbit(d)))
+    {
+        write_integer((int64_t)d, out);
+        return;
+    }
+
+    char buf[32];
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), d); // shortest round trip
+    out.append(buf, r.ptr - buf);
+#else
+    // The fewest significant digits that read back as the same double;
+    // 17 always do. snprintf and strtod agree on the locale's decimal point,
+    // which append_number() then replaces.
+    for (int precision = 15; ; ++precision)
+    {
+        int len = snprintf(buf, sizeof(buf), "%.*g", precision, d);
+        if ((precision == 17) || (strtod(buf, NULL) == d))
+        {
+            append_number(buf, len, out);
+            return;
+        }
+    }
+#endif
+}
+
+//static
+void AvroJsonWriter::write_float(float f, std::string& out)
+{
+    if (write_non_finite(f, out))
+        return;
+
+    if ((f > -1e7f) && (f < 1e7f) && (f == (float)(int32_t)f) && ((f != 0) || !signbit(f)))
+    {
+        write_integer((int32_t)f, out);
+        return;
+    }
+
+    char buf[32];
+#if defined(__cpp_lib_to_chars) && (__cpp_lib_to_chars >= 201611L)
+    std::to_chars_result r = std::to_chars(buf, buf + sizeof(buf), f);
+    out.append(buf, r.ptr - buf);
+#else
+    for (int precision = 6; ; ++precision)
+    {
+        int len = snprintf(buf, sizeof(buf), "%.*g", precision, (double)f);
+        if ((precision == 9) || (strtof(buf, NULL) == f))
+        {
+            append_number(buf, len, out);
+            return;
+        }
+    }
+#endif
+}
+
+//static
+void AvroJsonWriter::write_string(const char* s, size_t len, std::string& out)
+{
+    out.push_back('"');
+
+    // Copy runs of characters that need no escaping in one go
+    const char* run = s;
+    const char* end = s + len;
+    for (const char* p = s; p < end; ++p)
+    {
+        char escape = escape_of((uint8_t)*p);
+        if (escape)
+        {
+            out.append(run, p - run);
+            write_escape((uint8_t)*p, escape, out);
+            run = p + 1;
+        }
+    }
+    out.append(run, end - run);
+
+    out.push_back('"');
+}
+
+} // end namespace gpudb
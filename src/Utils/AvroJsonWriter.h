@@ -0,0 +1,121 @@
+#ifndef _AVRO_JSON_WRITER_H_
+#define _AVRO_JSON_WRITER_H_
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <avro/Encoder.hh>
+#include <avro/Stream.hh>
+#include <avro/ValidSchema.hh>
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroJsonWriter An avro::Encoder that writes the avro json encoding
+///        of a value straight into a string, in place of avro::jsonEncoder().
+///
+///        The schema is compiled once into a flat table of nodes with the
+///        field names, union branches and enum symbols already quoted; the
+///        writer then follows the encode calls through the schema with a
+///        small stack, throwing avro::Exception if they do not match it.
+///        Doubles and floats are written with the shortest text that reads
+///        back as the same number. Bytes and fixed values are written as
+///        strings of code points 0-255, as avro specifies.
+///
+///        The output goes to the string given to init(std::string&), which
+///        can be reused between values, or after flush() to the stream given
+///        to init(OutputStream&).
+// --------------------------------------------------------------------------
+class AvroJsonWriter : public avro::Encoder
+{
+public:
+
+    /// Compile the writer for the given schema.
+    /// Throws if the schema uses a type the writer does not support.
+    explicit AvroJsonWriter(const avro::ValidSchema& schema);
+
+    /// Append the json to out, which must outlive the encoding.
+    void init(std::string& out);
+
+    // ----------------------------------------------------------------------
+    // avro::Encoder
+
+    virtual void init(avro::OutputStream& os);
+    virtual void flush();
+
+    virtual void encodeNull();
+    virtual void encodeBool(bool b);
+    virtual void encodeInt(int32_t i);
+    virtual void encodeLong(int64_t l);
+    virtual void encodeFloat(float f);
+    virtual void encodeDouble(double d);
+    virtual void encodeString(const std::string& s);
+    virtual void encodeBytes(const uint8_t* bytes, size_t len);
+    virtual void encodeFixed(const uint8_t* bytes, size_t len);
+    virtual void encodeEnum(size_t e);
+    virtual void arrayStart();
+    virtual void arrayEnd();
+    virtual void mapStart();
+    virtual void mapEnd();
+    virtual void setItemCount(size_t count) { }
+    virtual void startItem();
+    virtual void encodeUnionIndex(size_t e);
+
+    using avro::Encoder::encodeBytes;
+    using avro::Encoder::encodeFixed;
+
+    // ----------------------------------------------------------------------
+
+    /// Append the shortest json text that reads back as d (non finite
+    /// values are written as the strings "NaN", "Infinity" and "-Infinity").
+    static void write_double(double d, std::string& out);
+    static void write_float(float f, std::string& out);
+
+    /// Append s as a quoted and escaped json string.
+    static void write_string(const char* s, size_t len, std::string& out);
+
+private:
+
+    struct node
+    {
+        int type;                        ///< The avro::Type of the node (never AVRO_SYMBOLIC)
+        std::vector<size_t> children;    ///< Record fields, array items, map values or union branches
+        std::vector<std::string> names;  ///< "field": prefixes, {"branch": prefixes or "symbol"s
+        size_t fixed_size;               ///< Size of AVRO_FIXED nodes
+    };
+
+    /// A record, array, map or union being written.
+    struct frame
+    {
+        size_t node;
+        size_t index;  ///< Record field, items written or union branch
+        bool   in_key; ///< Maps: a key is expected next
+    };
+
+    std::vector<node>  nodes_; // nodes_[0] is the root
+    std::vector<frame> stack_;
+
+    std::string        buffer_; ///< Holds the json when writing to a stream
+    std::string*       out_;
+    avro::OutputStream* stream_;
+
+    size_t compile(const avro::NodePtr& n, std::vector<std::pair<const avro::Node*, size_t> >& named);
+
+    /// Open any records the next value is nested in, returns its node or
+    /// MAP_KEY if it is a map key.
+    size_t begin_value();
+
+    /// Check the next value is of the type, returns its node.
+    size_t expect(int type);
+
+    /// Write the separators and closing brackets that follow a value.
+    void end_value();
+};
+
+} // end namespace gpudb
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef _AVRO_RECORD_H_
+#define _AVRO_RECORD_H_
+
+#include <stdint.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <map>
+
+#include <boost/preprocessor/cat.hpp>
+#include <boost/preprocessor/stringize.hpp>
+#include <boost/preprocessor/control/expr_if.hpp>
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/for_each_i.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
+
+#include <avro/Specific.hh>
+#include <avro/Encoder.hh>
+#include <avro/Decoder.hh>
+
+#include "AvroUtils.h"
+
+// ==========================================================================
+// Declare a user record once and get its avro schema, fingerprint and codec
+// from the preprocessor, e.g.
+//
+//     namespace app {
+//     GPUDB_AVRO_RECORD( point,
+//                        ((double, x))
+//                        ((double, y))
+//                        ((string, OBJECT_ID)) )
+//     }
+//     GPUDB_AVRO_RECORD_CODEC( app::point ) // at global scope
+//
+// The field types are avro type names: boolean, int, long, float, double,
+// string and bytes, or array_<type> and map_<type> of one of those.
+//
+// The schema string is a string literal assembled by the preprocessor (in
+// avro's parsing canonical form) and the codec_traits specialization calls
+// avro::encode()/decode() on each field in turn, so nothing is looked up or
+// interpreted at runtime. With C++14 the fingerprint is constexpr.
+// ==========================================================================
+
+#if __cplusplus >= 201402L
+    #define GPUDB_AVRO_RECORD_CONSTEXPR constexpr
+#else
+    #define GPUDB_AVRO_RECORD_CONSTEXPR
+#endif
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroRecord Helpers for the GPUDB_AVRO_RECORD() macro.
+// --------------------------------------------------------------------------
+class AvroRecord
+{
+    AvroRecord();
+
+public:
+
+    /// The 64-bit Rabin fingerprint (CRC-64-AVRO polynomial) of the given bytes, the
+    /// same value as AvroUtils::fingerprint64(), computed without a table so
+    /// that it can be evaluated at compile time.
+    static GPUDB_AVRO_RECORD_CONSTEXPR uint64_t fingerprint64(const char* data, size_t len)
+    {
+        uint64_t fp = 0xc15d213aa4d7a795ULL;
+        for (size_t i = 0; i < len; ++i)
+        {
+            fp ^= (uint8_t)data[i];
+            for (int bit = 0; bit < 8; ++bit)
+                fp = (fp >> 1) ^ (0xc15d213aa4d7a795ULL & (0 - (fp & 1)));
+        }
+        return fp;
+    }
+};
+
+} // end namespace gpudb
+
+
+// --------------------------------------------------------------------------
+// Avro type name to C++ type and schema json.
+
+#define GPUDB_AVRO_RECORD_TYPE_boolean bool
+#define GPUDB_AVRO_RECORD_TYPE_int     int32_t
+#define GPUDB_AVRO_RECORD_TYPE_long    int64_t
+#define GPUDB_AVRO_RECORD_TYPE_float   float
+#define GPUDB_AVRO_RECORD_TYPE_double  double
+#define GPUDB_AVRO_RECORD_TYPE_string  std::string
+#define GPUDB_AVRO_RECORD_TYPE_bytes   std::vector<uint8_t>
+
+#define GPUDB_AVRO_RECORD_TYPE_array_boolean std::vector<bool>
+#define GPUDB_AVRO_RECORD_TYPE_array_int     std::vector<int32_t>
+#define GPUDB_AVRO_RECORD_TYPE_array_long    std::vector<int64_t>
+#define GPUDB_AVRO_RECORD_TYPE_array_float   std::vector<float>
+#define GPUDB_AVRO_RECORD_TYPE_array_double  std::vector<double>
+#define GPUDB_AVRO_RECORD_TYPE_array_string  std::vector<std::string>
+#define GPUDB_AVRO_RECORD_TYPE_array_bytes   std::vector<std::vector<uint8_t> >
+
+#define GPUDB_AVRO_RECORD_TYPE_map_boolean std::map<std::string, bool>
+#define GPUDB_AVRO_RECORD_TYPE_map_int     std::map<std::string, int32_t>
+#define GPUDB_AVRO_RECORD_TYPE_map_long    std::map<std::string, int64_t>
+#define GPUDB_AVRO_RECORD_TYPE_map_float   std::map<std::string, float>
+#define GPUDB_AVRO_RECORD_TYPE_map_double  std::map<std::string, double>
+#define GPUDB_AVRO_RECORD_TYPE_map_string  std::map<std::string, std::string>
+#define GPUDB_AVRO_RECORD_TYPE_map_bytes   std::map<std::string, std::vector<uint8_t> >
+
+#define GPUDB_AVRO_RECORD_SCHEMA_boolean "\"boolean\""
+#define GPUDB_AVRO_RECORD_SCHEMA_int     "\"int\""
+#define GPUDB_AVRO_RECORD_SCHEMA_long    "\"long\""
+#define GPUDB_AVRO_RECORD_SCHEMA_float   "\"float\""
+#define GPUDB_AVRO_RECORD_SCHEMA_double  "\"double\""
+#define GPUDB_AVRO_RECORD_SCHEMA_string  "\"string\""
+#define GPUDB_AVRO_RECORD_SCHEMA_bytes   "\"bytes\""
+
+#define GPUDB_AVRO_RECORD_SCHEMA_array_boolean "{\"type\":\"array\",\"items\":\"boolean\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_array_int     "{\"type\":\"array\",\"items\":\"int\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_array_long    "{\"type\":\"array\",\"items\":\"long\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_array_float   "{\"type\":\"array\",\"items\":\"float\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_array_double  "{\"type\":\"array\",\"items\":\"double\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_array_string  "{\"type\":\"array\",\"items\":\"string\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_array_bytes   "{\"type\":\"array\",\"items\":\"bytes\"}"
+
+#define GPUDB_AVRO_RECORD_SCHEMA_map_boolean "{\"type\":\"map\",\"values\":\"boolean\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_map_int     "{\"type\":\"map\",\"values\":\"int\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_map_long    "{\"type\":\"map\",\"values\":\"long\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_map_float   "{\"type\":\"map\",\"values\":\"float\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_map_double  "{\"type\":\"map\",\"values\":\"double\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_map_string  "{\"type\":\"map\",\"values\":\"string\"}"
+#define GPUDB_AVRO_RECORD_SCHEMA_map_bytes   "{\"type\":\"map\",\"values\":\"bytes\"}"
+
+// --------------------------------------------------------------------------
+// Per field expansions; each field is an (avro type, name) tuple.
+
+#define GPUDB_AVRO_RECORD_FIELD_TYPE(field) BOOST_PP_CAT(GPUDB_AVRO_RECORD_TYPE_, BOOST_PP_TUPLE_ELEM(2, 0, field))
+#define GPUDB_AVRO_RECORD_FIELD_NAME(field) BOOST_PP_TUPLE_ELEM(2, 1, field)
+
+#define GPUDB_AVRO_RECORD_MEMBER(r, data, field) \
+    GPUDB_AVRO_RECORD_FIELD_TYPE(field) GPUDB_AVRO_RECORD_FIELD_NAME(field);
+
+#define GPUDB_AVRO_RECORD_FIELD_SCHEMA(r, data, i, field) \
+    BOOST_PP_EXPR_IF(i, ",") "{\"name\":\"" BOOST_PP_STRINGIZE(GPUDB_AVRO_RECORD_FIELD_NAME(field)) "\",\"type\":" \
+    BOOST_PP_CAT(GPUDB_AVRO_RECORD_SCHEMA_, BOOST_PP_TUPLE_ELEM(2, 0, field)) "}"
+
+#define GPUDB_AVRO_RECORD_ENCODE(r, data, field) avro::encode(e, GPUDB_AVRO_RECORD_FIELD_NAME(field));
+#define GPUDB_AVRO_RECORD_DECODE(r, data, field) avro::decode(d, GPUDB_AVRO_RECORD_FIELD_NAME(field));
+
+#define GPUDB_AVRO_RECORD_MIN_SIZE(r, data, field) \
+    + ::gpudb::AvroUtils::get_min_binary_encoded_size(GPUDB_AVRO_RECORD_FIELD_NAME(field))
+#define GPUDB_AVRO_RECORD_SIZE(r, data, field) \
+    + ::gpudb::AvroUtils::get_binary_encoded_size(GPUDB_AVRO_RECORD_FIELD_NAME(field))
+#define GPUDB_AVRO_RECORD_EXACT_SIZE(r, data, field) \
+    + ::gpudb::AvroUtils::get_exact_encoded_size(GPUDB_AVRO_RECORD_FIELD_NAME(field))
+
+// --------------------------------------------------------------------------
+
+/// The schema string literal of the record, in avro's parsing canonical form.
+#define GPUDB_AVRO_RECORD_SCHEMA(name, fields) \
+    "{\"name\":\"" BOOST_PP_STRINGIZE(name) "\",\"type\":\"record\",\"fields\":[" \
+    BOOST_PP_SEQ_FOR_EACH_I(GPUDB_AVRO_RECORD_FIELD_SCHEMA, ~, fields) "]}"
+
+/// Define struct name with the given fields, e.g. ((double, x))((string, label)).
+/// The struct is an aggregate with the same static functions as the obj_defs.
+#define GPUDB_AVRO_RECORD(name, fields) \
+    struct name \
+    { \
+        BOOST_PP_SEQ_FOR_EACH(GPUDB_AVRO_RECORD_MEMBER, ~, fields) \
+        \
+        size_t min_binary_encoded_size() const { return 0 \
+                BOOST_PP_SEQ_FOR_EACH(GPUDB_AVRO_RECORD_MIN_SIZE, ~, fields); } \
+        \
+        size_t estimated_binary_encoded_size() const { return std::max((size_t)4096, (size_t)1024 \
+                BOOST_PP_SEQ_FOR_EACH(GPUDB_AVRO_RECORD_SIZE, ~, fields)); } \
+        \
+        size_t exact_binary_encoded_size() const { return 0 \
+                BOOST_PP_SEQ_FOR_EACH(GPUDB_AVRO_RECORD_EXACT_SIZE, ~, fields); } \
+        \
+        static const std::string& schema_name(void) \
+        { \
+            static const std::string str(BOOST_PP_STRINGIZE(name)); \
+            return str; \
+        } \
+        static const std::string& schema_str(void) \
+        { \
+            static const std::string str(GPUDB_AVRO_RECORD_SCHEMA(name, fields)); \
+            return str; \
+        } \
+        /* AvroUtils::fingerprint64() of the schema_str() text, constexpr with C++14 */ \
+        static GPUDB_AVRO_RECORD_CONSTEXPR uint64_t fingerprint(void) \
+        { \
+            return ::gpudb::AvroRecord::fingerprint64(GPUDB_AVRO_RECORD_SCHEMA(name, fields), \
+                                                      sizeof(GPUDB_AVRO_RECORD_SCHEMA(name, fields)) - 1); \
+        } \
+        /* The compiled schema, the one interned by AvroUtils */ \
+        static const avro::ValidSchema& schema(void) \
+        { \
+            static const avro::ValidSchema s(::gpudb::AvroUtils::intern_schema(schema_str(), fingerprint()).schema()); \
+            return s; \
+        } \
+        \
+        inline void avro_encode(avro::Encoder& e) const \
+        { \
+            BOOST_PP_SEQ_FOR_EACH(GPUDB_AVRO_RECORD_ENCODE, ~, fields) \
+        } \
+        inline void avro_decode(avro::Decoder& d) \
+        { \
+            BOOST_PP_SEQ_FOR_EACH(GPUDB_AVRO_RECORD_DECODE, ~, fields) \
+        } \
+    };
+
+/// Specialize avro::codec_traits and the AvroUtils size estimates for a struct
+/// declared with GPUDB_AVRO_RECORD(); must be used at global scope with the
+/// namespace qualified name of the struct.
+#define GPUDB_AVRO_RECORD_CODEC(qualified_name) \
+    namespace avro { \
+    template<> struct codec_traits<qualified_name> { \
+        static inline void encode(Encoder& e, const qualified_name& v) { v.avro_encode(e); } \
+        static inline void decode(Decoder& d, qualified_name& v) { v.avro_decode(d); } \
+    }; \
+    } \
+    namespace gpudb { \
+    template<> inline size_t AvroUtils::get_estimated_binary_encoded_size<qualified_name>(const qualified_name& v) \
+    { return v.estimated_binary_encoded_size(); } \
+    template<> inline size_t AvroUtils::get_min_binary_encoded_size<qualified_name>(const qualified_name& v) \
+    { return v.min_binary_encoded_size(); } \
+    template<> inline size_t AvroUtils::get_exact_binary_encoded_size<qualified_name>(const qualified_name& v) \
+    { return v.exact_binary_encoded_size(); } \
+    }
+
+#endif
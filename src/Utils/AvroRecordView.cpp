@@ -0,0 +1,495 @@
+#include "AvroRecordView.h"
+#include "AvroUtils.h"
+#include "AvroVarint.h"
+
+#include <string.h>
+#include <algorithm>
+#include <stdexcept>
+
+#include <avro/Node.hh>
+#include <avro/NodeImpl.hh>
+#include <avro/Types.hh>
+
+
+namespace gpudb
+{
+
+namespace
+{
+
+enum step_kind
+{
+    SKIP_FIXED,  ///< Skip arg bytes
+    SKIP_VARINT, ///< Skip an int, long or enum
+    SKIP_BYTES,  ///< Skip a string or bytes
+    SKIP_NODE,   ///< Skip a value of node arg
+    READ         ///< Note the position of projected field arg and skip it
+};
+
+// Nesting of complex values deeper than this is taken to be invalid data.
+const int MAX_SKIP_DEPTH = 64;
+
+inline bool skip_varint(const uint8_t*& p, const uint8_t* end)
+{
+    const uint8_t* limit = (end - p > (ptrdiff_t)AvroVarint::MAX_ENCODED_SIZE) ? p + AvroVarint::MAX_ENCODED_SIZE : end;
+    for (const uint8_t* q = p; q < limit; ++q)
+    {
+        if ((*q & 0x80) == 0)
+        {
+            p = q + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool skip_fixed(const uint8_t*& p, const uint8_t* end, size_t n)
+{
+    if ((size_t)(end - p) < n)
+        return false;
+    p += n;
+    return true;
+}
+
+inline bool skip_bytes(const uint8_t*& p, const uint8_t* end)
+{
+    int64_t len;
+    if (!AvroVarint::decode(p, end, len) || (len < 0))
+        return false;
+    return skip_fixed(p, end, (size_t)len);
+}
+
+inline bool is_projectable(int type)
+{
+    switch (type)
+    {
+        case avro::AVRO_BOOL:
+        case avro::AVRO_INT:
+        case avro::AVRO_LONG:
+        case avro::AVRO_FLOAT:
+        case avro::AVRO_DOUBLE:
+        case avro::AVRO_STRING:
+        case avro::AVRO_BYTES:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // end anonymous namespace
+
+
+AvroRecordView::AvroRecordView(const avro::ValidSchema& schema, const std::vector<std::string>& fields) :
+    end_(NULL)
+{
+    init(schema, fields);
+}
+
+AvroRecordView::AvroRecordView(const std::string& schema_str, const std::vector<std::string>& fields) :
+    end_(NULL)
+{
+    init(AvroUtils::get_or_compile_schema(schema_str), fields);
+}
+
+
+void AvroRecordView::init(const avro::ValidSchema& schema, const std::vector<std::string>& names)
+{
+    avro::NodePtr root = schema.root();
+    if (root->type() == avro::AVRO_SYMBOLIC)
+        root = avro::resolveSymbol(root);
+    if (root->type() != avro::AVRO_RECORD)
+        throw std::runtime_error("AvroRecordView: the schema is not a record");
+
+    // The projected field, if any, of each field of the record
+    std::vector<size_t> projected(root->leaves(), names.size());
+    size_t last = 0;
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        size_t idx;
+        if (!root->nameIndex(names[i], idx))
+            throw std::runtime_error("AvroRecordView: no field " + names[i] + " in the record");
+        if (projected[idx] < names.size())
+            throw std::runtime_error("AvroRecordView: field " + names[i] + " is projected twice");
+
+        avro::NodePtr leaf = root->leafAt((int)idx);
+        if (leaf->type() == avro::AVRO_SYMBOLIC)
+            leaf = avro::resolveSymbol(leaf);
+        if (!is_projectable(leaf->type()))
+            throw std::runtime_error("AvroRecordView: field " + names[i] + " is not of a primitive type");
+
+        field f;
+        f.name = names[i];
+        f.type = leaf->type();
+        fields_.push_back(f);
+
+        projected[idx] = i;
+        last = std::max(last, idx + 1);
+    }
+
+    // Nothing after the last projected field needs to be scanned
+    std::vector<std::pair<const avro::Node*, size_t> > named;
+    for (size_t idx = 0; idx < last; ++idx)
+    {
+        if (projected[idx] < names.size())
+        {
+            add_skip(READ, projected[idx]);
+            continue;
+        }
+
+        avro::NodePtr leaf = root->leafAt((int)idx);
+        if (leaf->type() == avro::AVRO_SYMBOLIC)
+            leaf = avro::resolveSymbol(leaf);
+
+        switch (leaf->type())
+        {
+            case avro::AVRO_NULL:   break;
+            case avro::AVRO_BOOL:   add_skip(SKIP_FIXED, 1); break;
+            case avro::AVRO_FLOAT:  add_skip(SKIP_FIXED, sizeof(float)); break;
+            case avro::AVRO_DOUBLE: add_skip(SKIP_FIXED, sizeof(double)); break;
+            case avro::AVRO_FIXED:  add_skip(SKIP_FIXED, leaf->fixedSize()); break;
+            case avro::AVRO_INT:
+            case avro::AVRO_LONG:
+            case avro::AVRO_ENUM:   add_skip(SKIP_VARINT, 0); break;
+            case avro::AVRO_STRING:
+            case avro::AVRO_BYTES:  add_skip(SKIP_BYTES, 0); break;
+            default:                add_skip(SKIP_NODE, compile(leaf, named)); break;
+        }
+    }
+
+    positions_.resize(fields_.size(), NULL);
+}
+
+
+// Append a step, merging consecutive fixed width skips.
+void AvroRecordView::add_skip(int kind, size_t arg)
+{
+    if ((kind == SKIP_FIXED) && !steps_.empty() && (steps_.back().kind == SKIP_FIXED))
+    {
+        steps_.back().arg += arg;
+        return;
+    }
+
+    step s = { kind, arg };
+    steps_.push_back(s);
+}
+
+
+// Compile the schema node (and its children) into nodes_, returns its index.
+size_t AvroRecordView::compile(const avro::NodePtr& schema_node,
+                               std::vector<std::pair<const avro::Node*, size_t> >& named)
+{
+    avro::NodePtr n = (schema_node->type() == avro::AVRO_SYMBOLIC) ? avro::resolveSymbol(schema_node) : schema_node;
+
+    // Named types may be referenced more than once, or recursively
+    for (size_t i = 0; i < named.size(); ++i)
+    {
+        if (named[i].first == n.get())
+            return named[i].second;
+    }
+
+    size_t idx = nodes_.size();
+    nodes_.push_back(node());
+    nodes_[idx].type = n->type();
+    nodes_[idx].fixed_size = 0;
+
+    switch (n->type())
+    {
+        case avro::AVRO_NULL:
+        case avro::AVRO_BOOL:
+        case avro::AVRO_INT:
+        case avro::AVRO_LONG:
+        case avro::AVRO_FLOAT:
+        case avro::AVRO_DOUBLE:
+        case avro::AVRO_STRING:
+        case avro::AVRO_BYTES:
+            break;
+
+        case avro::AVRO_FIXED:
+            named.push_back(std::make_pair(n.get(), idx));
+            nodes_[idx].fixed_size = n->fixedSize();
+            break;
+
+        case avro::AVRO_ENUM:
+            named.push_back(std::make_pair(n.get(), idx));
+            break;
+
+        case avro::AVRO_RECORD:
+            named.push_back(std::make_pair(n.get(), idx));
+            // fall through
+        case avro::AVRO_UNION:
+            for (size_t i = 0; i < n->leaves(); ++i)
+            {
+                size_t child = compile(n->leafAt((int)i), named);
+                nodes_[idx].children.push_back(child); // compile() may have grown nodes_
+            }
+            break;
+
+        case avro::AVRO_ARRAY:
+        {
+            size_t child = compile(n->leafAt(0), named);
+            nodes_[idx].children.push_back(child);
+            break;
+        }
+
+        case avro::AVRO_MAP:
+        {
+            size_t child = compile(n->leafAt(1), named);
+            nodes_[idx].children.push_back(child);
+            break;
+        }
+
+        default:
+            throw std::runtime_error("AvroRecordView: unsupported avro type in schema");
+    }
+
+    return idx;
+}
+
+
+bool AvroRecordView::read(const uint8_t* data, size_t len)
+{
+    const uint8_t* p = data;
+    end_ = data + len;
+
+    for (std::vector<step>::const_iterator s = steps_.begin(); s != steps_.end(); ++s)
+    {
+        switch (s->kind)
+        {
+            case SKIP_FIXED:
+                if (!skip_fixed(p, end_, s->arg))
+                    return false;
+                break;
+
+            case SKIP_VARINT:
+                if (!skip_varint(p, end_))
+                    return false;
+                break;
+
+            case SKIP_BYTES:
+                if (!skip_bytes(p, end_))
+                    return false;
+                break;
+
+            case SKIP_NODE:
+                if (!skip_value(p, s->arg))
+                    return false;
+                break;
+
+            case READ:
+            {
+                positions_[s->arg] = p;
+                bool ok;
+                switch (fields_[s->arg].type)
+                {
+                    case avro::AVRO_BOOL:   ok = skip_fixed(p, end_, 1); break;
+                    case avro::AVRO_FLOAT:  ok = skip_fixed(p, end_, sizeof(float)); break;
+                    case avro::AVRO_DOUBLE: ok = skip_fixed(p, end_, sizeof(double)); break;
+                    case avro::AVRO_INT:
+                    case avro::AVRO_LONG:   ok = skip_varint(p, end_); break;
+                    default:                ok = skip_bytes(p, end_); break;
+                }
+                if (!ok)
+                    return false;
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+// Skip a value of the node, with the same checks as the decoder.
+bool AvroRecordView::skip_value(const uint8_t*& p, size_t node_idx) const
+{
+    // An explicit stack of the records, arrays and maps being skipped rather
+    // than recursion, so that deeply nested data cannot blow the stack
+    struct frame { size_t node; int64_t left; size_t child; };
+    frame stack[MAX_SKIP_DEPTH];
+    int depth = 0;
+
+    size_t idx = node_idx;
+    for (;;)
+    {
+        const node& n = nodes_[idx];
+        bool ok = true;
+
+        switch (n.type)
+        {
+            case avro::AVRO_NULL:   break;
+            case avro::AVRO_BOOL:   ok = skip_fixed(p, end_, 1); break;
+            case avro::AVRO_FLOAT:  ok = skip_fixed(p, end_, sizeof(float)); break;
+            case avro::AVRO_DOUBLE: ok = skip_fixed(p, end_, sizeof(double)); break;
+            case avro::AVRO_FIXED:  ok = skip_fixed(p, end_, n.fixed_size); break;
+            case avro::AVRO_INT:
+            case avro::AVRO_LONG:
+            case avro::AVRO_ENUM:   ok = skip_varint(p, end_); break;
+            case avro::AVRO_STRING:
+            case avro::AVRO_BYTES:  ok = skip_bytes(p, end_); break;
+
+            case avro::AVRO_UNION:
+            {
+                int64_t branch;
+                ok = AvroVarint::decode(p, end_, branch) && (branch >= 0) && ((size_t)branch < n.children.size());
+                if (ok)
+                {
+                    idx = n.children[(size_t)branch];
+                    continue;
+                }
+                break;
+            }
+
+            case avro::AVRO_RECORD:
+            case avro::AVRO_ARRAY:
+            case avro::AVRO_MAP:
+            {
+                if (depth == MAX_SKIP_DEPTH)
+                    return false;
+                frame f = { idx, (n.type == avro::AVRO_RECORD) ? (int64_t)n.children.size() : 0, 0 };
+                stack[depth++] = f;
+                break;
+            }
+        }
+
+        if (!ok)
+            return false;
+
+        // Find the next value to skip, popping finished records, arrays and maps
+        for (;;)
+        {
+            if (depth == 0)
+                return true;
+
+            frame& f = stack[depth - 1];
+            const node& parent = nodes_[f.node];
+
+            if (parent.type == avro::AVRO_RECORD)
+            {
+                if (f.child < parent.children.size())
+                {
+                    idx = parent.children[f.child++];
+                    break;
+                }
+                --depth;
+                continue;
+            }
+
+            // Arrays and maps: items are counted down in blocks
+            if (f.left == 0)
+            {
+                int64_t count;
+                if (!AvroVarint::decode(p, end_, count))
+                    return false;
+                if (count == 0)
+                {
+                    --depth;
+                    continue;
+                }
+                if (count < 0)
+                {
+                    // The block is preceded by its size in bytes, skip it whole
+                    int64_t block_size;
+                    if (!AvroVarint::decode(p, end_, block_size) || (block_size < 0) ||
+                        !skip_fixed(p, end_, (size_t)block_size))
+                        return false;
+                    continue;
+                }
+                f.left = count;
+            }
+
+            --f.left;
+            if ((parent.type == avro::AVRO_MAP) && !skip_bytes(p, end_))
+                return false;
+            idx = parent.children[0];
+            break;
+        }
+    }
+}
+
+
+bool AvroRecordView::get_bool(size_t i, bool& value) const
+{
+    if (fields_[i].type != avro::AVRO_BOOL)
+        return false;
+    uint8_t b = *positions_[i];
+    if (b > 1)
+        return false;
+    value = (b == 1);
+    return true;
+}
+
+bool AvroRecordView::get_int(size_t i, int32_t& value) const
+{
+    if (fields_[i].type != avro::AVRO_INT)
+        return false;
+    const uint8_t* p = positions_[i];
+    int64_t v;
+    if (!AvroVarint::decode(p, end_, v) || (v < -2147483647LL - 1) || (v > 2147483647LL))
+        return false;
+    value = (int32_t)v;
+    return true;
+}
+
+bool AvroRecordView::get_long(size_t i, int64_t& value) const
+{
+    int type = fields_[i].type;
+    if ((type != avro::AVRO_LONG) && (type != avro::AVRO_INT))
+        return false;
+    const uint8_t* p = positions_[i];
+    return AvroVarint::decode(p, end_, value);
+}
+
+bool AvroRecordView::get_float(size_t i, float& value) const
+{
+    if (fields_[i].type != avro::AVRO_FLOAT)
+        return false;
+    memcpy(&value, positions_[i], sizeof(value)); // avro is little endian, as is the host
+    return true;
+}
+
+bool AvroRecordView::get_double(size_t i, double& value) const
+{
+    switch (fields_[i].type)
+    {
+        case avro::AVRO_DOUBLE:
+            memcpy(&value, positions_[i], sizeof(value));
+            return true;
+
+        case avro::AVRO_FLOAT:
+        {
+            float f;
+            memcpy(&f, positions_[i], sizeof(f));
+            value = f;
+            return true;
+        }
+
+        case avro::AVRO_INT:
+        case avro::AVRO_LONG:
+        {
+            int64_t v;
+            if (!get_long(i, v))
+                return false;
+            value = (double)v;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool AvroRecordView::get_bytes(size_t i, bytes_view& value) const
+{
+    int type = fields_[i].type;
+    if ((type != avro::AVRO_STRING) && (type != avro::AVRO_BYTES))
+        return false;
+    const uint8_t* p = positions_[i];
+    int64_t len;
+    if (!AvroVarint::decode(p, end_, len) || (len < 0) || (len > end_ - p))
+        return false;
+    value = bytes_view(p, (size_t)len);
+    return true;
+}
+
+} // end namespace gpudb
@@ -0,0 +1,177 @@
+#ifndef _AVRO_RECORD_VIEW_H_
+#define _AVRO_RECORD_VIEW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <avro/ValidSchema.hh>
+
+#include "BytesView.h"
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroRecordView Reads a few fields (the projection) out of binary
+///        encoded records without decoding the rest of them, e.g. the x and
+///        y of each object of a get_set page.
+///
+///        The record schema is compiled once into a list of steps that skip
+///        the unprojected fields by their encoded lengths (fixed widths are
+///        merged into a single jump) and note where the projected fields are;
+///        scanning stops after the last projected field. The fields are then
+///        decoded on demand with the get_*() functions, or for a whole page
+///        at once with read_column() or for_each().
+///
+///        Projected fields must be of a primitive type, i.e. boolean, int,
+///        long, float, double, string or bytes. A view holds the positions of
+///        the record last read, so each thread should use its own copy.
+// --------------------------------------------------------------------------
+class AvroRecordView
+{
+public:
+
+    /// Compile the view of the record schema projected onto the named
+    /// fields, which are numbered in the given order.
+    /// Throws if the schema is not a record or a field is missing, not of
+    /// a primitive type or named twice.
+    AvroRecordView(const avro::ValidSchema& schema, const std::vector<std::string>& fields);
+
+    /// The same from the schema string, e.g. the type definition of a set.
+    AvroRecordView(const std::string& schema_str, const std::vector<std::string>& fields);
+
+    inline size_t num_fields() const { return fields_.size(); }
+
+    /// The avro::Type of projected field i.
+    inline int field_type(size_t i) const { return fields_[i].type; }
+
+    /// Locate the projected fields of the encoded record; nothing is decoded.
+    /// The record must outlive the calls to get_*(). False if it is invalid.
+    bool read(const uint8_t* data, size_t len);
+
+    inline bool read(const bytes_view& record)           { return read(record.data, record.size); }
+    inline bool read(const std::vector<uint8_t>& record) { return read(record.empty() ? NULL : &record[0], record.size()); }
+
+    // ----------------------------------------------------------------------
+    // Decode projected field i of the record last read. Numbers are widened
+    // (e.g. an int field read as a double) but never narrowed.
+    // Return false if the field is of another type or invalid.
+
+    bool get_bool(size_t i, bool& value) const;
+    bool get_int(size_t i, int32_t& value) const;
+    bool get_long(size_t i, int64_t& value) const;
+    bool get_float(size_t i, float& value) const;
+    bool get_double(size_t i, double& value) const;
+
+    /// A string or bytes field, as a view into the record.
+    bool get_bytes(size_t i, bytes_view& value) const;
+
+    inline bool get_string(size_t i, std::string& value) const
+    {
+        bytes_view b;
+        if (!get_bytes(i, b))
+            return false;
+        value.assign(b.c_data(), b.size);
+        return true;
+    }
+
+    inline bool get(size_t i, bool& value) const        { return get_bool(i, value); }
+    inline bool get(size_t i, int32_t& value) const     { return get_int(i, value); }
+    inline bool get(size_t i, int64_t& value) const     { return get_long(i, value); }
+    inline bool get(size_t i, float& value) const       { return get_float(i, value); }
+    inline bool get(size_t i, double& value) const      { return get_double(i, value); }
+    inline bool get(size_t i, bytes_view& value) const  { return get_bytes(i, value); }
+    inline bool get(size_t i, std::string& value) const { return get_string(i, value); }
+
+    // ----------------------------------------------------------------------
+    // Bulk access across the records of a page, e.g. the list of a
+    // get_set_flat_response (AvroArena) or of a get_set_response.
+
+    /// Call f(*this, n) after reading each record n; false (stopping there)
+    /// if a record is invalid or f returns false.
+    template <class Records, class F>
+    bool for_each(const Records& records, F f)
+    {
+        for (size_t n = 0; n < records.size(); ++n)
+        {
+            if (!read(records[n]) || !f(*this, n))
+                return false;
+        }
+        return true;
+    }
+
+    /// Decode projected field i of every record into values, replacing its
+    /// contents. False if a record is invalid or the field has another type.
+    template <class Records, class T>
+    bool read_column(const Records& records, size_t i, std::vector<T>& values)
+    {
+        values.resize(records.size());
+        for (size_t n = 0; n < records.size(); ++n)
+        {
+            if (!read(records[n]) || !get(i, values[n]))
+                return false;
+        }
+        return true;
+    }
+
+    /// The same for a boolean field; the elements of a std::vector<bool>
+    /// are packed, so each is decoded into a bool first.
+    template <class Records>
+    bool read_column(const Records& records, size_t i, std::vector<bool>& values)
+    {
+        values.resize(records.size());
+        for (size_t n = 0; n < records.size(); ++n)
+        {
+            bool value;
+            if (!read(records[n]) || !get_bool(i, value))
+                return false;
+            values[n] = value;
+        }
+        return true;
+    }
+
+private:
+
+    /// A node of the schema, for skipping values of complex types.
+    struct node
+    {
+        int type;                     ///< The avro::Type of the node (never AVRO_SYMBOLIC)
+        std::vector<size_t> children; ///< Record fields, array items, map values or union branches
+        size_t fixed_size;            ///< Size of AVRO_FIXED nodes
+    };
+
+    /// A step of the scan over the fields of the record.
+    struct step
+    {
+        int    kind;
+        size_t arg; ///< Bytes to skip, a node or a projected field, by kind
+    };
+
+    struct field
+    {
+        std::string name;
+        int         type; ///< The avro::Type of the field
+    };
+
+    std::vector<node>  nodes_;
+    std::vector<step>  steps_;
+    std::vector<field> fields_;
+
+    // The record last read
+    std::vector<const uint8_t*> positions_; ///< Of each projected field
+    const uint8_t*              end_;
+
+    void init(const avro::ValidSchema& schema, const std::vector<std::string>& names);
+
+    size_t compile(const avro::NodePtr& n, std::vector<std::pair<const avro::Node*, size_t> >& named);
+    void   add_skip(int kind, size_t arg);
+
+    bool skip_value(const uint8_t*& p, size_t node_idx) const;
+};
+
+} // end namespace gpudb
+
+#endif
@@ -1,4 +1,9 @@
 #include "AvroUtils.h"
+#include "AvroJsonTranscoder.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
 
 #include "../obj_defs/actorobject.h"
 #include "../obj_defs/actorlist.h"
@@ -9,7 +14,38 @@
 namespace gpudb
 {
 
-AvroUtils::map_string_to_schema AvroUtils::string_to_schema;
+namespace
+{
+
+// Interned schemas keyed by their fingerprint; map nodes (and thus the
+// interned_schema entries that SchemaHandles point to) never move.
+typedef std::unordered_map<uint64_t, interned_schema> map_fingerprint_to_schema;
+
+map_fingerprint_to_schema fingerprint_to_schema;
+std::mutex                fingerprint_to_schema_mutex;
+
+// CRC-64-AVRO, see the "Schema Fingerprints" section of the Avro specification.
+const uint64_t RABIN_EMPTY_FINGERPRINT = 0xc15d213aa4d7a795ULL;
+
+struct rabin_table
+{
+    uint64_t fp[256];
+
+    rabin_table()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            uint64_t f = i;
+            for (int j = 0; j < 8; ++j)
+                f = (f >> 1) ^ (RABIN_EMPTY_FINGERPRINT & -(f & 1));
+            fp[i] = f;
+        }
+    }
+};
+
+const rabin_table rabin;
+
+} // end anonymous namespace
 
 
 //static
@@ -20,15 +56,16 @@ void AvroUtils::initialize()
   is_initialized = true;
 
   // Add the common schemas we probably need
-  string_to_schema[gpudb::actor_object::schema_str()]  = compile_schema(gpudb::actor_object::schema_str());
-  string_to_schema[gpudb::actor_list::schema_str()]    = compile_schema(gpudb::actor_list::schema_str());
-  string_to_schema[gpudb::gpudb_response::schema_str()] = compile_schema(gpudb::gpudb_response::schema_str());
+  gpudb::actor_object::schema();
+  gpudb::actor_list::schema();
+  gpudb::gpudb_response::schema();
 }
 
 //static
 void AvroUtils::shutdown()
 {
-    AvroUtils::string_to_schema.clear();
+    std::lock_guard<std::mutex> lock(fingerprint_to_schema_mutex);
+    fingerprint_to_schema.clear();
 }
 
 avro::ValidSchema AvroUtils::compile_schema(const std::string& schema_str)
@@ -40,15 +77,90 @@ avro::ValidSchema AvroUtils::compile_schema(const std::string& schema_str)
 }
 
 //static
-avro::ValidSchema AvroUtils::get_or_compile_schema(const std::string& schema_str)
+const avro::ValidSchema& AvroUtils::get_or_compile_schema(const std::string& schema_str)
+{
+  return intern_schema(schema_str).schema();
+}
+
+//static
+const avro::ValidSchema& AvroUtils::get_or_compile_schema(const std::string& schema_str, uint64_t fingerprint)
+{
+  return intern_schema(schema_str, fingerprint).schema();
+}
+
+//static
+SchemaHandle AvroUtils::intern_schema(const std::string& schema_str)
+{
+  return intern_schema(schema_str, fingerprint64(schema_str));
+}
+
+//static
+SchemaHandle AvroUtils::intern_schema(const std::string& schema_str, uint64_t fingerprint)
+{
+  return intern_schema(schema_str, fingerprint, true);
+}
+
+//static
+SchemaHandle AvroUtils::intern_known_schema(const std::string& schema_str, uint64_t fingerprint)
+{
+  return intern_schema(schema_str, fingerprint, false);
+}
+
+//static
+SchemaHandle AvroUtils::intern_schema(const std::string& schema_str, uint64_t fingerprint, bool compare_text)
+{
+  {
+    std::lock_guard<std::mutex> lock(fingerprint_to_schema_mutex);
+    map_fingerprint_to_schema::const_iterator it = fingerprint_to_schema.find(fingerprint);
+    if (it != fingerprint_to_schema.end())
+    {
+      // CRC-64 collisions are easy to construct, so a different type
+      // definition with the same fingerprint must not share the entry
+      if (compare_text && (it->second.schema_str != schema_str))
+        throw std::runtime_error("Schema fingerprint collision for: " + schema_str);
+      return SchemaHandle(&it->second);
+    }
+  }
+
+  // Compile outside of the lock, it may take a while for large schemas.
+  interned_schema entry;
+  entry.fingerprint = fingerprint;
+  entry.schema_str  = schema_str;
+  entry.schema      = compile_schema(schema_str);
+  try
+  {
+    entry.json_transcoder.reset(new AvroJsonTranscoder(entry.schema));
+  }
+  catch (const std::exception& e)
+  {
+    // Unsupported by the transcoder, conversions use the validating path
+  }
+
+  std::lock_guard<std::mutex> lock(fingerprint_to_schema_mutex);
+  // Another thread may have beaten us to it, in which case theirs is kept.
+  std::pair<map_fingerprint_to_schema::iterator, bool> ins =
+      fingerprint_to_schema.insert(std::make_pair(fingerprint, entry));
+  return SchemaHandle(&ins.first->second);
+}
+
+//static
+SchemaHandle AvroUtils::find_schema(uint64_t fingerprint)
 {
-  map_string_to_schema::const_iterator it = string_to_schema.find(schema_str);
-  if (it != string_to_schema.end())
-    return it->second;
+  std::lock_guard<std::mutex> lock(fingerprint_to_schema_mutex);
+  map_fingerprint_to_schema::const_iterator it = fingerprint_to_schema.find(fingerprint);
+  if (it == fingerprint_to_schema.end())
+    return SchemaHandle();
+  return SchemaHandle(&it->second);
+}
 
-  avro::ValidSchema schema = compile_schema(schema_str);
-  string_to_schema[schema_str] = schema;
-  return schema;
+//static
+uint64_t AvroUtils::fingerprint64(const char* data, size_t len)
+{
+  uint64_t fp = RABIN_EMPTY_FINGERPRINT;
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (size_t i = 0; i < len; ++i)
+    fp = (fp >> 8) ^ rabin.fp[(fp ^ bytes[i]) & 0xff];
+  return fp;
 }
 
 //static
@@ -58,10 +170,8 @@ bool AvroUtils::convert_binary_to_json(const std::vector<uint8_t>& binary,
                                        std::string& json_str)
 {
     avro::GenericDatum datum(schema);
-    avro::DecoderPtr d = avro::binaryDecoder(); // cheap to create
-    std::auto_ptr<avro::InputStream> in = avro::memoryInputStream(binary.data(), binary.size());
-    d->init(*in);
-    avro::decode(*d, datum);
+    AvroBufferDecoder d(binary.data(), binary.size()); // reads the vector in place
+    avro::decode(d, datum);
 
     AvroUtils::convert_to_json_by_encoder(datum, jsonEncoder, json_str);
     return true;
@@ -74,33 +184,74 @@ bool AvroUtils::convert_json_to_binary_by_schema_str( const std::string& json_st
                                                       const std::string& type_schema_str,
                                                       std::vector<uint8_t>& bytes)
 {
+    SchemaHandle type_schema;
     try
     {
-        // create the schema
-        avro::ValidSchema type_schema = AvroUtils::get_or_compile_schema( type_schema_str );
-        // return convert_json_to_object_by_schema(json_str, type_schema, avro_object);
+        // create (or look up) the schema
+        type_schema = AvroUtils::intern_schema( type_schema_str );
+    }
+    catch (const std::exception &excep )
+    {
+        return false;
+    }
+
+    return convert_json_to_binary_by_schema( json_str, type_schema, bytes );
+} // end convert_json_to_binary_by_schema_str
+
 
+// Convert the json encoded string directly to binary, or via avro if needed.
+//static
+bool AvroUtils::convert_json_to_binary_by_schema( const std::string& json_str,
+                                                  const SchemaHandle& type_schema,
+                                                  std::vector<uint8_t>& bytes)
+{
+    // Single pass json to binary, without an intermediate datum
+    if ( transcode_json_to_binary( json_str, type_schema, bytes ) )
+        return true;
+
+    // Let avro's validating decoder deal with anything else
+    return convert_json_to_binary_validated( json_str, type_schema, bytes );
+} // end convert_json_to_binary_by_schema
+
+
+// Convert the json encoded string to binary with the schema's transcoder, if any.
+//static
+bool AvroUtils::transcode_json_to_binary( const std::string& json_str,
+                                          const SchemaHandle& type_schema,
+                                          std::vector<uint8_t>& bytes)
+{
+    const AvroJsonTranscoder* transcoder = type_schema.json_transcoder();
+    return transcoder && transcoder->transcode( json_str, bytes );
+} // end transcode_json_to_binary
+
+
+// Convert the json encoded string to an avro object, then encode to binary.
+//static
+bool AvroUtils::convert_json_to_binary_validated( const std::string& json_str,
+                                                  const SchemaHandle& type_schema,
+                                                  std::vector<uint8_t>& bytes)
+{
+    try
+    {
         // create a generic datum given the schema
-        avro::GenericDatum datum( type_schema );
+        avro::GenericDatum datum( type_schema.schema() );
 
-        // set up decoder
-        std::istringstream iss (json_str, std::istringstream::in);
-        std::auto_ptr<avro::InputStream> in = avro::istreamInputStream( iss );
-        avro::DecoderPtr d = avro::jsonDecoder( type_schema );
+        // set up decoder, the string is read in place
+        AvroMemoryInputStream in( (const uint8_t*)json_str.data(), json_str.size() );
+        AvroCodecPool::JsonDecoder d( type_schema.schema() );
 
         // decode into the avro object
-        d->init( *in );
+        d->init( in );
         avro::decode( *d, datum );
+        d.release();
 
-        // Note that the chunk size will be adjusted in convert_to_byte_stream().
-        AvroMemoryOutputStream out(AvroMemoryOutputStream::DEFAULT_CHUNK_SIZE);
-        avro::EncoderPtr e = avro::binaryEncoder();
+        // Encode straight into the output vector
+        AvroMemoryOutputStream out( bytes );
+        AvroCodecPool::Encoder e;
         e->init( out );
         avro::encode( *e, datum);
         e->flush(); // reclaim unused space
-
-        // Copy the binary data to the output vector
-        out.getBuffer( bytes );
+        e.release();
 
         return true;
     }
@@ -108,7 +259,7 @@ bool AvroUtils::convert_json_to_binary_by_schema_str( const std::string& json_st
     {
         return false;
     }
-} // end convert_json_to_binary_by_schema_str
+} // end convert_json_to_binary_validated
 
 // --------------------------------------------------------------------------
 // Specializations of init_avro_message(), declarations at bottom of .h file.
@@ -2,6 +2,8 @@
 #define _AVRO_UTILS_H_
 
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -15,39 +17,121 @@
 #include <avro/Stream.hh>
 #include <avro/Generic.hh> // for encode(e, GenericDatum)
 
+#include <boost/shared_ptr.hpp>
+
 #include "AvroTypes.h"
+#include "AvroBufferDecoder.h" // codec_traits for arrays of int and long
+#include "AvroChunkPool.h"
+#include "AvroVarint.h"
+#include "AvroCodecPool.h"
+#include "AvroJsonWriter.h"
 
 
 namespace gpudb
 {
 
 class AvroMemoryOutputStream;
+class AvroJsonTranscoder;
+
+/// A schema that has been compiled once and interned by AvroUtils::intern_schema().
+/// Entries are never modified or freed (except by AvroUtils::shutdown()).
+struct interned_schema
+{
+    uint64_t          fingerprint; ///< fingerprint64() of the schema_str text.
+    std::string       schema_str;  ///< The schema string as it was interned.
+    avro::ValidSchema schema;      ///< The compiled schema.
+
+    /// Direct json to binary transcoder for the schema, NULL if it is not supported.
+    boost::shared_ptr<const AvroJsonTranscoder> json_transcoder;
+};
 
 // --------------------------------------------------------------------------
-/// @class AvroUtils A collection of common avro operations on gpudb avro type.
+/// @class SchemaHandle A compact handle to an interned schema.
+///        Copying or dereferencing a handle never touches the schema string,
+///        so hot paths should intern a schema once and pass the handle along.
 // --------------------------------------------------------------------------
-class AvroUtils
+class SchemaHandle
 {
-private:
+    friend class AvroUtils;
+
+    const interned_schema* entry_;
 
-    typedef std::map<std::string, avro::ValidSchema> map_string_to_schema;
-    static map_string_to_schema string_to_schema;
+    explicit SchemaHandle(const interned_schema* entry) : entry_(entry) { }
 
+public:
+
+    SchemaHandle() : entry_(NULL) { }
+
+    /// True if this handle refers to an interned schema.
+    inline bool valid() const { return entry_ != NULL; }
+
+    inline uint64_t                 fingerprint() const { return entry_->fingerprint; }
+    inline const std::string&       schema_str()  const { return entry_->schema_str; }
+    inline const avro::ValidSchema& schema()      const { return entry_->schema; }
+
+    /// The compiled json to binary transcoder, may be NULL.
+    inline const AvroJsonTranscoder* json_transcoder() const { return entry_->json_transcoder.get(); }
+
+    inline bool operator==(const SchemaHandle& other) const { return entry_ == other.entry_; }
+    inline bool operator!=(const SchemaHandle& other) const { return entry_ != other.entry_; }
+};
+
+// --------------------------------------------------------------------------
+/// @class AvroUtils A collection of common avro operations on gpudb avro type.
+// --------------------------------------------------------------------------
+class AvroUtils
+{
 public:
 
     /// Init the static schema string to avro::ValidSchema.
     static void initialize();
 
-    /// Clear the static schema string to avro::ValidSchema.
+    /// Clear the interned schemas; invalidates every outstanding SchemaHandle.
     static void shutdown();
 
     /// Compile the given schema string into an avro::ValidSchema.
     /// Throws if the schema cannot be converted.
     static avro::ValidSchema compile_schema(const std::string& schema_str);
 
-    /// Get a previously compiled schema or compile it an add it to a map.
+    /// Get a previously compiled schema or compile and intern it.
     /// Throws if the schema cannot be converted.
-    static avro::ValidSchema get_or_compile_schema(const std::string& schema_str);
+    static const avro::ValidSchema& get_or_compile_schema(const std::string& schema_str);
+
+    /// The same with the fingerprint of the string already known, so the
+    /// string is not hashed.
+    static const avro::ValidSchema& get_or_compile_schema(const std::string& schema_str, uint64_t fingerprint);
+
+    /// Compile the schema string once and return a handle keyed by its fingerprint.
+    /// Subsequent calls with the same string only hash it; the handle should be
+    /// kept by callers that use the same schema repeatedly.
+    /// Thread safe. Throws if the schema cannot be converted.
+    static SchemaHandle intern_schema(const std::string& schema_str);
+
+    /// The same with the fingerprint of the string already known, e.g. the
+    /// fingerprint() of the generated obj_defs, so the string is not hashed.
+    /// The interned text is still compared, so a fingerprint collision throws
+    /// rather than sharing another schema.
+    static SchemaHandle intern_schema(const std::string& schema_str, uint64_t fingerprint);
+
+    /// The same for the schema_str() and fingerprint() of a generated type
+    /// (obj_defs or GPUDB_AVRO_RECORD), whose strings are constants of the
+    /// program: once interned, the lookup is by the fingerprint alone.
+    /// Not for type definitions that come from users or the network.
+    static SchemaHandle intern_known_schema(const std::string& schema_str, uint64_t fingerprint);
+
+    /// Find a previously interned schema by its fingerprint,
+    /// returns an invalid handle if there is none.
+    static SchemaHandle find_schema(uint64_t fingerprint);
+
+    /// Compute the 64-bit Rabin fingerprint (the CRC-64-AVRO polynomial) of
+    /// the given bytes. Schemas are fingerprinted as written, not in the
+    /// Parsing Canonical Form the avro specification fingerprints, so the
+    /// values do not match other avro implementations' schema fingerprints.
+    static uint64_t fingerprint64(const char* data, size_t len);
+    static inline uint64_t fingerprint64(const std::string& str)
+    {
+        return fingerprint64(str.data(), str.size());
+    }
 
     // ----------------------------------------------------------------------
 
@@ -88,6 +172,25 @@ public:
                                                      const std::string& type_schema_str,
                                                      std::vector<uint8_t>& avro_object);
 
+    /// Convert the json encoded string directly to binary using the schema's
+    /// compiled AvroJsonTranscoder, falling back to convert_json_to_binary_validated()
+    /// if the transcoder does not accept the json.
+    static bool convert_json_to_binary_by_schema(const std::string& json_str,
+                                                 const SchemaHandle& type_schema,
+                                                 std::vector<uint8_t>& avro_object);
+
+    /// Convert the json encoded string to binary with the schema's compiled
+    /// AvroJsonTranscoder only; false if it has none or it does not accept the json.
+    static bool transcode_json_to_binary(const std::string& json_str,
+                                         const SchemaHandle& type_schema,
+                                         std::vector<uint8_t>& avro_object);
+
+    /// Convert the json encoded string to an avro::GenericDatum using avro's
+    /// validating json decoder, then encode the datum to binary.
+    static bool convert_json_to_binary_validated(const std::string& json_str,
+                                                 const SchemaHandle& type_schema,
+                                                 std::vector<uint8_t>& avro_object);
+
     // ----------------------------------------------------------------------
     // Binary/Json encoded bytes to avro object.
 
@@ -98,33 +201,16 @@ public:
         return convert_to_object(bytes.data(), bytes.size(), avro_object);
     }
 
+    /// Convert json encoded string into an avro object. The json is
+    /// transcoded to binary by the schema's AvroJsonTranscoder and decoded
+    /// from that, or decoded by avro's json decoder if the transcoder does
+    /// not accept it.
     template <class T>
-    static inline bool convert_to_object(const std::string& str, T& avro_object)
-    {
-        size_t len = str.size();
-        if ( len < get_min_binary_encoded_size<T>(avro_object) )
-            return false;
+    static bool convert_to_object(const std::string& str, T& avro_object);
 
-        try
-        {
-            // Note: This is relatively efficient and the input data is not copied.
-            std::auto_ptr<avro::InputStream> in( avro::memoryInputStream( (const uint8_t*)str.data(), len ) );
-
-            // Create a schema based on the avro object, create a JSON deocder and decode
-            // the data into the object
-            avro::ValidSchema type_schema = AvroUtils::get_or_compile_schema( avro_object.schema_str() );
-            avro::DecoderPtr d = avro::jsonDecoder( type_schema );
-            d->init(*in);
-            avro::decode(*d, avro_object);
-        }
-        catch (const std::exception &e)
-        {
-            return false;
-        }
-
-        return true;
-        // return convert_to_object((const uint8_t*)str.data(), str.size(), avro_object);
-     }
+    /// The same with the schema of the object already interned.
+    template <class T>
+    static bool convert_to_object(const std::string& str, const SchemaHandle& type_schema, T& avro_object);
 
     /// Convert binary encoded bytes into an avro object.
     template <class T>
@@ -146,16 +232,22 @@ public:
     // Avro object to binary encoding
 
     /// Convert an avro object into binary vector.
-    /// If buffer_size=0, get_estimated_binary_encoded_size() is used to specify the
-    /// buffer for a speed improvement.
+    /// If buffer_size=0, get_exact_binary_encoded_size() (or if unknown
+    /// get_estimated_binary_encoded_size()) is used to specify the buffer for
+    /// a speed improvement; with the exact size the vector is allocated once.
     template <class T>
     static bool convert_to_bytes(const T& avro_object,
                                  std::vector<uint8_t>& bytes,
                                  size_t buffer_size = 0);
 
+    /// Objects estimated to encode to more than this are encoded by
+    /// convert_to_bytes() directly into the vector rather than into chunks.
+    static const size_t CONTIGUOUS_ENCODING_SIZE = 64 * 1024;
+
     /// Convert an avro object into a previously unused binary memory stream.
-    /// If buffer_size=0, get_estimated_binary_encoded_size() is used to specify the
-    /// buffer for a speed improvement.
+    /// If buffer_size=0, get_exact_binary_encoded_size() (or if unknown
+    /// get_estimated_binary_encoded_size()) is used to specify the buffer for
+    /// a speed improvement.
     template <class T>
     static bool convert_to_byte_stream(const T& avro_object,
                                        AvroMemoryOutputStream& memStream,
@@ -254,6 +346,46 @@ public:
     }
 
 
+    /// Get the exact binary encoded size of an avro object or 0 if unknown.
+    /// Specializations autogenerated in ../obj_defs/obj_defs.h/cpp
+    template<typename T>
+    static inline size_t get_exact_binary_encoded_size(const T& ) { return 0; }
+
+    // Below are the exact binary encoded sizes of objects in avro, from the
+    // actual widths of the varints.
+    static inline size_t get_exact_encoded_size(bool )                         { return 1; }
+    static inline size_t get_exact_encoded_size(float )                        { return sizeof(float); }
+    static inline size_t get_exact_encoded_size(double )                       { return sizeof(double); }
+    static inline size_t get_exact_encoded_size(int32_t v)                     { return AvroVarint::encoded_size(v); }
+    static inline size_t get_exact_encoded_size(int64_t v)                     { return AvroVarint::encoded_size(v); }
+    static inline size_t get_exact_encoded_size(const std::string& s)          { return AvroVarint::encoded_size((int64_t)s.size()) + s.size(); }
+    static inline size_t get_exact_encoded_size(const std::vector<uint8_t>& v) { return AvroVarint::encoded_size((int64_t)v.size()) + v.size(); }
+
+    /// Arrays and maps are written as a single block and the empty block.
+    template<typename T>
+    static inline size_t get_exact_encoded_size(const std::vector<T>& v)
+    {
+        if (v.empty())
+            return 1;
+
+        size_t size = AvroVarint::encoded_size((int64_t)v.size()) + 1;
+        for (size_t i = 0; i < v.size(); ++i)
+            size += get_exact_encoded_size(v[i]);
+        return size;
+    }
+
+    template<typename K, typename V>
+    static inline size_t get_exact_encoded_size(const std::map<K, V>& m)
+    {
+        if (m.empty())
+            return 1;
+
+        size_t size = AvroVarint::encoded_size((int64_t)m.size()) + 1;
+        for (typename std::map<K, V>::const_iterator it = m.begin(); it != m.end(); ++it)
+            size += get_exact_encoded_size(it->first) + get_exact_encoded_size(it->second);
+        return size;
+    }
+
     /// Get an estimate of the min binary encoded size of an avro object or 0 if unknown.
     /// Specialize in cpp file and declare at bottom of this header for types
     /// that are known to be larger than the default.
@@ -273,11 +405,22 @@ public:
     template<typename T, typename K, typename V>
     static inline size_t get_min_binary_encoded_size(const std::map<K, V>& ) { return sizeof(int8_t);  } // zig-zag size
 
+private:
+
+    /// intern_schema() and intern_known_schema(); compare_text checks the
+    /// text of an interned schema found by the fingerprint.
+    static SchemaHandle intern_schema(const std::string& schema_str, uint64_t fingerprint, bool compare_text);
+
 };
 
 // --------------------------------------------------------------------------
 /// @class AvroMemoryOutputStream Exposed avro::MemoryOutputStream from
 ///                               avro-cpp-1.7.4/impl/Stream.cc to get at data.
+///
+///        The chunks come from the AvroChunkPool. Alternatively, in
+///        contiguous mode (see the vector constructor) the data is written
+///        into a single vector that is grown as needed, so it can be used as
+///        it is without copying it out with getBuffer().
 // --------------------------------------------------------------------------
 class AvroMemoryOutputStream : public avro::OutputStream
 {
@@ -287,26 +430,42 @@ class AvroMemoryOutputStream : public avro::OutputStream
     std::vector<uint8_t*> data_;
     size_t available_;
     size_t byteCount_;
+    size_t used_; ///< Chunks of data_ in use, the rest are kept by reset() for reuse
+    std::vector<uint8_t>* contiguous_; ///< The vector written to in contiguous mode, else NULL
 
 public:
 
     static const size_t DEFAULT_CHUNK_SIZE = 4096;
 
-    AvroMemoryOutputStream(size_t chunkSize = DEFAULT_CHUNK_SIZE) : chunkSize_(chunkSize),
-        available_(0), byteCount_(0) { }
+    AvroMemoryOutputStream(size_t chunkSize = DEFAULT_CHUNK_SIZE) : chunkSize_(AvroChunkPool::chunk_size(chunkSize)),
+        available_(0), byteCount_(0), used_(0), contiguous_(NULL) { }
+
+    /// Contiguous mode: write into buffer, which is cleared (keeping its
+    /// capacity) and first grown to initialSize; flush() trims it to byteCount().
+    /// The buffer must outlive the stream.
+    explicit AvroMemoryOutputStream(std::vector<uint8_t>& buffer, size_t initialSize = DEFAULT_CHUNK_SIZE) :
+        chunkSize_(initialSize), available_(0), byteCount_(0), used_(0), contiguous_(&buffer)
+    {
+        buffer.clear();
+    }
+
     virtual ~AvroMemoryOutputStream() {
         for (std::vector<uint8_t*>::const_iterator it = data_.begin();
             it != data_.end(); ++it) {
-            delete[] *it;
+            AvroChunkPool::release(*it, chunkSize_);
         }
     }
 
     inline bool next(uint8_t** data, size_t* len) {
+        if (contiguous_ != NULL)
+            return next_contiguous(data, len);
         if (available_ == 0) {
-            data_.push_back(new uint8_t[chunkSize_]);
+            if (used_ == data_.size())
+                data_.push_back(AvroChunkPool::allocate(chunkSize_));
+            ++used_;
             available_ = chunkSize_;
         }
-        *data = &data_.back()[chunkSize_ - available_];
+        *data = &data_[used_ - 1][chunkSize_ - available_];
         *len = available_;
         byteCount_ += available_;
         available_ = 0;
@@ -322,16 +481,51 @@ public:
         return byteCount_;
     }
 
-    inline void flush() { }
+    inline void flush() {
+        if (contiguous_ != NULL)
+            contiguous_->resize(byteCount_);
+    }
 
     // ----------------------------------------------------------------------
-    // Everything above is unmodified, below are added functions.
+    // Everything above is unmodified (except for reusing pooled chunks, see
+    // used_, and contiguous mode), below are added functions.
+
+    /// True if in contiguous mode.
+    inline bool is_contiguous() const { return contiguous_ != NULL; }
+
+    /// Discard the data, keeping the chunks for reuse if they hold at least
+    /// chunkSize bytes; otherwise they are released and chunkSize is used
+    /// from now on. In contiguous mode chunkSize is the initial size.
+    inline void reset(size_t chunkSize)
+    {
+        if (contiguous_ != NULL)
+        {
+            contiguous_->clear();
+            chunkSize_ = chunkSize;
+        }
+        else if (data_.empty() || (chunkSize > chunkSize_))
+        {
+            for (size_t i = 0; i < data_.size(); ++i)
+                AvroChunkPool::release(data_[i], chunkSize_);
+            data_.clear();
+            chunkSize_ = AvroChunkPool::chunk_size(chunkSize);
+        }
+        available_ = 0;
+        byteCount_ = 0;
+        used_ = 0;
+    }
+
+    /// The number of bytes of the chunks held, used or not.
+    inline size_t capacity() const
+    {
+        return (contiguous_ != NULL) ? contiguous_->capacity() : data_.size() * chunkSize_;
+    }
 
     /// Copy the data into the buffer, returns buffer size.
     inline size_t getBuffer(std::vector<uint8_t>& bytes) const
     {
         bytes.resize(byteCount_);
-        return getBuffer(&bytes[0]);
+        return (byteCount_ == 0) ? 0 : getBuffer(&bytes[0]);
     }
 
     /// Copy the data into the buffer, returns buffer size.
@@ -345,6 +539,13 @@ public:
     /// returns the buffer size.
     size_t getBuffer(uint8_t* bytes) const
     {
+        if (contiguous_ != NULL)
+        {
+            if (byteCount_ > 0)
+                memcpy(bytes, &(*contiguous_)[0], byteCount_);
+            return byteCount_;
+        }
+
         size_t chunks = data_.size();
         size_t start_idx = 0;
 
@@ -367,6 +568,53 @@ public:
 
         return byteCount_;
     }
+
+private:
+
+    /// Hand out the rest of the vector, growing it (within its capacity if
+    /// possible) when it is full; what was written is moved along with it.
+    inline bool next_contiguous(uint8_t** data, size_t* len)
+    {
+        std::vector<uint8_t>& buffer = *contiguous_;
+        if (byteCount_ == buffer.size())
+            buffer.resize(std::max(buffer.capacity(), std::max(2 * buffer.size(), chunkSize_)));
+
+        *data = &buffer[byteCount_];
+        *len = buffer.size() - byteCount_;
+        byteCount_ = buffer.size();
+        available_ = 0;
+        return true;
+    }
+};
+
+// --------------------------------------------------------------------------
+/// @class AvroMemoryInputStream An avro::InputStream over bytes owned by the
+///        caller, as avro::memoryInputStream() returns but without the heap
+///        allocation, so it can live on the stack. The bytes must outlive it.
+// --------------------------------------------------------------------------
+class AvroMemoryInputStream : public avro::InputStream
+{
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+
+public:
+
+    AvroMemoryInputStream(const uint8_t* data, size_t size) : data_(data), size_(size), pos_(0) { }
+
+    virtual bool next(const uint8_t** data, size_t* len)
+    {
+        if (pos_ == size_)
+            return false;
+        *data = data_ + pos_;
+        *len = size_ - pos_;
+        pos_ = size_;
+        return true;
+    }
+
+    virtual void backup(size_t len)    { pos_ -= len; }
+    virtual void skip(size_t len)      { pos_ += std::min(len, size_ - pos_); }
+    virtual size_t byteCount() const   { return pos_; }
 };
 
 // --------------------------------------------------------------------------
@@ -376,9 +624,7 @@ public:
 template <class T>
 bool AvroUtils::convert_json_to_binary(const std::string& json_str, std::vector<uint8_t>& bytes)
 {
-    const std::string& schema_str = T::schema_str();
-
-    avro::ValidSchema schema = AvroUtils::get_or_compile_schema(schema_str);
+    const avro::ValidSchema& schema = T::schema();
 
     T obj;
     AvroUtils::convert_json_to_object_by_schema<T>(json_str, schema, obj);
@@ -391,11 +637,53 @@ bool AvroUtils::convert_binary_to_json(const std::vector<uint8_t>& binary, std::
     T obj;
     AvroUtils::convert_to_object<T>(binary, obj);
 
-    const std::string& schema_str = T::schema_str();
+    return AvroUtils::convert_to_json_by_schema<T>(obj, T::schema(), str);
+}
 
-    avro::ValidSchema schema = AvroUtils::get_or_compile_schema(schema_str);
+template <class T>
+bool AvroUtils::convert_to_object(const std::string& str, T& avro_object)
+{
+    try
+    {
+        return convert_to_object( str, AvroUtils::intern_known_schema( T::schema_str(), T::fingerprint() ), avro_object );
+    }
+    catch (const std::exception &e)
+    {
+        return false;
+    }
+}
 
-    return AvroUtils::convert_to_json_by_schema<T>(obj, schema, str);
+template <class T>
+bool AvroUtils::convert_to_object(const std::string& str, const SchemaHandle& type_schema, T& avro_object)
+{
+    size_t len = str.size();
+    if ( len < get_min_binary_encoded_size<T>(avro_object) )
+        return false;
+
+    try
+    {
+        // Single pass json to binary, then the (fast) binary decoding
+        {
+            AvroCodecPool::Bytes bytes;
+            if ( transcode_json_to_binary( str, type_schema, *bytes ) )
+                return convert_to_object( *bytes, avro_object );
+        }
+
+        // Note: This is relatively efficient and the input data is not copied.
+        AvroMemoryInputStream in( (const uint8_t*)str.data(), len );
+
+        // Get a JSON decoder for the schema and decode the data into the object
+        AvroCodecPool::JsonDecoder d( type_schema.schema() );
+        d->init(in);
+        avro::decode(*d, avro_object);
+        d.release();
+    }
+    catch (const std::exception &e)
+    {
+        return false;
+    }
+
+    return true;
 }
 
 template <class T>
@@ -408,11 +696,9 @@ bool AvroUtils::convert_to_object(const uint8_t* bytes, size_t len, T& avro_obje
 
     try
     {
-        // Note: This is relatively efficient and the input data is not copied.
-        std::auto_ptr<avro::InputStream> in(avro::memoryInputStream(bytes, len));
-        avro::DecoderPtr d = avro::binaryDecoder();
-        d->init(*in);
-        avro::decode(*d, avro_object);
+        // Note: The input data is not copied and the decoder reads it directly.
+        AvroBufferDecoder d(bytes, len);
+        avro::decode(d, avro_object);
     }
     catch (const std::exception &e)
     {
@@ -427,7 +713,7 @@ bool AvroUtils::convert_json_to_object_by_schema_str(const std::string& json_str
                                                      const std::string& type_schema_str,
                                                      T& avro_object)
 {
-    avro::ValidSchema type_schema = AvroUtils::get_or_compile_schema(type_schema_str);
+    const avro::ValidSchema& type_schema = AvroUtils::get_or_compile_schema(type_schema_str);
     return convert_json_to_object_by_schema(json_str, type_schema, avro_object);
 }
 
@@ -436,14 +722,14 @@ bool AvroUtils::convert_json_to_object_by_schema(const std::string& json_str,
                                                  const avro::ValidSchema& schema,
                                                  T& avro_object)
 {
-    // set up decoder
-    std::istringstream iss (json_str, std::istringstream::in);
-    std::auto_ptr<avro::InputStream> in = avro::istreamInputStream(iss);
-    avro::DecoderPtr d = avro::jsonDecoder(schema);
+    // set up decoder, the string is read in place
+    AvroMemoryInputStream in((const uint8_t*)json_str.data(), json_str.size());
+    AvroCodecPool::JsonDecoder d(schema);
 
     // decode into the avro object
-    d->init(*in);
+    d->init(in);
     avro::decode(*d, avro_object);
+    d.release();
 
     return true;
 }
@@ -453,17 +739,22 @@ bool AvroUtils::convert_to_byte_stream(const T& avro_object,
                                        AvroMemoryOutputStream& memStream,
                                        size_t _buffer_size)
 {
-    size_t buffer_size = _buffer_size > 0 ? _buffer_size : get_estimated_binary_encoded_size<T>(avro_object);
+    size_t buffer_size = _buffer_size;
+    if (buffer_size == 0)
+        buffer_size = get_exact_binary_encoded_size<T>(avro_object);
+    if (buffer_size == 0)
+        buffer_size = get_estimated_binary_encoded_size<T>(avro_object);
 
     // we can ONLY change the chunk size if the stream hasn't been used yet.
     if (memStream.byteCount_ == 0)
-        memStream.chunkSize_ = buffer_size;
+        memStream.reset(buffer_size);
 
-    avro::EncoderPtr e = avro::binaryEncoder();
+    AvroCodecPool::Encoder e;
     e->init(memStream);
     avro::encode(*e, avro_object);
     //need to run flush to reclaim unused space and not transfer the entire 4096/1024 bytes
     e->flush();
+    e.release();
 
     return true;
 }
@@ -471,16 +762,42 @@ bool AvroUtils::convert_to_byte_stream(const T& avro_object,
 template <class T>
 bool AvroUtils::convert_to_bytes(const T& avro_object, std::vector<uint8_t>& bytes, size_t _buffer_size)
 {
-    // Note that the chunk size will be adjusted in convert_to_byte_stream().
-    AvroMemoryOutputStream out(AvroMemoryOutputStream::DEFAULT_CHUNK_SIZE);
+    size_t buffer_size = _buffer_size;
+    if (buffer_size == 0)
+    {
+        // With the exact size the vector is allocated once and never copied
+        size_t exact_size = get_exact_binary_encoded_size<T>(avro_object);
+        if (exact_size > 0)
+        {
+            AvroMemoryOutputStream out(bytes, exact_size);
+            return AvroUtils::convert_to_byte_stream(avro_object, out, exact_size);
+        }
 
-    if (AvroUtils::convert_to_byte_stream(avro_object, out, _buffer_size))
+        buffer_size = get_estimated_binary_encoded_size<T>(avro_object);
+    }
+
+    if (buffer_size <= CONTIGUOUS_ENCODING_SIZE)
     {
-        out.getBuffer(bytes);
+        // Small objects are encoded into pooled chunks and copied out
+        AvroCodecPool::OutputStream out;
+        if (!AvroUtils::convert_to_byte_stream(avro_object, *out, buffer_size))
+            return false;
+
+        out->getBuffer(bytes);
         return true;
     }
 
-    return false;
+    // Large objects are encoded straight into the vector, so there is
+    // nothing to copy afterwards
+    AvroMemoryOutputStream out(bytes);
+    if (!AvroUtils::convert_to_byte_stream(avro_object, out, buffer_size))
+        return false;
+
+    // Don't let a (far too) high size estimate hold on to memory
+    if (bytes.capacity() > 2 * bytes.size() + CONTIGUOUS_ENCODING_SIZE)
+        std::vector<uint8_t>(bytes).swap(bytes);
+
+    return true;
 }
 
 template <class T>
@@ -488,7 +805,7 @@ bool AvroUtils::convert_to_json_by_schema_str(const T& avro_object,
                                               const std::string& type_schema_str,
                                               std::string& json_str)
 {
-    avro::ValidSchema type_schema = get_or_compile_schema(type_schema_str);
+    const avro::ValidSchema& type_schema = get_or_compile_schema(type_schema_str);
     return convert_to_json_by_schema(avro_object, type_schema, json_str);
 }
 
@@ -497,9 +814,11 @@ bool AvroUtils::convert_to_json_by_schema(const T& avro_object,
                                           const avro::ValidSchema& type_schema,
                                           std::string& json_str)
 {
-    // set up encoder
-    avro::EncoderPtr e = avro::jsonEncoder(type_schema);
-    return convert_to_json_by_encoder(avro_object, e, json_str);
+    // get an encoder, they are expensive to create
+    AvroCodecPool::Encoder e(type_schema);
+    convert_to_json_by_encoder(avro_object, e.ptr(), json_str);
+    e.release();
+    return true;
 }
 
 template <class T>
@@ -507,14 +826,22 @@ bool AvroUtils::convert_to_json_by_encoder(const T& avro_object,
                                            avro::EncoderPtr encoder,
                                            std::string& json_str)
 {
-    std::ostringstream oss (std::ostringstream::out);
+    // The json writer appends straight to the string, skipping the stream
+    AvroJsonWriter* writer = dynamic_cast<AvroJsonWriter*>(encoder.get());
+    if (writer != NULL)
+    {
+        json_str.clear();
+        writer->init(json_str);
+        avro::encode(*writer, avro_object);
+        return true;
+    }
 
-    std::auto_ptr<avro::OutputStream> out = avro::ostreamOutputStream(oss);
+    AvroCodecPool::OutputStream out;
     encoder->init(*out);
     avro::encode(*encoder, avro_object);
     encoder->flush();
 
-    json_str = oss.str();
+    out->getBuffer(json_str);
     return true;
 }
 
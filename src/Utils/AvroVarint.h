@@ -0,0 +1,201 @@
+#ifndef _AVRO_VARINT_H_
+#define _AVRO_VARINT_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class AvroVarint Zig-zag varint helpers for code that reads or writes the
+///                   avro binary encoding directly, without an avro::Encoder.
+// --------------------------------------------------------------------------
+class AvroVarint
+{
+    AvroVarint();
+
+public:
+
+    static const size_t MAX_ENCODED_SIZE = 10; ///< Max bytes of a zig-zag encoded int64_t.
+
+    static inline uint64_t zigzag_encode(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+    static inline int64_t  zigzag_decode(uint64_t v) { return (int64_t)((v >> 1) ^ (0 - (v & 1))); }
+
+    /// The number of bytes the value takes when zig-zag varint encoded.
+    static inline size_t encoded_size(int64_t v)
+    {
+        uint64_t n = zigzag_encode(v);
+        size_t bytes = 1;
+        while (n > 0x7F)
+        {
+            n >>= 7;
+            ++bytes;
+        }
+        return bytes;
+    }
+
+    /// Write the zig-zag varint encoding of v to out, which MUST have room for
+    /// MAX_ENCODED_SIZE bytes, returns the number of bytes written.
+    static inline size_t encode(int64_t v, uint8_t* out)
+    {
+        uint64_t n = zigzag_encode(v);
+        size_t i = 0;
+        while (n > 0x7F)
+        {
+            out[i++] = (uint8_t)((n & 0x7F) | 0x80);
+            n >>= 7;
+        }
+        out[i++] = (uint8_t)n;
+        return i;
+    }
+
+    /// Append the zig-zag varint encoding of v to the buffer.
+    static inline void append(int64_t v, std::vector<uint8_t>& out)
+    {
+        size_t pos = out.size();
+        out.resize(pos + MAX_ENCODED_SIZE);
+        out.resize(pos + encode(v, &out[pos]));
+    }
+
+    /// Append the avro binary encoding of a string or bytes: the zig-zag
+    /// varint length followed by the data itself.
+    static inline void append_bytes(const void* data, size_t len, std::vector<uint8_t>& out)
+    {
+        append((int64_t)len, out);
+        out.insert(out.end(), (const uint8_t*)data, (const uint8_t*)data + len);
+    }
+
+    /// Decode a zig-zag varint starting at p, advancing p past it.
+    /// Returns false if the buffer ends before the varint does or it is too long.
+    static inline bool decode(const uint8_t*& p, const uint8_t* end, int64_t& v)
+    {
+        uint64_t n = 0;
+        for (int shift = 0; shift < 70; shift += 7)
+        {
+            if (p == end)
+                return false;
+            uint8_t b = *p++;
+            n |= (uint64_t)(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+            {
+                v = zigzag_decode(n);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ----------------------------------------------------------------------
+    // Batch kernels for arrays of int or long values.
+    // Most values in real data (counts, sizes, small ids) encode to a single
+    // byte, so the single byte varints leading the next 16 (SSE2) or 8 (SWAR)
+    // bytes are found at once and decoded without a branch per value; the
+    // longer varint ending such a run takes the scalar path.
+
+    /// Decode up to n zig-zag varints starting at p into out, advancing p past
+    /// them. Returns the number of values decoded, less than n if the buffer
+    /// ends first, a varint is malformed or a value does not fit in T.
+    template <class T>
+    static inline size_t decode_array(const uint8_t*& p, const uint8_t* end, T* out, size_t n)
+    {
+        size_t i = 0;
+        while (i < n)
+        {
+            // The number of single byte varints at p, up to the block size
+            size_t run = 0;
+            size_t block = 0;
+            if ((p < end) && (*p >= 0x80))
+                ; // a longer varint, skip the block check
+#if defined(__SSE2__)
+            else if ((n - i >= 16) && (end - p >= 16))
+            {
+                uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)p));
+                block = 16;
+                run = (mask != 0) ? (size_t)__builtin_ctz(mask) : 16;
+            }
+#endif
+            else if ((n - i >= 8) && (end - p >= 8))
+            {
+                uint64_t w;
+                memcpy(&w, p, sizeof(w));
+                uint64_t high = w & 0x8080808080808080ULL; // little-endian hosts
+                block = 8;
+                run = (high != 0) ? (size_t)__builtin_ctzll(high) / 8 : 8;
+            }
+
+            for (size_t k = 0; k < run; ++k)
+                out[i + k] = (T)zigzag_decode(p[k]);
+            p += run;
+            i += run;
+            if ((block > 0) && (run == block))
+                continue;
+
+            const uint8_t* q = p;
+            int64_t v;
+            if ((i == n) || !decode(q, end, v) || !in_range(v, out))
+                break;
+            out[i++] = (T)v;
+            p = q;
+        }
+        return i;
+    }
+
+    /// The number of bytes the n values take when zig-zag varint encoded.
+    template <class T>
+    static inline size_t encoded_size_array(const T* in, size_t n)
+    {
+        size_t bytes = 0;
+        for (size_t i = 0; i < n; ++i)
+            bytes += encoded_size(in[i]);
+        return bytes;
+    }
+
+    /// Write the zig-zag varint encoding of the n values to out, which MUST
+    /// have room for encoded_size_array() bytes, returns the number of bytes written.
+    template <class T>
+    static inline size_t encode_array(const T* in, size_t n, uint8_t* out)
+    {
+        uint8_t* p = out;
+        size_t i = 0;
+        while (i < n)
+        {
+            // Pack the single byte varints leading the next eight values,
+            // eight at a time into one store
+            if ((n - i >= 8) && (zigzag_encode(in[i]) <= 0x7F))
+            {
+                uint64_t w = 0;
+                size_t run = 0;
+                for (; run < 8; ++run)
+                {
+                    uint64_t z = zigzag_encode(in[i + run]);
+                    if (z > 0x7F)
+                        break;
+                    w |= z << (8 * run); // little-endian hosts
+                }
+                memcpy(p, &w, sizeof(w)); // the bytes past run are overwritten below
+                p += run;
+                i += run;
+                if ((run == 8) || (i == n))
+                    continue;
+            }
+            p += encode(in[i++], p);
+        }
+        return (size_t)(p - out);
+    }
+
+private:
+
+    static inline bool in_range(int64_t, const int64_t*) { return true; }
+    static inline bool in_range(int64_t v, const int32_t*) { return (v >= -2147483647LL - 1) && (v <= 2147483647LL); }
+};
+
+} // end namespace gpudb
+
+#endif
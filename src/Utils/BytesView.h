@@ -0,0 +1,44 @@
+#ifndef _BYTES_VIEW_H_
+#define _BYTES_VIEW_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+
+namespace gpudb
+{
+
+/// A view of bytes owned by something else, e.g. an AvroArena or a received buffer.
+struct bytes_view
+{
+    const uint8_t* data;
+    size_t         size;
+
+    inline bytes_view() : data(NULL), size(0) { }
+    inline bytes_view(const uint8_t* d, size_t n) : data(d), size(n) { }
+
+    inline bool empty() const { return size == 0; }
+
+    inline const char* c_data() const { return (const char*)data; }
+
+    /// A copy of the bytes as a string.
+    inline std::string str() const { return std::string(c_data(), size); }
+
+    /// A copy of the bytes as a vector.
+    inline std::vector<uint8_t> vec() const { return std::vector<uint8_t>(data, data + size); }
+
+    inline bool operator==(const bytes_view& other) const
+    {
+        return (size == other.size) && ((size == 0) || (memcmp(data, other.data, size) == 0));
+    }
+    inline bool operator!=(const bytes_view& other) const { return !(*this == other); }
+
+    inline bool operator==(const std::string& s) const { return *this == bytes_view((const uint8_t*)s.data(), s.size()); }
+    inline bool operator!=(const std::string& s) const { return !(*this == s); }
+};
+
+} // end namespace gpudb
+
+#endif
@@ -4,9 +4,12 @@
 #include "Utils/AvroUtils.h"
 #include "Utils/GPUdbExceptions.h"
 
+#include <limits>
 #include <ostream>
 #include <sstream>
+#include <stdlib.h>
 
+#include <Poco/Exception.h>
 #include <Poco/Net/HTTPClientSession.h>
 #include <Poco/Net/HTTPRequest.h>
 #include <Poco/Net/HTTPResponse.h>
@@ -16,94 +19,256 @@
 namespace gpudb
 {
 
+// Responses are streamed in chunks of this size, which is also the largest
+// data item (e.g. an object) that is decoded without being copied.
+static const size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
+// A connection keeps the buffer of its last response for the next one
+// unless it grew past this.
+static const size_t MAX_KEPT_RESPONSE_BYTES = 16 * 1024 * 1024;
+
+
+namespace
+{
+
+// An avro::InputStream reading a std::istream through a buffer owned by the
+// caller (avro::istreamInputStream() allocates one each time)
+class istream_input_stream : public avro::InputStream
+{
+public:
+    istream_input_stream( std::istream& is, std::vector<uint8_t>& buffer ) :
+        is_( is ), buffer_( buffer ), pos_( 0 ), available_( 0 ), count_( 0 ) {}
+
+    virtual bool next( const uint8_t** data, size_t* len )
+    {
+        if ( available_ == 0 )
+        {
+            is_.read( (char*)&buffer_[0], buffer_.size() );
+            available_ = (size_t)is_.gcount();
+            pos_ = 0;
+            if ( available_ == 0 )
+                return false;
+        }
+        *data = &buffer_[ pos_ ];
+        *len = available_;
+        pos_ += available_;
+        count_ += available_;
+        available_ = 0;
+        return true;
+    }
+
+    virtual void backup( size_t len )
+    {
+        pos_ -= len;
+        available_ += len;
+        count_ -= len;
+    }
+
+    virtual void skip( size_t len )
+    {
+        const uint8_t* data;
+        size_t n;
+        while ( ( len > 0 ) && next( &data, &n ) )
+        {
+            if ( n > len )
+            {
+                backup( n - len );
+                n = len;
+            }
+            len -= n;
+        }
+    }
+
+    virtual size_t byteCount() const { return count_; }
+
+private:
+    std::istream&         is_;
+    std::vector<uint8_t>& buffer_;
+    size_t                pos_;
+    size_t                available_;
+    size_t                count_;
+};
+
+} // end anonymous namespace
+
+
+
+// ======================= HTTPConnection Member Functions ====================
+
+struct HTTPConnection::state
+{
+    Poco::Net::HTTPClientSession session;
+    Poco::Net::HTTPRequest       request;
+    Poco::Net::HTTPResponse      response;
+
+    boost::shared_ptr<std::vector<uint8_t> > response_buffer; // The last binary response
+    std::string                              json_buffer;     // The last json response
+    std::vector<uint8_t>                     stream_buffer;   // Chunks of a streamed response
+
+    state( const std::string& ip, unsigned short port, int timeout_secs ) :
+        session( ip, port ),
+        request( Poco::Net::HTTPRequest::HTTP_POST, "/", Poco::Net::HTTPRequest::HTTP_1_1 )
+    {
+        session.setKeepAlive( true );
+        session.setTimeout( Poco::Timespan( timeout_secs, 0 ) );
+        request.setKeepAlive( true );
+    }
+
+    // Send a request and return the stream of its response's body. The
+    // server may have closed a kept-alive connection since its last use,
+    // which fails the send; an idempotent request is then sent once more,
+    // on a new connection (any other is not, as GPUdb may have run it)
+    std::istream& send( const std::string& endpoint, const char* content_type,
+                        const void* data, size_t len, bool idempotent )
+    {
+        request.setURI( endpoint );
+        request.setContentType( content_type );
+        request.setContentLength( (std::streamsize)len );
+
+        bool reused = session.connected();
+        try
+        {
+            return send_once( data, len );
+        }
+        catch (const Poco::Exception&)
+        {
+            if ( !idempotent || !reused )
+                throw;
+            session.reset();
+        }
+        return send_once( data, len );
+    }
+
+    std::istream& send_once( const void* data, size_t len )
+    {
+        std::ostream& os = session.sendRequest( request );
+        os.write( (const char*)data, len );
+
+        return session.receiveResponse( response );
+    }
+
+    // The buffer of the last response, unless it is still held (e.g. by a
+    // get_set_flat_response) or too large to keep
+    boost::shared_ptr<std::vector<uint8_t> > next_response_buffer()
+    {
+        if ( !response_buffer || !response_buffer.unique()
+             || ( response_buffer->capacity() > MAX_KEPT_RESPONSE_BYTES ) )
+            response_buffer.reset( new std::vector<uint8_t>() );
+        return response_buffer;
+    }
+};
+
+
+HTTPConnection::HTTPConnection( const std::string& gpudb_ip,
+                                const std::string& gpudb_port,
+                                int timeout_secs ) :
+    ip_( gpudb_ip ), port_( gpudb_port ),
+    state_( new state( gpudb_ip, (unsigned short)strtoul( gpudb_port.c_str(), NULL, 10 ), timeout_secs ) )
+{
+}
+
+
+HTTPConnection::~HTTPConnection()
+{
+    delete state_;
+}
+
+
+
+
 // ========================= HTTPUtils Member Functions =======================
 
 
 // Protected:
 // ----------
 
-/// Binary version of making a call to GPUdb using Poco::Net
+/// Send a request through the connection and read the whole response
 // static
-void HTTPUtils::poco_query( const std::string& ipaddr, const std::string& port,
-                            const std::string& endpoint,
-                            const std::string& req_json_data,
-                            std::string &output, int timeout_secs )
+void HTTPUtils::post( HTTPConnection& connection,
+                      const std::string& endpoint,
+                      const char* content_type,
+                      const void* data, size_t len,
+                      std::vector<uint8_t>& output,
+                      size_t response_size_hint,
+                      bool idempotent )
 {
+    HTTPConnection::state& s = *connection.state_;
     try
     {
-        // Convert the port to a number
-        std::istringstream port_iss( port );
-        unsigned short port_num;
-        port_iss >> port_num;
-
-        // Create the client session
-        Poco::Net::HTTPClientSession s( ipaddr, port_num );
-        s.setTimeout( Poco::Timespan( timeout_secs, 0 ) );
-        // Create the request packet
-        Poco::Net::HTTPRequest http_request(Poco::Net::HTTPRequest::HTTP_POST, endpoint);
-        // http_request.setContentType("application/octet-stream"); // binary
-        http_request.setContentType("application/json"); // json
-
-        // Write to stream (send the packet)
-        std::ostream& os = s.sendRequest( http_request );
-        os.write( (const char*)&req_json_data[0], req_json_data.size() );
-
-        // Receive the response
-        Poco::Net::HTTPResponse response;
-        std::istream& rs = s.receiveResponse( response );
-
-        //convert istream to string
-        output = "";
-        output.assign( std::istreambuf_iterator<char>(rs),
+        std::istream& rs = s.send( endpoint, content_type, data, len, idempotent );
+
+        // Size the buffer once, by the content length if the server sent
+        // one or else by the caller's hint, then read the response into it
+        std::streamsize content_length = s.response.getContentLength();
+        output.clear();
+        output.reserve( ( content_length > 0 ) ? (size_t)content_length : response_size_hint );
+        output.insert( output.end(), std::istreambuf_iterator<char>( rs ),
                        std::istreambuf_iterator<char>() );
     }
     catch (const std::exception& e)
     {
+        s.session.reset(); // reopened by the next call
         throw gpudb::NetworkException( e.what() );
     }
-} // end poco_query json format
-
+} // end post binary format
 
 
-/// Binary version of making a call to GPUdb using Poco::Net
+/// Send a request through the connection and read the whole response
 // static
-void HTTPUtils::poco_query( const std::string& ipaddr, const std::string& port,
-                 const std::string& endpoint,
-                 const std::vector<uint8_t>& req_binary_data,
-                 std::vector<uint8_t> &output,
-                 int timeout_secs )
+void HTTPUtils::post( HTTPConnection& connection,
+                      const std::string& endpoint,
+                      const char* content_type,
+                      const void* data, size_t len,
+                      std::string& output,
+                      bool idempotent )
 {
+    HTTPConnection::state& s = *connection.state_;
     try
     {
-        // Convert the port to a number
-        std::istringstream port_iss( port );
-        unsigned short port_num;
-        port_iss >> port_num;
-
-        // Create the client session
-        Poco::Net::HTTPClientSession s( ipaddr, port_num );
-        s.setTimeout( Poco::Timespan( timeout_secs, 0 ) );
-        // Create the request packet
-        Poco::Net::HTTPRequest http_request(Poco::Net::HTTPRequest::HTTP_POST, endpoint);
-        http_request.setContentType("application/octet-stream"); // binary
-        // http_request.setContentType("application/json"); // json
-
-        // Write to stream (send the packet)
-        std::ostream& os = s.sendRequest( http_request );
-        os.write( (const char*)&req_binary_data[0], req_binary_data.size() );
-
-        // Receive the response
-        Poco::Net::HTTPResponse response;
-        std::istream& rs = s.receiveResponse( response );
-
-        //convert istream to binary/char vector
-        output.assign( std::istreambuf_iterator<char>( rs ),
+        std::istream& rs = s.send( endpoint, content_type, data, len, idempotent );
+
+        std::streamsize content_length = s.response.getContentLength();
+        output.clear();
+        if ( content_length > 0 )
+            output.reserve( (size_t)content_length );
+        output.append( std::istreambuf_iterator<char>( rs ),
                        std::istreambuf_iterator<char>() );
     }
     catch (const std::exception& e)
     {
+        s.session.reset(); // reopened by the next call
         throw gpudb::NetworkException( e.what() );
     }
+} // end post json format
+
+
+
+/// Json version of making a call to GPUdb using Poco::Net
+// static
+void HTTPUtils::poco_query( const std::string& ipaddr, const std::string& port,
+                            const std::string& endpoint,
+                            const std::string& req_json_data,
+                            std::string &output, int timeout_secs )
+{
+    HTTPConnection connection( ipaddr, port, timeout_secs );
+    post( connection, endpoint, "application/json",
+          req_json_data.data(), req_json_data.size(), output );
+} // end poco_query json format
+
+
+
+/// Binary version of making a call to GPUdb using Poco::Net
+// static
+void HTTPUtils::poco_query( const std::string& ipaddr, const std::string& port,
+                 const std::string& endpoint,
+                 const std::vector<uint8_t>& req_binary_data,
+                 std::vector<uint8_t> &output,
+                 int timeout_secs,
+                 size_t response_size_hint )
+{
+    HTTPConnection connection( ipaddr, port, timeout_secs );
+    post( connection, endpoint, "application/octet-stream",
+          req_binary_data.data(), req_binary_data.size(), output, response_size_hint );
 } // end poco_query binary format
 
 
@@ -164,32 +329,45 @@ gpudb::gpudb_response HTTPUtils::call_gpudb( const std::string& json_data,
                                              const std::string& password,
                                              int timeout_secs )
 {
-    try
-    {
-        // Make the call and retrieve the response
-        std::string json_response;
-        poco_query( gpudb_ip, gpudb_port, endpoint, json_data, json_response );
-        // std::cout << "json response: " << json_response << std::endl;
-
+    HTTPConnection connection( gpudb_ip, gpudb_port, timeout_secs );
+    return call_gpudb( json_data, endpoint, connection );
+}  // end call_gpudb with IP address and port for JSON data
 
-        // Convert the GPUdb response to an object
-        gpudb::gpudb_response gresponse;
-        if ( gpudb::AvroUtils::convert_to_object( json_response, gresponse ) == false )
-        {
-            std::cout << "avro utils conversion ERROR encountered; response size: " << json_response.size() << std::endl; // debug ------
-            std::cout << "last 100 bytes: " << json_response.substr( json_response.size() - 100, 100 ) << std::endl; // debug ------------------
-            throw gpudb::QueryException( "Error: Unable to parse GPUdb response!\n" );
-        }
 
-        return gresponse;
-    }
-    catch (const std::exception& e)
-    {  // had a problem
-        throw;
+// Make an HTTP call to GPUdb through the connection with json encoding
+// static
+gpudb::gpudb_response HTTPUtils::call_gpudb( const std::string& json_data,
+                                             const std::string& endpoint,
+                                             HTTPConnection& connection,
+                                             bool idempotent )
+{
+    // Make the call and retrieve the response, into the connection's buffer
+    std::string& json_response = connection.state_->json_buffer;
+    post( connection, endpoint, "application/json", json_data.data(), json_data.size(), json_response,
+          idempotent );
+    // std::cout << "json response: " << json_response << std::endl;
+
+
+    // Convert the GPUdb response to an object
+    gpudb::gpudb_response gresponse;
+    gpudb::SchemaHandle response_schema = gpudb::AvroUtils::intern_schema( gpudb::gpudb_response::schema_str(),
+                                                                           gpudb::gpudb_response::fingerprint() );
+    if ( gpudb::AvroUtils::convert_to_object( json_response, response_schema, gresponse ) == false )
+    {
+        // Name the response's size and its end, where truncation shows
+        const size_t tail_size = 100;
+        std::ostringstream err;
+        err << "Error: Unable to parse GPUdb response of " << json_response.size() << " bytes";
+        if ( json_response.size() > tail_size )
+            err << " ending in: ..." << json_response.substr( json_response.size() - tail_size );
+        else
+            err << ": " << json_response;
+        err << "\n";
+        throw gpudb::QueryException( err.str() );
     }
 
-    return gpudb::gpudb_response(); // shouldn't get here when throwing
-}  // end call_gpudb with IP address and port for JSON data
+    return gresponse;
+}  // end call_gpudb with a connection for JSON data
 
 
 
@@ -227,6 +405,144 @@ gpudb::gpudb_response HTTPUtils::call_gpudb( const std::vector<uint8_t>& binary_
 
 
 
+// Make an HTTP call to GPUdb at gpudb_ip::gpudb_port with binary encoding and
+// decode the response as views into the received buffer, which the returned
+// object keeps alive
+//static
+gpudb::gpudb_response_view HTTPUtils::call_gpudb_view( const std::vector<uint8_t>& binary_data,
+                                                       const std::string& endpoint,
+                                                       const std::string& gpudb_ip,
+                                                       const std::string& gpudb_port,
+                                                       const std::string& username,
+                                                       const std::string& password,
+                                                       int timeout_secs,
+                                                       size_t response_size_hint )
+{
+    HTTPConnection connection( gpudb_ip, gpudb_port, timeout_secs );
+    return call_gpudb_view( binary_data, endpoint, connection, response_size_hint );
+}  // end call_gpudb_view
+
+
+// The same through a connection, whose last response buffer is reused if
+// nothing holds on to it any more
+//static
+gpudb::gpudb_response_view HTTPUtils::call_gpudb_view( const std::vector<uint8_t>& binary_data,
+                                                       const std::string& endpoint,
+                                                       HTTPConnection& connection,
+                                                       size_t response_size_hint,
+                                                       bool idempotent )
+{
+    // Make the call and retrieve the response
+    boost::shared_ptr<std::vector<uint8_t> > binary_response = connection.state_->next_response_buffer();
+    post( connection, endpoint, "application/octet-stream", binary_data.data(), binary_data.size(),
+          *binary_response, response_size_hint, idempotent );
+
+    // Decode the GPUdb response envelope without copying its data
+    gpudb::gpudb_response_view gresponse;
+    if ( gresponse.decode( binary_response ) == false )
+        throw gpudb::QueryException( "Unable to parse GPUdb response!\n" );
+
+    return gresponse;
+}  // end call_gpudb_view with a connection
+
+
+
+// Make an HTTP call to GPUdb at gpudb_ip::gpudb_port with binary encoding and
+// decode the response from the connection as it is received, the data by
+// data_decoder, so that the response is never held in memory as a whole
+//static
+gpudb::gpudb_response HTTPUtils::call_gpudb_stream( const std::vector<uint8_t>& binary_data,
+                                                    const std::string& endpoint,
+                                                    const std::string& gpudb_ip,
+                                                    const std::string& gpudb_port,
+                                                    ResponseStreamDecoder& data_decoder,
+                                                    const std::string& username,
+                                                    const std::string& password,
+                                                    int timeout_secs )
+{
+    HTTPConnection connection( gpudb_ip, gpudb_port, timeout_secs );
+    return call_gpudb_stream( binary_data, endpoint, connection, data_decoder );
+}  // end call_gpudb_stream
+
+
+//static
+gpudb::gpudb_response HTTPUtils::call_gpudb_stream( const std::vector<uint8_t>& binary_data,
+                                                    const std::string& endpoint,
+                                                    HTTPConnection& connection,
+                                                    ResponseStreamDecoder& data_decoder,
+                                                    bool idempotent )
+{
+    HTTPConnection::state& s = *connection.state_;
+    gpudb::gpudb_response gresponse;
+    try
+    {
+        // Send the request; the response is decoded a chunk at a time as it
+        // arrives, through the connection's buffer (so only the send, before
+        // any of it reaches the decoder, may be repeated)
+        std::istream& rs = s.send( endpoint, "application/octet-stream",
+                                   binary_data.data(), binary_data.size(), idempotent );
+        s.stream_buffer.resize( STREAM_CHUNK_SIZE );
+        istream_input_stream in( rs, s.stream_buffer );
+        gpudb::AvroBufferDecoder d;
+        d.init( in );
+
+        // The gpudb_response envelope, field by field
+        avro::decode( d, gresponse.status );
+        avro::decode( d, gresponse.message );
+        avro::decode( d, gresponse.data_type );
+
+        size_t data_size = (size_t)d.decodeLong(); // the bytes' length
+        if ( gresponse.status == "OK" )
+        {
+            // The decoder must read exactly the data, or the fields after
+            // it would be decoded from the wrong place
+            size_t data_start = (size_t)in.byteCount() - (size_t)( d.end() - d.position() );
+            data_decoder.decode( d, gresponse.data_type );
+            size_t data_read = (size_t)in.byteCount() - (size_t)( d.end() - d.position() ) - data_start;
+            if ( data_read != data_size )
+            {
+                std::ostringstream err;
+                err << "Unable to parse GPUdb response: its " << gresponse.data_type << " data is "
+                    << data_size << " bytes but " << data_read << " were decoded\n";
+                throw gpudb::QueryException( err.str() );
+            }
+        }
+        else
+            d.skipFixed( data_size );
+
+        avro::decode( d, gresponse.data_str );
+
+        // Leave nothing unread for the next request on the connection
+        rs.ignore( std::numeric_limits<std::streamsize>::max() );
+    }
+    catch (const Poco::Exception& e)
+    {
+        s.session.reset(); // reopened by the next call
+        throw gpudb::NetworkException( e.displayText() );
+    }
+    catch (const avro::Exception& e)
+    {
+        s.session.reset();
+        throw gpudb::QueryException( "Unable to parse GPUdb response!\n" );
+    }
+    catch (const std::exception& e)
+    {
+        // e.g. the data decoder's, or its misreading of the data; the
+        // response is only partly read, so the connection cannot be reused
+        s.session.reset();
+        throw;
+    }
+    catch (...)
+    {
+        s.session.reset();
+        throw;
+    }
+
+    return gresponse;
+}  // end call_gpudb_stream with a connection
+
+
+
 //  ------------------------ Convenience wrappers ---------------------------
 
 
@@ -6,11 +6,57 @@
 #include "AvroTypes.h"
 
 #include "obj_defs/gpudbresponse.h"
+#include "obj_defs/gpudbresponseview.h"
 
 
 namespace gpudb
 {
 
+class AvroBufferDecoder;
+
+
+/// Decodes the data of a binary encoded response as it is received from the
+/// connection, see HTTPUtils::call_gpudb_stream()
+class ResponseStreamDecoder
+{
+public:
+    virtual ~ResponseStreamDecoder() {}
+
+    // Decode all of the response's data, of the given data_type, from d
+    virtual void decode( AvroBufferDecoder& d, const std::string& data_type ) = 0;
+};
+
+
+
+/// A keep-alive HTTP connection to GPUdb, for the HTTPUtils calls that take
+/// one. The calls made through it reuse its socket, its address (the port is
+/// parsed once, here), its request and response headers and the buffers of
+/// the last response; a connection that failed is reopened by the next call.
+/// Not thread safe, each thread (or GPUdb handle) should have its own.
+class HTTPConnection
+{
+    friend class HTTPUtils;
+
+public:
+    HTTPConnection( const std::string& gpudb_ip,
+                    const std::string& gpudb_port,
+                    int timeout_secs = 60 );
+    ~HTTPConnection();
+
+    inline const std::string& ip() const   { return ip_; }
+    inline const std::string& port() const { return port_; }
+
+private:
+    struct state;
+
+    std::string ip_;
+    std::string port_;
+    state*      state_;
+
+    HTTPConnection( const HTTPConnection& );
+    HTTPConnection& operator=( const HTTPConnection& );
+};
+
 
 
 class HTTPUtils
@@ -41,6 +87,57 @@ public:
                                              const std::string& password = "",
                                              int timeout_secs = 60 );
 
+    // Make an HTTP call to GPUdb at gpudb_ip::gpudb_port with binary encoding;
+    // the response is decoded as views into the received buffer (not copied).
+    // The buffer is sized by response_size_hint when the server does not
+    // send the response's length, e.g. by EndpointTraits::expected_response_size
+    static gpudb::gpudb_response_view call_gpudb_view( const std::vector<uint8_t>& binary_data,
+                                                       const std::string& endpoint,
+                                                       const std::string& gpudb_ip,
+                                                       const std::string& gpudb_port,
+                                                       const std::string& username = "",
+                                                       const std::string& password = "",
+                                                       int timeout_secs = 60,
+                                                       size_t response_size_hint = 0 );
+
+    // Make an HTTP call to GPUdb at gpudb_ip::gpudb_port with binary encoding;
+    // the response's data is handed to data_decoder as it is received rather
+    // than after the whole response is (so the returned response's data is
+    // empty); only when its status is OK. Throws QueryException if the
+    // decoder does not read exactly the data's bytes, and passes on what the
+    // decoder throws; a connection is closed by either, to be reopened
+    static gpudb::gpudb_response call_gpudb_stream( const std::vector<uint8_t>& binary_data,
+                                                    const std::string& endpoint,
+                                                    const std::string& gpudb_ip,
+                                                    const std::string& gpudb_port,
+                                                    ResponseStreamDecoder& data_decoder,
+                                                    const std::string& username = "",
+                                                    const std::string& password = "",
+                                                    int timeout_secs = 60 );
+
+    // The same calls made through a connection, which is left open for the
+    // next (see HTTPConnection). An idempotent request (see
+    // EndpointTraits::idempotent) whose send fails on a connection kept
+    // alive from an earlier call is sent once more, on a new connection:
+    // the server may have closed the old one in the meantime
+
+    static gpudb::gpudb_response call_gpudb( const std::string& json_data,
+                                             const std::string& endpoint,
+                                             HTTPConnection& connection,
+                                             bool idempotent = false );
+
+    static gpudb::gpudb_response_view call_gpudb_view( const std::vector<uint8_t>& binary_data,
+                                                       const std::string& endpoint,
+                                                       HTTPConnection& connection,
+                                                       size_t response_size_hint = 0,
+                                                       bool idempotent = false );
+
+    static gpudb::gpudb_response call_gpudb_stream( const std::vector<uint8_t>& binary_data,
+                                                    const std::string& endpoint,
+                                                    HTTPConnection& connection,
+                                                    ResponseStreamDecoder& data_decoder,
+                                                    bool idempotent = false );
+
     // Convenience wrappers
 
     // Make an HTTP call to GPUdb at 127.0.0.1::gpudb_port with binary encoding
@@ -71,6 +168,25 @@ public:
 
 
 protected:
+    // Send the request through the connection and read all of the response
+    // into output, which is sized once (by the content length if the server
+    // sent one, else by response_size_hint); an idempotent request is sent
+    // again if the connection turns out to be closed
+    static void post( HTTPConnection& connection,
+                      const std::string& endpoint,
+                      const char* content_type,
+                      const void* data, size_t len,
+                      std::vector<uint8_t>& output,
+                      size_t response_size_hint = 0,
+                      bool idempotent = false );
+
+    static void post( HTTPConnection& connection,
+                      const std::string& endpoint,
+                      const char* content_type,
+                      const void* data, size_t len,
+                      std::string& output,
+                      bool idempotent = false );
+
     // Make a query to GPUdb using Poco::Net (json formatted data)
     static void poco_query( const std::string& ipaddr, const std::string& port,
                             const std::string& endpoint,
@@ -83,7 +199,8 @@ protected:
                             const std::string& endpoint,
                             const std::vector<uint8_t>& req_binary_data,
                             std::vector<uint8_t> &output,
-                            int timeout_secs = 60 );
+                            int timeout_secs = 60,
+                            size_t response_size_hint = 0 );
 
 
 }; // end class HTTPUtils
@@ -0,0 +1,215 @@
+#ifndef _JSON_SCANNER_H_
+#define _JSON_SCANNER_H_
+
+#include <stdint.h>
+#include <string.h>
+
+// The widest instruction set enabled at compile time is used, e.g. build
+// with -mavx2 (or -march=native) for the AVX2 version. SSE2 is always
+// available on x86-64; other platforms use the scalar version.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define GPUDB_JSON_SCANNER_AVX2
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+    #define GPUDB_JSON_SCANNER_SSE2
+#endif
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class JsonScanner Vectorized scanning primitives for json text.
+///        Each function examines 32 (AVX2) or 16 (SSE2) bytes at a time and
+///        finishes the tail of the buffer one byte at a time; none of them
+///        read at or past end.
+// --------------------------------------------------------------------------
+class JsonScanner
+{
+    JsonScanner();
+
+public:
+
+    /// The name of the instruction set the scanner was compiled for.
+    static inline const char* simd_name()
+    {
+#if defined(GPUDB_JSON_SCANNER_AVX2)
+        return "AVX2";
+#elif defined(GPUDB_JSON_SCANNER_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+    static inline bool is_ws(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    /// Find the first '"' or '\\' in [p, end), returns end if there is none.
+    static inline const char* find_quote_or_escape(const char* p, const char* end)
+    {
+#if defined(GPUDB_JSON_SCANNER_AVX2)
+        const __m256i quote  = _mm256_set1_epi8('"');
+        const __m256i escape = _mm256_set1_epi8('\\');
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i*)p);
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, escape)));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#elif defined(GPUDB_JSON_SCANNER_SSE2)
+        const __m128i quote  = _mm_set1_epi8('"');
+        const __m128i escape = _mm_set1_epi8('\\');
+        for (; end - p >= 16; p += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, escape)));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#endif
+        while (p < end && *p != '"' && *p != '\\')
+            ++p;
+        return p;
+    }
+
+    /// Find the first '"', '\\' or non-ascii byte in [p, end), returns end if there is none.
+    static inline const char* find_quote_escape_or_non_ascii(const char* p, const char* end)
+    {
+#if defined(GPUDB_JSON_SCANNER_AVX2)
+        const __m256i quote  = _mm256_set1_epi8('"');
+        const __m256i escape = _mm256_set1_epi8('\\');
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i*)p);
+            // the sign bit of each byte is set for non-ascii bytes
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+                _mm256_or_si256(v, _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, escape))));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#elif defined(GPUDB_JSON_SCANNER_SSE2)
+        const __m128i quote  = _mm_set1_epi8('"');
+        const __m128i escape = _mm_set1_epi8('\\');
+        for (; end - p >= 16; p += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(
+                _mm_or_si128(v, _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, escape))));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#endif
+        while (p < end && *p != '"' && *p != '\\' && (uint8_t)*p < 0x80)
+            ++p;
+        return p;
+    }
+
+    /// Find the first '"', '{', '}', '[' or ']' in [p, end), returns end if there is none.
+    static inline const char* find_structural(const char* p, const char* end)
+    {
+#if defined(GPUDB_JSON_SCANNER_AVX2)
+        // Setting bit 0x20 turns '[' and ']' into '{' and '}', and nothing else into either
+        const __m256i lower  = _mm256_set1_epi8(0x20);
+        const __m256i open   = _mm256_set1_epi8('{');
+        const __m256i close  = _mm256_set1_epi8('}');
+        const __m256i quote  = _mm256_set1_epi8('"');
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i*)p);
+            __m256i folded = _mm256_or_si256(v, lower);
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, open), _mm256_cmpeq_epi8(folded, close)),
+                                _mm256_cmpeq_epi8(v, quote)));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#elif defined(GPUDB_JSON_SCANNER_SSE2)
+        const __m128i lower  = _mm_set1_epi8(0x20);
+        const __m128i open   = _mm_set1_epi8('{');
+        const __m128i close  = _mm_set1_epi8('}');
+        const __m128i quote  = _mm_set1_epi8('"');
+        for (; end - p >= 16; p += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            __m128i folded = _mm_or_si128(v, lower);
+            uint32_t mask = (uint32_t)_mm_movemask_epi8(
+                _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                             _mm_cmpeq_epi8(v, quote)));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#endif
+        while (p < end && *p != '"' && (*p | 0x20) != '{' && (*p | 0x20) != '}')
+            ++p;
+        return p;
+    }
+
+    /// Skip json whitespace, returns the first other character or end.
+    static inline const char* skip_ws(const char* p, const char* end)
+    {
+        // Records are usually compact, so check the first byte before going wide
+        if (p == end || !is_ws(*p))
+            return p;
+#if defined(GPUDB_JSON_SCANNER_AVX2)
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i nl    = _mm256_set1_epi8('\n');
+        const __m256i cr    = _mm256_set1_epi8('\r');
+        const __m256i tab   = _mm256_set1_epi8('\t');
+        for (; end - p >= 32; p += 32)
+        {
+            __m256i v = _mm256_loadu_si256((const __m256i*)p);
+            __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, nl)),
+                                         _mm256_or_si256(_mm256_cmpeq_epi8(v, cr),    _mm256_cmpeq_epi8(v, tab)));
+            uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(ws);
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#elif defined(GPUDB_JSON_SCANNER_SSE2)
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i nl    = _mm_set1_epi8('\n');
+        const __m128i cr    = _mm_set1_epi8('\r');
+        const __m128i tab   = _mm_set1_epi8('\t');
+        for (; end - p >= 16; p += 16)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)p);
+            __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, nl)),
+                                      _mm_or_si128(_mm_cmpeq_epi8(v, cr),    _mm_cmpeq_epi8(v, tab)));
+            uint32_t mask = ~(uint32_t)_mm_movemask_epi8(ws) & 0xFFFF;
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+#endif
+        while (p < end && is_ws(*p))
+            ++p;
+        return p;
+    }
+
+    /// True if the eight bytes at p are all ascii digits, p+8 MUST be <= end.
+    static inline bool is_eight_digits(const char* p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        // each byte must be 0x30..0x39: the high nibble is 3 and adding 6 stays below 0x40
+        return ((v & 0xF0F0F0F0F0F0F0F0ULL) |
+                (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+    }
+
+    /// Parse eight ascii digits at p (see is_eight_digits()) with three
+    /// multiplications rather than eight (SWAR, little-endian hosts).
+    static inline uint32_t parse_eight_digits(const char* p)
+    {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;             // pairs of digits
+        v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;         // groups of four
+        return (uint32_t)(((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+    }
+};
+
+} // end namespace gpudb
+
+#endif
@@ -0,0 +1,167 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+
+namespace gpudb
+{
+
+const size_t WorkerPool::ItemTask::NONE;
+
+struct WorkerPool::state
+{
+    std::mutex               run_mutex; ///< Serializes run()
+    std::mutex               mutex;     ///< Guards the rest
+    std::condition_variable  work_ready;
+    std::condition_variable  work_done;
+    std::vector<std::thread> threads;
+
+    // The current run
+    Task*               task;
+    size_t              n;
+    size_t              grain;
+    std::atomic<size_t> next;       ///< The start of the next range to take
+    size_t              generation; ///< Incremented by each run
+    size_t              busy;       ///< Workers yet to finish the run
+    bool                stop;
+    std::exception_ptr  error;
+
+    state() : task(NULL), n(0), grain(1), next(0), generation(0), busy(0), stop(false) { }
+
+    // Take ranges until there are none left.
+    void work()
+    {
+        for (;;)
+        {
+            size_t begin = next.fetch_add(grain);
+            if (begin >= n)
+                return;
+
+            try
+            {
+                task->run(begin, std::min(n, begin + grain));
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    }
+
+    void stop_workers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        work_ready.notify_all();
+
+        for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+    }
+
+    void worker_loop()
+    {
+        size_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (!stop && (generation == seen))
+                    work_ready.wait(lock);
+                if (stop)
+                    return;
+                seen = generation;
+            }
+
+            work();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0)
+                work_done.notify_one();
+        }
+    }
+};
+
+
+WorkerPool::WorkerPool(size_t num_threads) :
+    state_(new state()), num_threads_(std::max(num_threads, (size_t)1))
+{
+    try
+    {
+        for (size_t i = 1; i < num_threads_; ++i)
+            state_->threads.push_back(std::thread(&state::worker_loop, state_));
+    }
+    catch (...)
+    {
+        state_->stop_workers(); // the threads that did start
+        delete state_;
+        throw;
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    state_->stop_workers();
+    delete state_;
+}
+
+void WorkerPool::run(Task& task, size_t n, size_t grain)
+{
+    grain = std::max(grain, (size_t)1);
+    if (state_->threads.empty() || (n <= grain))
+    {
+        task.run(0, n); // not worth waking anyone
+        return;
+    }
+
+    std::lock_guard<std::mutex> run_lock(state_->run_mutex);
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->task = &task;
+        state_->n = n;
+        state_->grain = grain;
+        state_->next = 0;
+        state_->busy = state_->threads.size();
+        state_->error = std::exception_ptr();
+        ++state_->generation;
+    }
+    state_->work_ready.notify_all();
+
+    state_->work();
+
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        while (state_->busy > 0)
+            state_->work_done.wait(lock);
+        state_->task = NULL;
+        std::swap(error, state_->error);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+//static
+WorkerPool& WorkerPool::shared()
+{
+    // Never destroyed, so it outlives any static object that uses it
+    static WorkerPool* pool = new WorkerPool(hardware_threads());
+    return *pool;
+}
+
+//static
+size_t WorkerPool::hardware_threads()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+} // end namespace gpudb
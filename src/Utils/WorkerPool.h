@@ -0,0 +1,137 @@
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+#include <stddef.h>
+#include <vector>
+
+
+namespace gpudb
+{
+
+// --------------------------------------------------------------------------
+/// @class WorkerPool A fixed set of threads that run a task over the items
+///        [0, n) in ranges, e.g. encoding the objects of a bulk_add.
+///
+///        The calling thread works on the ranges too, and run() returns when
+///        all of them are done, so a pool of one thread has no workers and
+///        runs everything on the caller. Runs of the same pool are serialized.
+// --------------------------------------------------------------------------
+class WorkerPool
+{
+public:
+
+    /// The work for run(), called from several threads at once.
+    class Task
+    {
+    public:
+        virtual ~Task() { }
+
+        /// Process the items [begin, end).
+        virtual void run(size_t begin, size_t end) = 0;
+    };
+
+    class ItemTask;
+
+    /// Start num_threads - 1 worker threads.
+    explicit WorkerPool(size_t num_threads);
+
+    /// Stop and join the workers.
+    ~WorkerPool();
+
+    inline size_t num_threads() const { return num_threads_; }
+
+    /// Run the task over the items [0, n) in ranges of grain items and wait
+    /// for them all. Rethrows the first exception a range throws, once the
+    /// other ranges are done.
+    void run(Task& task, size_t n, size_t grain);
+
+    /// A pool of hardware_threads() threads shared by the whole process,
+    /// started on first use.
+    static WorkerPool& shared();
+
+    /// The number of threads the machine runs concurrently, at least 1.
+    static size_t hardware_threads();
+
+private:
+
+    struct state;
+
+    state* state_;
+    size_t num_threads_;
+
+    WorkerPool(const WorkerPool&);
+    WorkerPool& operator=(const WorkerPool&);
+};
+
+
+// --------------------------------------------------------------------------
+/// @class WorkerPool::ItemTask A task over items that may each fail, e.g.
+///        objects that do not match their schema.
+///
+///        Each range notes its first failed item, so first_failed() is the
+///        item a serial loop would have stopped at, however the ranges ran.
+// --------------------------------------------------------------------------
+class WorkerPool::ItemTask : public WorkerPool::Task
+{
+public:
+
+    static const size_t NONE = (size_t)-1;
+
+    ItemTask(size_t num_items, size_t grain) :
+        num_items_(num_items), grain_(grain), failed_((num_items + grain - 1) / grain, NONE) { }
+
+    inline size_t size() const  { return num_items_; }
+    inline size_t grain() const { return grain_; }
+
+    virtual void run(size_t begin, size_t end)
+    {
+        size_t i = begin;
+        try
+        {
+            process(i, end);
+        }
+        catch (...)
+        {
+            // Item i threw, which counts as its failure
+        }
+
+        if (i < end)
+            failed_[begin / grain_] = i;
+    }
+
+    /// Run the task on the pool, or on the calling thread if pool is NULL.
+    inline void run_on(WorkerPool* pool)
+    {
+        if (pool != NULL)
+            pool->run(*this, num_items_, grain_);
+        else
+            run(0, num_items_);
+    }
+
+    /// The lowest item that failed, or NONE.
+    size_t first_failed() const
+    {
+        for (size_t r = 0; r < failed_.size(); ++r)
+        {
+            if (failed_[r] != NONE)
+                return failed_[r];
+        }
+        return NONE;
+    }
+
+protected:
+
+    /// Process the items from i up to end, advancing i past each one that
+    /// succeeds; return early (or throw) with i at the first that fails.
+    virtual void process(size_t& i, size_t end) = 0;
+
+private:
+
+    size_t              num_items_;
+    size_t              grain_;
+    std::vector<size_t> failed_; ///< The first failed item of each range
+};
+
+} // end namespace gpudb
+
+#endif
@@ -33,6 +33,11 @@ struct actor_list {
 
     inline actor_list() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        list.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(list); }
 
@@ -40,6 +45,9 @@ struct actor_list {
             AvroUtils::get_binary_encoded_size(list)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(list); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("actor_list");
@@ -50,6 +58,17 @@ struct actor_list {
         static const std::string str("{\"type\":\"record\",\"name\":\"actor_list\",\"fields\":[{\"name\":\"list\",\"type\":{\"type\":\"array\",\"items\":\"bytes\"}}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xd1bb28a78bd7dd2dULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -41,6 +41,19 @@ struct actor_object {
 
     inline actor_object()  : process_rank(0),thread_id(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        process_rank = 0;
+        thread_id = 0;
+        actor_type.clear();
+        actor_id.clear();
+        actor_values.clear();
+        machine.clear();
+        address_add.clear();
+        address_get.clear();
+        address_get_sms.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(process_rank)+
             AvroUtils::get_min_binary_encoded_size(thread_id)+
@@ -64,6 +77,17 @@ struct actor_object {
             AvroUtils::get_binary_encoded_size(address_get_sms)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(process_rank)+
+            AvroUtils::get_exact_encoded_size(thread_id)+
+            AvroUtils::get_exact_encoded_size(actor_type)+
+            AvroUtils::get_exact_encoded_size(actor_id)+
+            AvroUtils::get_exact_encoded_size(actor_values)+
+            AvroUtils::get_exact_encoded_size(machine)+
+            AvroUtils::get_exact_encoded_size(address_add)+
+            AvroUtils::get_exact_encoded_size(address_get)+
+            AvroUtils::get_exact_encoded_size(address_get_sms); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("actor_object");
@@ -74,6 +98,17 @@ struct actor_object {
         static const std::string str("{\"type\":\"record\",\"name\":\"actor_object\",\"fields\":[{\"name\":\"process_rank\",\"type\":\"int\"},{\"name\":\"thread_id\",\"type\":\"int\"},{\"name\":\"actor_type\",\"type\":\"string\"},{\"name\":\"actor_id\",\"type\":\"string\"},{\"name\":\"actor_values\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"machine\",\"type\":\"string\"},{\"name\":\"address_add\",\"type\":\"string\"},{\"name\":\"address_get\",\"type\":\"string\"},{\"name\":\"address_get_sms\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x882fbc72eb2c7e22ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
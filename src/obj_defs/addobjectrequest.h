@@ -37,6 +37,15 @@ struct add_object_request {
 
     inline add_object_request() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+        object_data.clear();
+        object_data_str.clear();
+        object_encoding.clear();
+        params.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id)+
             AvroUtils::get_min_binary_encoded_size(object_data)+
@@ -52,6 +61,13 @@ struct add_object_request {
             AvroUtils::get_binary_encoded_size(params)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(object_data)+
+            AvroUtils::get_exact_encoded_size(object_data_str)+
+            AvroUtils::get_exact_encoded_size(object_encoding)+
+            AvroUtils::get_exact_encoded_size(params); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("add_object_request");
@@ -62,6 +78,17 @@ struct add_object_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"add_object_request\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"object_data\",\"type\":\"bytes\"},{\"name\":\"object_data_str\",\"type\":\"string\"},{\"name\":\"object_encoding\",\"type\":\"string\"},{\"name\":\"params\",\"type\":{\"type\":\"map\",\"values\":\"string\"}}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x235c9800890af0f8ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -41,6 +41,19 @@ struct bounding_box_request {
 
     inline bounding_box_request()  : min_x(0),max_x(0),min_y(0),max_y(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        min_x = 0;
+        max_x = 0;
+        min_y = 0;
+        max_y = 0;
+        x_attr_name.clear();
+        y_attr_name.clear();
+        set_id.clear();
+        result_set_id.clear();
+        user_auth_string.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(min_x)+
             AvroUtils::get_min_binary_encoded_size(max_x)+
@@ -64,6 +77,17 @@ struct bounding_box_request {
             AvroUtils::get_binary_encoded_size(user_auth_string)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(min_x)+
+            AvroUtils::get_exact_encoded_size(max_x)+
+            AvroUtils::get_exact_encoded_size(min_y)+
+            AvroUtils::get_exact_encoded_size(max_y)+
+            AvroUtils::get_exact_encoded_size(x_attr_name)+
+            AvroUtils::get_exact_encoded_size(y_attr_name)+
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(result_set_id)+
+            AvroUtils::get_exact_encoded_size(user_auth_string); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("bounding_box_request");
@@ -74,6 +98,17 @@ struct bounding_box_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"bounding_box_request\",\"fields\":[{\"name\":\"min_x\",\"type\":\"double\"},{\"name\":\"max_x\",\"type\":\"double\"},{\"name\":\"min_y\",\"type\":\"double\"},{\"name\":\"max_y\",\"type\":\"double\"},{\"name\":\"x_attr_name\",\"type\":\"string\"},{\"name\":\"y_attr_name\",\"type\":\"string\"},{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"result_set_id\",\"type\":\"string\"},{\"name\":\"user_auth_string\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x4592db778d55c652ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -33,6 +33,11 @@ struct bounding_box_response {
 
     inline bounding_box_response()  : count(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        count = 0;
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(count); }
 
@@ -40,6 +45,9 @@ struct bounding_box_response {
             AvroUtils::get_binary_encoded_size(count)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(count); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("bounding_box_response");
@@ -50,6 +58,17 @@ struct bounding_box_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"bounding_box_response\",\"fields\":[{\"name\":\"count\",\"type\":\"long\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x570bb659b32763c0ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -37,6 +37,15 @@ struct bulk_add_request {
 
     inline bulk_add_request() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+        list.clear();
+        list_str.clear();
+        list_encoding.clear();
+        params.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id)+
             AvroUtils::get_min_binary_encoded_size(list)+
@@ -52,6 +61,13 @@ struct bulk_add_request {
             AvroUtils::get_binary_encoded_size(params)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(list)+
+            AvroUtils::get_exact_encoded_size(list_str)+
+            AvroUtils::get_exact_encoded_size(list_encoding)+
+            AvroUtils::get_exact_encoded_size(params); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("bulk_add_request");
@@ -62,6 +78,17 @@ struct bulk_add_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"bulk_add_request\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"list\",\"type\":{\"type\":\"array\",\"items\":\"bytes\"}},{\"name\":\"list_str\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"list_encoding\",\"type\":\"string\"},{\"name\":\"params\",\"type\":{\"type\":\"map\",\"values\":\"string\"}}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xe610b5229f135ea6ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -35,6 +35,13 @@ struct bulk_add_response {
 
     inline bulk_add_response()  : count_inserted(0),count_updated(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        OBJECT_IDs.clear();
+        count_inserted = 0;
+        count_updated = 0;
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(OBJECT_IDs)+
             AvroUtils::get_min_binary_encoded_size(count_inserted)+
@@ -46,6 +53,11 @@ struct bulk_add_response {
             AvroUtils::get_binary_encoded_size(count_updated)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(OBJECT_IDs)+
+            AvroUtils::get_exact_encoded_size(count_inserted)+
+            AvroUtils::get_exact_encoded_size(count_updated); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("bulk_add_response");
@@ -56,6 +68,17 @@ struct bulk_add_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"bulk_add_response\",\"fields\":[{\"name\":\"OBJECT_IDs\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"count_inserted\",\"type\":\"int\"},{\"name\":\"count_updated\",\"type\":\"int\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x9c3247bca101077aULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
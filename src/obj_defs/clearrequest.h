@@ -34,6 +34,12 @@ struct clear_request {
 
     inline clear_request() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+        authorization.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id)+
             AvroUtils::get_min_binary_encoded_size(authorization); }
@@ -43,6 +49,10 @@ struct clear_request {
             AvroUtils::get_binary_encoded_size(authorization)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(authorization); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("clear_request");
@@ -53,6 +63,17 @@ struct clear_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"clear_request\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"authorization\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xd550bd5edf7b8af3ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -34,6 +34,12 @@ struct clear_response {
 
     inline clear_response() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        status.clear();
+        set_id.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(status)+
             AvroUtils::get_min_binary_encoded_size(set_id); }
@@ -43,6 +49,10 @@ struct clear_response {
             AvroUtils::get_binary_encoded_size(set_id)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(status)+
+            AvroUtils::get_exact_encoded_size(set_id); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("clear_response");
@@ -53,6 +63,17 @@ struct clear_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"clear_response\",\"fields\":[{\"name\":\"status\",\"type\":\"string\"},{\"name\":\"set_id\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xfd855ed153a195b9ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -33,6 +33,11 @@ struct filter_by_string_response {
 
     inline filter_by_string_response()  : count(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        count = 0;
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(count); }
 
@@ -40,6 +45,9 @@ struct filter_by_string_response {
             AvroUtils::get_binary_encoded_size(count)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(count); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("filter_by_string_response");
@@ -50,6 +58,17 @@ struct filter_by_string_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"filter_by_string_response\",\"fields\":[{\"name\":\"count\",\"type\":\"long\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xf1383d06b459b585ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
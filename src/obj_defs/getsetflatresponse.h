@@ -0,0 +1,108 @@
+#ifndef GETSETFLATRESPONSE_H_
+#define GETSETFLATRESPONSE_H_
+
+
+#include "../Utils/AvroUtils.h"
+#include "../Utils/AvroArena.h"
+#include "getsetresponse.h"
+#include "gpudbresponseview.h"
+#include "avro/Specific.hh"
+#include "avro/Encoder.hh"
+#include "avro/Decoder.hh"
+
+namespace gpudb {
+
+/// The /getset response (the same schema as get_set_response) with the object
+/// list and the ids each decoded into a single AvroArena, so decoding a page
+/// costs a handful of allocations rather than one or more per object.
+///
+/// When decoded by GPUdb::get_set() in BINARY encoding the arenas are views
+/// into the received response, which buffer keeps alive, and nothing is copied.
+struct get_set_flat_response {
+    boost::shared_ptr<const std::vector<uint8_t> > buffer;
+    AvroArena list;
+    AvroArena list_str;
+    AvroArena type_ids;
+    std::string set_id;
+    AvroArena object_ids;
+
+    inline get_set_flat_response() {}
+
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        buffer.reset();
+        list.clear();
+        list_str.clear();
+        type_ids.clear();
+        set_id.clear();
+        object_ids.clear();
+    }
+
+    /// The number of objects in the response.
+    inline size_t size() const { return list.empty() ? list_str.size() : list.size(); }
+
+    /// True if the decoder is reading buffer, so the arenas can view it.
+    inline bool is_reading_buffer(const avro::Decoder& d) const
+    {
+        const AvroBufferDecoder* bd = dynamic_cast<const AvroBufferDecoder*>(&d);
+        if ((bd == NULL) || !buffer || buffer->empty())
+            return false;
+        const uint8_t* begin = &(*buffer)[0];
+        return (bd->position() >= begin) && (bd->end() <= begin + buffer->size());
+    }
+
+    static const std::string& schema_name(void)
+    {
+        return get_set_response::schema_name();
+    }
+    static const std::string& schema_str(void)
+    {
+        return get_set_response::schema_str();
+    }
+    static uint64_t fingerprint(void)
+    {
+        return get_set_response::fingerprint();
+    }
+    static const avro::ValidSchema& schema(void)
+    {
+        return get_set_response::schema();
+    }
+
+};
+
+inline void set_response_buffer(get_set_flat_response& response, const boost::shared_ptr<const std::vector<uint8_t> >& buffer)
+{
+    response.buffer = buffer;
+}
+
+}
+namespace avro {
+template<> struct codec_traits<gpudb::get_set_flat_response> {
+    static void encode(Encoder& e, const gpudb::get_set_flat_response& v) {
+        v.list.encode(e, false);
+        v.list_str.encode(e, true);
+        v.type_ids.encode(e, true);
+        avro::encode(e, v.set_id);
+        v.object_ids.encode(e, true);
+    }
+    static void decode(Decoder& d, gpudb::get_set_flat_response& v) {
+        if (v.is_reading_buffer(d)) {
+            gpudb::AvroBufferDecoder& bd = static_cast<gpudb::AvroBufferDecoder&>(d);
+            v.list.decode_views(bd, v.buffer);
+            v.list_str.decode_views(bd, v.buffer);
+            v.type_ids.decode_views(bd, v.buffer);
+            avro::decode(d, v.set_id);
+            v.object_ids.decode_views(bd, v.buffer);
+            return;
+        }
+        v.buffer.reset();
+        v.list.decode(d, false);
+        v.list_str.decode(d, true);
+        v.type_ids.decode(d, true);
+        avro::decode(d, v.set_id);
+        v.object_ids.decode(d, true);
+    }
+};
+
+}
+#endif
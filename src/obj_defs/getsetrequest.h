@@ -37,6 +37,15 @@ struct get_set_request {
 
     inline get_set_request()  : start(0),end(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        start = 0;
+        end = 0;
+        set_id.clear();
+        semantic_type.clear();
+        user_auth_string.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(start)+
             AvroUtils::get_min_binary_encoded_size(end)+
@@ -52,6 +61,13 @@ struct get_set_request {
             AvroUtils::get_binary_encoded_size(user_auth_string)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(start)+
+            AvroUtils::get_exact_encoded_size(end)+
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(semantic_type)+
+            AvroUtils::get_exact_encoded_size(user_auth_string); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("get_set_request");
@@ -62,6 +78,17 @@ struct get_set_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"get_set_request\",\"fields\":[{\"name\":\"start\",\"type\":\"long\"},{\"name\":\"end\",\"type\":\"long\"},{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"semantic_type\",\"type\":\"string\"},{\"name\":\"user_auth_string\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x02ddaed8601044e6ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
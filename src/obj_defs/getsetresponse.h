@@ -37,6 +37,15 @@ struct get_set_response {
 
     inline get_set_response() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        list.clear();
+        list_str.clear();
+        type_ids.clear();
+        set_id.clear();
+        object_ids.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(list)+
             AvroUtils::get_min_binary_encoded_size(list_str)+
@@ -52,6 +61,13 @@ struct get_set_response {
             AvroUtils::get_binary_encoded_size(object_ids)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(list)+
+            AvroUtils::get_exact_encoded_size(list_str)+
+            AvroUtils::get_exact_encoded_size(type_ids)+
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(object_ids); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("get_set_response");
@@ -62,6 +78,17 @@ struct get_set_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"get_set_response\",\"fields\":[{\"name\":\"list\",\"type\":{\"type\":\"array\",\"items\":\"bytes\"}},{\"name\":\"list_str\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"type_ids\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"object_ids\",\"type\":{\"type\":\"array\",\"items\":\"string\"}}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xda36b4f0e5026452ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
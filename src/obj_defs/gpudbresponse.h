@@ -37,6 +37,15 @@ struct gpudb_response {
 
     inline gpudb_response() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        status.clear();
+        message.clear();
+        data_type.clear();
+        data.clear();
+        data_str.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(status)+
             AvroUtils::get_min_binary_encoded_size(message)+
@@ -52,6 +61,13 @@ struct gpudb_response {
             AvroUtils::get_binary_encoded_size(data_str)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(status)+
+            AvroUtils::get_exact_encoded_size(message)+
+            AvroUtils::get_exact_encoded_size(data_type)+
+            AvroUtils::get_exact_encoded_size(data)+
+            AvroUtils::get_exact_encoded_size(data_str); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("gpudb_response");
@@ -62,6 +78,17 @@ struct gpudb_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"gpudb_response\",\"fields\":[{\"name\":\"status\",\"type\":\"string\"},{\"name\":\"message\",\"type\":\"string\"},{\"name\":\"data_type\",\"type\":\"string\"},{\"name\":\"data\",\"type\":\"bytes\"},{\"name\":\"data_str\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xd21dcd5417a3af31ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
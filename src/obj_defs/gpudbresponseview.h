@@ -0,0 +1,73 @@
+#ifndef GPUDBRESPONSEVIEW_H_
+#define GPUDBRESPONSEVIEW_H_
+
+
+#include "../Utils/AvroUtils.h"
+#include "../Utils/AvroBufferDecoder.h"
+#include "../Utils/BytesView.h"
+#include "gpudbresponse.h"
+#include "boost/shared_ptr.hpp"
+#include "avro/Exception.hh"
+
+namespace gpudb {
+
+/// The gpudb_response envelope decoded as views into the received buffer,
+/// which it keeps alive, so the payload in data is not copied; the endpoint
+/// response is decoded straight from it.
+struct gpudb_response_view {
+    boost::shared_ptr<const std::vector<uint8_t> > buffer;
+    bytes_view status;
+    bytes_view message;
+    bytes_view data_type;
+    bytes_view data;
+    bytes_view data_str;
+
+    inline gpudb_response_view() {}
+
+    /// Decode the binary encoded gpudb_response in buffer; false if it is invalid.
+    bool decode(const boost::shared_ptr<const std::vector<uint8_t> >& buf)
+    {
+        buffer = buf;
+        try
+        {
+            AvroBufferDecoder d(buf->empty() ? NULL : &(*buf)[0], buf->size());
+            status    = d.decode_bytes_view();
+            message   = d.decode_bytes_view();
+            data_type = d.decode_bytes_view();
+            data      = d.decode_bytes_view();
+            data_str  = d.decode_bytes_view();
+        }
+        catch (const avro::Exception& e)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    static const std::string& schema_name(void)
+    {
+        return gpudb_response::schema_name();
+    }
+    static const std::string& schema_str(void)
+    {
+        return gpudb_response::schema_str();
+    }
+    static uint64_t fingerprint(void)
+    {
+        return gpudb_response::fingerprint();
+    }
+    static const avro::ValidSchema& schema(void)
+    {
+        return gpudb_response::schema();
+    }
+
+};
+
+/// Let an endpoint response that holds views into the received buffer (e.g.
+/// get_set_flat_response) keep the buffer alive; other responses copy what
+/// they decode and ignore it.
+template <class T>
+inline void set_response_buffer(T& response, const boost::shared_ptr<const std::vector<uint8_t> >& buffer) {}
+
+}
+#endif
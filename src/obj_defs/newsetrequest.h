@@ -35,6 +35,13 @@ struct new_set_request {
 
     inline new_set_request() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+        parent_set_id.clear();
+        type_id.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id)+
             AvroUtils::get_min_binary_encoded_size(parent_set_id)+
@@ -46,6 +53,11 @@ struct new_set_request {
             AvroUtils::get_binary_encoded_size(type_id)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(parent_set_id)+
+            AvroUtils::get_exact_encoded_size(type_id); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("new_set_request");
@@ -56,6 +68,17 @@ struct new_set_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"new_set_request\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"parent_set_id\",\"type\":\"string\"},{\"name\":\"type_id\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xc35f0b0fc446e38fULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
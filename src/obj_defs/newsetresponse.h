@@ -34,6 +34,12 @@ struct new_set_response {
 
     inline new_set_response()  : sorted(false) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        type_id.clear();
+        sorted = false;
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(type_id)+
             AvroUtils::get_min_binary_encoded_size(sorted); }
@@ -43,6 +49,10 @@ struct new_set_response {
             AvroUtils::get_binary_encoded_size(sorted)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(type_id)+
+            AvroUtils::get_exact_encoded_size(sorted); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("new_set_response");
@@ -53,6 +63,17 @@ struct new_set_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"new_set_response\",\"fields\":[{\"name\":\"type_id\",\"type\":\"string\"},{\"name\":\"sorted\",\"type\":\"boolean\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x13c7567ded79cf40ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
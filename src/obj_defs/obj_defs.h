@@ -209,402 +209,601 @@ namespace gpudb {
  
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::actor_list>(const gpudb::actor_list& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::actor_list>(const gpudb::actor_list& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::actor_list>(const gpudb::actor_list& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::actor_object>(const gpudb::actor_object& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::actor_object>(const gpudb::actor_object& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::actor_object>(const gpudb::actor_object& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::add_object_request>(const gpudb::add_object_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::add_object_request>(const gpudb::add_object_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::add_object_request>(const gpudb::add_object_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::add_object_response>(const gpudb::add_object_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::add_object_response>(const gpudb::add_object_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::add_object_response>(const gpudb::add_object_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::add_string_hash_request>(const gpudb::add_string_hash_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::add_string_hash_request>(const gpudb::add_string_hash_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::add_string_hash_request>(const gpudb::add_string_hash_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::add_string_hash_response>(const gpudb::add_string_hash_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::add_string_hash_response>(const gpudb::add_string_hash_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::add_string_hash_response>(const gpudb::add_string_hash_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::add_symbol_request>(const gpudb::add_symbol_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::add_symbol_request>(const gpudb::add_symbol_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::add_symbol_request>(const gpudb::add_symbol_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::add_symbol_response>(const gpudb::add_symbol_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::add_symbol_response>(const gpudb::add_symbol_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::add_symbol_response>(const gpudb::add_symbol_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::authenticate_users_request>(const gpudb::authenticate_users_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::authenticate_users_request>(const gpudb::authenticate_users_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::authenticate_users_request>(const gpudb::authenticate_users_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::authenticate_users_response>(const gpudb::authenticate_users_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::authenticate_users_response>(const gpudb::authenticate_users_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::authenticate_users_response>(const gpudb::authenticate_users_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bounding_box_request>(const gpudb::bounding_box_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bounding_box_request>(const gpudb::bounding_box_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bounding_box_request>(const gpudb::bounding_box_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bounding_box_response>(const gpudb::bounding_box_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bounding_box_response>(const gpudb::bounding_box_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bounding_box_response>(const gpudb::bounding_box_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bulk_add_internal_request>(const gpudb::bulk_add_internal_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bulk_add_internal_request>(const gpudb::bulk_add_internal_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bulk_add_internal_request>(const gpudb::bulk_add_internal_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bulk_add_request>(const gpudb::bulk_add_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bulk_add_request>(const gpudb::bulk_add_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bulk_add_request>(const gpudb::bulk_add_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bulk_add_response>(const gpudb::bulk_add_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bulk_add_response>(const gpudb::bulk_add_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bulk_add_response>(const gpudb::bulk_add_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bulk_update_request>(const gpudb::bulk_update_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bulk_update_request>(const gpudb::bulk_update_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bulk_update_request>(const gpudb::bulk_update_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::bulk_update_response>(const gpudb::bulk_update_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::bulk_update_response>(const gpudb::bulk_update_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::bulk_update_response>(const gpudb::bulk_update_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::clear_auth_cache_request>(const gpudb::clear_auth_cache_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::clear_auth_cache_request>(const gpudb::clear_auth_cache_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::clear_auth_cache_request>(const gpudb::clear_auth_cache_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::clear_auth_cache_response>(const gpudb::clear_auth_cache_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::clear_auth_cache_response>(const gpudb::clear_auth_cache_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::clear_auth_cache_response>(const gpudb::clear_auth_cache_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::clear_request>(const gpudb::clear_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::clear_request>(const gpudb::clear_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::clear_request>(const gpudb::clear_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::clear_response>(const gpudb::clear_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::clear_response>(const gpudb::clear_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::clear_response>(const gpudb::clear_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::clear_trigger_request>(const gpudb::clear_trigger_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::clear_trigger_request>(const gpudb::clear_trigger_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::clear_trigger_request>(const gpudb::clear_trigger_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::clear_trigger_response>(const gpudb::clear_trigger_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::clear_trigger_response>(const gpudb::clear_trigger_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::clear_trigger_response>(const gpudb::clear_trigger_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::convex_hull_request>(const gpudb::convex_hull_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::convex_hull_request>(const gpudb::convex_hull_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::convex_hull_request>(const gpudb::convex_hull_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::convex_hull_response>(const gpudb::convex_hull_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::convex_hull_response>(const gpudb::convex_hull_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::convex_hull_response>(const gpudb::convex_hull_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::copy_set_request>(const gpudb::copy_set_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::copy_set_request>(const gpudb::copy_set_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::copy_set_request>(const gpudb::copy_set_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::copy_set_response>(const gpudb::copy_set_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::copy_set_response>(const gpudb::copy_set_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::copy_set_response>(const gpudb::copy_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::delete_object_request>(const gpudb::delete_object_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::delete_object_request>(const gpudb::delete_object_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::delete_object_request>(const gpudb::delete_object_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::delete_object_response>(const gpudb::delete_object_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::delete_object_response>(const gpudb::delete_object_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::delete_object_response>(const gpudb::delete_object_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::exit_request>(const gpudb::exit_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::exit_request>(const gpudb::exit_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::exit_request>(const gpudb::exit_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::exit_response>(const gpudb::exit_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::exit_response>(const gpudb::exit_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::exit_response>(const gpudb::exit_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_bounds_request>(const gpudb::filter_by_bounds_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_bounds_request>(const gpudb::filter_by_bounds_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_bounds_request>(const gpudb::filter_by_bounds_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_bounds_response>(const gpudb::filter_by_bounds_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_bounds_response>(const gpudb::filter_by_bounds_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_bounds_response>(const gpudb::filter_by_bounds_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_list_request>(const gpudb::filter_by_list_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_list_request>(const gpudb::filter_by_list_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_list_request>(const gpudb::filter_by_list_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_list_response>(const gpudb::filter_by_list_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_list_response>(const gpudb::filter_by_list_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_list_response>(const gpudb::filter_by_list_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_nai_request>(const gpudb::filter_by_nai_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_nai_request>(const gpudb::filter_by_nai_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_nai_request>(const gpudb::filter_by_nai_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_nai_response>(const gpudb::filter_by_nai_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_nai_response>(const gpudb::filter_by_nai_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_nai_response>(const gpudb::filter_by_nai_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_radius_request>(const gpudb::filter_by_radius_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_radius_request>(const gpudb::filter_by_radius_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_radius_request>(const gpudb::filter_by_radius_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_radius_response>(const gpudb::filter_by_radius_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_radius_response>(const gpudb::filter_by_radius_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_radius_response>(const gpudb::filter_by_radius_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_set_request>(const gpudb::filter_by_set_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_set_request>(const gpudb::filter_by_set_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_set_request>(const gpudb::filter_by_set_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_set_response>(const gpudb::filter_by_set_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_set_response>(const gpudb::filter_by_set_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_set_response>(const gpudb::filter_by_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_string_request>(const gpudb::filter_by_string_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_string_request>(const gpudb::filter_by_string_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_string_request>(const gpudb::filter_by_string_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_string_response>(const gpudb::filter_by_string_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_string_response>(const gpudb::filter_by_string_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_string_response>(const gpudb::filter_by_string_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_track_request>(const gpudb::filter_by_track_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_track_request>(const gpudb::filter_by_track_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_track_request>(const gpudb::filter_by_track_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_track_response>(const gpudb::filter_by_track_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_track_response>(const gpudb::filter_by_track_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_track_response>(const gpudb::filter_by_track_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_track_values_request>(const gpudb::filter_by_track_values_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_track_values_request>(const gpudb::filter_by_track_values_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_track_values_request>(const gpudb::filter_by_track_values_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_track_values_response>(const gpudb::filter_by_track_values_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_track_values_response>(const gpudb::filter_by_track_values_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_track_values_response>(const gpudb::filter_by_track_values_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_value_request>(const gpudb::filter_by_value_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_value_request>(const gpudb::filter_by_value_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_value_request>(const gpudb::filter_by_value_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_by_value_response>(const gpudb::filter_by_value_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_by_value_response>(const gpudb::filter_by_value_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_by_value_response>(const gpudb::filter_by_value_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_then_histogram_request>(const gpudb::filter_then_histogram_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_then_histogram_request>(const gpudb::filter_then_histogram_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_then_histogram_request>(const gpudb::filter_then_histogram_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::filter_then_histogram_response>(const gpudb::filter_then_histogram_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::filter_then_histogram_response>(const gpudb::filter_then_histogram_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::filter_then_histogram_response>(const gpudb::filter_then_histogram_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::gpudb_response>(const gpudb::gpudb_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::gpudb_response>(const gpudb::gpudb_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::gpudb_response>(const gpudb::gpudb_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::generate_heatmap_video_internal_response>(const gpudb::generate_heatmap_video_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::generate_heatmap_video_internal_response>(const gpudb::generate_heatmap_video_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::generate_heatmap_video_internal_response>(const gpudb::generate_heatmap_video_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::generate_heatmap_video_request>(const gpudb::generate_heatmap_video_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::generate_heatmap_video_request>(const gpudb::generate_heatmap_video_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::generate_heatmap_video_request>(const gpudb::generate_heatmap_video_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::generate_heatmap_video_response>(const gpudb::generate_heatmap_video_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::generate_heatmap_video_response>(const gpudb::generate_heatmap_video_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::generate_heatmap_video_response>(const gpudb::generate_heatmap_video_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::generate_video_request>(const gpudb::generate_video_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::generate_video_request>(const gpudb::generate_video_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::generate_video_request>(const gpudb::generate_video_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::generate_video_response>(const gpudb::generate_video_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::generate_video_response>(const gpudb::generate_video_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::generate_video_response>(const gpudb::generate_video_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_at_index_request>(const gpudb::get_at_index_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_at_index_request>(const gpudb::get_at_index_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_at_index_request>(const gpudb::get_at_index_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_at_index_response>(const gpudb::get_at_index_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_at_index_response>(const gpudb::get_at_index_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_at_index_response>(const gpudb::get_at_index_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_full_set_request>(const gpudb::get_full_set_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_full_set_request>(const gpudb::get_full_set_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_full_set_request>(const gpudb::get_full_set_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_full_set_response>(const gpudb::get_full_set_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_full_set_response>(const gpudb::get_full_set_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_full_set_response>(const gpudb::get_full_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_objects_request>(const gpudb::get_objects_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_objects_request>(const gpudb::get_objects_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_objects_request>(const gpudb::get_objects_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_objects_response>(const gpudb::get_objects_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_objects_response>(const gpudb::get_objects_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_objects_response>(const gpudb::get_objects_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_orphans_request>(const gpudb::get_orphans_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_orphans_request>(const gpudb::get_orphans_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_orphans_request>(const gpudb::get_orphans_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_orphans_response>(const gpudb::get_orphans_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_orphans_response>(const gpudb::get_orphans_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_orphans_response>(const gpudb::get_orphans_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_bloom_request>(const gpudb::get_set_bloom_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_bloom_request>(const gpudb::get_set_bloom_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_bloom_request>(const gpudb::get_set_bloom_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_bloom_response>(const gpudb::get_set_bloom_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_bloom_response>(const gpudb::get_set_bloom_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_bloom_response>(const gpudb::get_set_bloom_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_count_request>(const gpudb::get_set_count_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_count_request>(const gpudb::get_set_count_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_count_request>(const gpudb::get_set_count_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_count_response>(const gpudb::get_set_count_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_count_response>(const gpudb::get_set_count_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_count_response>(const gpudb::get_set_count_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_internal_request>(const gpudb::get_set_internal_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_internal_request>(const gpudb::get_set_internal_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_internal_request>(const gpudb::get_set_internal_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_metadata_request>(const gpudb::get_set_metadata_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_metadata_request>(const gpudb::get_set_metadata_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_metadata_request>(const gpudb::get_set_metadata_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_metadata_response>(const gpudb::get_set_metadata_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_metadata_response>(const gpudb::get_set_metadata_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_metadata_response>(const gpudb::get_set_metadata_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_objects_request>(const gpudb::get_set_objects_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_objects_request>(const gpudb::get_set_objects_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_objects_request>(const gpudb::get_set_objects_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_objects_response>(const gpudb::get_set_objects_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_objects_response>(const gpudb::get_set_objects_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_objects_response>(const gpudb::get_set_objects_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_properties_request>(const gpudb::get_set_properties_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_properties_request>(const gpudb::get_set_properties_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_properties_request>(const gpudb::get_set_properties_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_properties_response>(const gpudb::get_set_properties_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_properties_response>(const gpudb::get_set_properties_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_properties_response>(const gpudb::get_set_properties_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_request>(const gpudb::get_set_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_request>(const gpudb::get_set_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_request>(const gpudb::get_set_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_response>(const gpudb::get_set_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_response>(const gpudb::get_set_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_response>(const gpudb::get_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sets_by_type_info_request>(const gpudb::get_sets_by_type_info_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sets_by_type_info_request>(const gpudb::get_sets_by_type_info_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sets_by_type_info_request>(const gpudb::get_sets_by_type_info_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sets_by_type_info_response>(const gpudb::get_sets_by_type_info_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sets_by_type_info_response>(const gpudb::get_sets_by_type_info_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sets_by_type_info_response>(const gpudb::get_sets_by_type_info_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_sizes_request>(const gpudb::get_set_sizes_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_sizes_request>(const gpudb::get_set_sizes_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_sizes_request>(const gpudb::get_set_sizes_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_set_sizes_response>(const gpudb::get_set_sizes_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_set_sizes_response>(const gpudb::get_set_sizes_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_set_sizes_response>(const gpudb::get_set_sizes_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sorted_set_internal_request>(const gpudb::get_sorted_set_internal_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sorted_set_internal_request>(const gpudb::get_sorted_set_internal_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sorted_set_internal_request>(const gpudb::get_sorted_set_internal_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sorted_set_internal_response>(const gpudb::get_sorted_set_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sorted_set_internal_response>(const gpudb::get_sorted_set_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sorted_set_internal_response>(const gpudb::get_sorted_set_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sorted_set_request>(const gpudb::get_sorted_set_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sorted_set_request>(const gpudb::get_sorted_set_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sorted_set_request>(const gpudb::get_sorted_set_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sorted_set_response>(const gpudb::get_sorted_set_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sorted_set_response>(const gpudb::get_sorted_set_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sorted_set_response>(const gpudb::get_sorted_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sorted_sets_request>(const gpudb::get_sorted_sets_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sorted_sets_request>(const gpudb::get_sorted_sets_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sorted_sets_request>(const gpudb::get_sorted_sets_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_sorted_sets_response>(const gpudb::get_sorted_sets_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_sorted_sets_response>(const gpudb::get_sorted_sets_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_sorted_sets_response>(const gpudb::get_sorted_sets_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_string_hash_request>(const gpudb::get_string_hash_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_string_hash_request>(const gpudb::get_string_hash_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_string_hash_request>(const gpudb::get_string_hash_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_string_hash_response>(const gpudb::get_string_hash_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_string_hash_response>(const gpudb::get_string_hash_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_string_hash_response>(const gpudb::get_string_hash_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tom_set_stats_request>(const gpudb::get_tom_set_stats_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tom_set_stats_request>(const gpudb::get_tom_set_stats_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tom_set_stats_request>(const gpudb::get_tom_set_stats_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tom_set_stats_response>(const gpudb::get_tom_set_stats_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tom_set_stats_response>(const gpudb::get_tom_set_stats_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tom_set_stats_response>(const gpudb::get_tom_set_stats_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tom_tracks_request>(const gpudb::get_tom_tracks_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tom_tracks_request>(const gpudb::get_tom_tracks_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tom_tracks_request>(const gpudb::get_tom_tracks_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tracks2_request>(const gpudb::get_tracks2_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tracks2_request>(const gpudb::get_tracks2_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tracks2_request>(const gpudb::get_tracks2_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tracks2_response>(const gpudb::get_tracks2_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tracks2_response>(const gpudb::get_tracks2_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tracks2_response>(const gpudb::get_tracks2_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tracks_request>(const gpudb::get_tracks_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tracks_request>(const gpudb::get_tracks_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tracks_request>(const gpudb::get_tracks_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_tracks_response>(const gpudb::get_tracks_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_tracks_response>(const gpudb::get_tracks_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_tracks_response>(const gpudb::get_tracks_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_trigger_info_request>(const gpudb::get_trigger_info_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_trigger_info_request>(const gpudb::get_trigger_info_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_trigger_info_request>(const gpudb::get_trigger_info_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_trigger_info_response>(const gpudb::get_trigger_info_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_trigger_info_response>(const gpudb::get_trigger_info_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_trigger_info_response>(const gpudb::get_trigger_info_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_type_info_request>(const gpudb::get_type_info_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_type_info_request>(const gpudb::get_type_info_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_type_info_request>(const gpudb::get_type_info_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_type_info_response>(const gpudb::get_type_info_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_type_info_response>(const gpudb::get_type_info_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_type_info_response>(const gpudb::get_type_info_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_user_auths_request>(const gpudb::get_user_auths_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_user_auths_request>(const gpudb::get_user_auths_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_user_auths_request>(const gpudb::get_user_auths_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::get_user_auths_response>(const gpudb::get_user_auths_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::get_user_auths_response>(const gpudb::get_user_auths_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::get_user_auths_response>(const gpudb::get_user_auths_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::group_by_request>(const gpudb::group_by_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::group_by_request>(const gpudb::group_by_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::group_by_request>(const gpudb::group_by_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::group_by_response>(const gpudb::group_by_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::group_by_response>(const gpudb::group_by_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::group_by_response>(const gpudb::group_by_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::group_by_value_request>(const gpudb::group_by_value_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::group_by_value_request>(const gpudb::group_by_value_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::group_by_value_request>(const gpudb::group_by_value_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::group_by_value_response>(const gpudb::group_by_value_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::group_by_value_response>(const gpudb::group_by_value_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::group_by_value_response>(const gpudb::group_by_value_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::histogram_request>(const gpudb::histogram_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::histogram_request>(const gpudb::histogram_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::histogram_request>(const gpudb::histogram_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::histogram_response>(const gpudb::histogram_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::histogram_response>(const gpudb::histogram_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::histogram_response>(const gpudb::histogram_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::join_incremental_request>(const gpudb::join_incremental_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::join_incremental_request>(const gpudb::join_incremental_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::join_incremental_request>(const gpudb::join_incremental_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::join_incremental_response>(const gpudb::join_incremental_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::join_incremental_response>(const gpudb::join_incremental_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::join_incremental_response>(const gpudb::join_incremental_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::join_request>(const gpudb::join_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::join_request>(const gpudb::join_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::join_request>(const gpudb::join_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::join_response>(const gpudb::join_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::join_response>(const gpudb::join_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::join_response>(const gpudb::join_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::join_setup_request>(const gpudb::join_setup_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::join_setup_request>(const gpudb::join_setup_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::join_setup_request>(const gpudb::join_setup_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::join_setup_response>(const gpudb::join_setup_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::join_setup_response>(const gpudb::join_setup_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::join_setup_response>(const gpudb::join_setup_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::k_means_internal_request>(const gpudb::k_means_internal_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::k_means_internal_request>(const gpudb::k_means_internal_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::k_means_internal_request>(const gpudb::k_means_internal_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::k_means_internal_response>(const gpudb::k_means_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::k_means_internal_response>(const gpudb::k_means_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::k_means_internal_response>(const gpudb::k_means_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::k_means_request>(const gpudb::k_means_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::k_means_request>(const gpudb::k_means_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::k_means_request>(const gpudb::k_means_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::k_means_response>(const gpudb::k_means_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::k_means_response>(const gpudb::k_means_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::k_means_response>(const gpudb::k_means_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::logger_request>(const gpudb::logger_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::logger_request>(const gpudb::logger_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::logger_request>(const gpudb::logger_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::logger_response>(const gpudb::logger_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::logger_response>(const gpudb::logger_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::logger_response>(const gpudb::logger_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::make_bloom_request>(const gpudb::make_bloom_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::make_bloom_request>(const gpudb::make_bloom_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::make_bloom_request>(const gpudb::make_bloom_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::make_bloom_response>(const gpudb::make_bloom_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::make_bloom_response>(const gpudb::make_bloom_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::make_bloom_response>(const gpudb::make_bloom_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::max_min_request>(const gpudb::max_min_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::max_min_request>(const gpudb::max_min_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::max_min_request>(const gpudb::max_min_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::max_min_response>(const gpudb::max_min_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::max_min_response>(const gpudb::max_min_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::max_min_response>(const gpudb::max_min_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::merge_sets_request>(const gpudb::merge_sets_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::merge_sets_request>(const gpudb::merge_sets_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::merge_sets_request>(const gpudb::merge_sets_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::merge_sets_response>(const gpudb::merge_sets_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::merge_sets_response>(const gpudb::merge_sets_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::merge_sets_response>(const gpudb::merge_sets_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::new_set_request>(const gpudb::new_set_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::new_set_request>(const gpudb::new_set_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::new_set_request>(const gpudb::new_set_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::new_set_response>(const gpudb::new_set_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::new_set_response>(const gpudb::new_set_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::new_set_response>(const gpudb::new_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_heatmap_cb_internal_response>(const gpudb::plot2d_heatmap_cb_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_heatmap_cb_internal_response>(const gpudb::plot2d_heatmap_cb_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_heatmap_cb_internal_response>(const gpudb::plot2d_heatmap_cb_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_heatmap_cb_request>(const gpudb::plot2d_heatmap_cb_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_heatmap_cb_request>(const gpudb::plot2d_heatmap_cb_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_heatmap_cb_request>(const gpudb::plot2d_heatmap_cb_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_heatmap_cb_response>(const gpudb::plot2d_heatmap_cb_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_heatmap_cb_response>(const gpudb::plot2d_heatmap_cb_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_heatmap_cb_response>(const gpudb::plot2d_heatmap_cb_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_heatmap_internal_response>(const gpudb::plot2d_heatmap_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_heatmap_internal_response>(const gpudb::plot2d_heatmap_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_heatmap_internal_response>(const gpudb::plot2d_heatmap_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_heatmap_request>(const gpudb::plot2d_heatmap_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_heatmap_request>(const gpudb::plot2d_heatmap_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_heatmap_request>(const gpudb::plot2d_heatmap_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_heatmap_response>(const gpudb::plot2d_heatmap_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_heatmap_response>(const gpudb::plot2d_heatmap_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_heatmap_response>(const gpudb::plot2d_heatmap_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_multiple_2_request>(const gpudb::plot2d_multiple_2_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_multiple_2_request>(const gpudb::plot2d_multiple_2_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_multiple_2_request>(const gpudb::plot2d_multiple_2_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_multiple_2_response>(const gpudb::plot2d_multiple_2_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_multiple_2_response>(const gpudb::plot2d_multiple_2_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_multiple_2_response>(const gpudb::plot2d_multiple_2_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_multiple_cb_request>(const gpudb::plot2d_multiple_cb_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_multiple_cb_request>(const gpudb::plot2d_multiple_cb_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_multiple_cb_request>(const gpudb::plot2d_multiple_cb_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::plot2d_multiple_cb_response>(const gpudb::plot2d_multiple_cb_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::plot2d_multiple_cb_response>(const gpudb::plot2d_multiple_cb_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::plot2d_multiple_cb_response>(const gpudb::plot2d_multiple_cb_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::populate_full_tracks_request>(const gpudb::populate_full_tracks_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::populate_full_tracks_request>(const gpudb::populate_full_tracks_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::populate_full_tracks_request>(const gpudb::populate_full_tracks_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::populate_full_tracks_response>(const gpudb::populate_full_tracks_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::populate_full_tracks_response>(const gpudb::populate_full_tracks_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::populate_full_tracks_response>(const gpudb::populate_full_tracks_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::predicate_join_request>(const gpudb::predicate_join_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::predicate_join_request>(const gpudb::predicate_join_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::predicate_join_request>(const gpudb::predicate_join_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::predicate_join_response>(const gpudb::predicate_join_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::predicate_join_response>(const gpudb::predicate_join_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::predicate_join_response>(const gpudb::predicate_join_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::random_request>(const gpudb::random_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::random_request>(const gpudb::random_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::random_request>(const gpudb::random_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::random_response>(const gpudb::random_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::random_response>(const gpudb::random_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::random_response>(const gpudb::random_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_parent_set_request>(const gpudb::register_parent_set_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_parent_set_request>(const gpudb::register_parent_set_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_parent_set_request>(const gpudb::register_parent_set_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_parent_set_response>(const gpudb::register_parent_set_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_parent_set_response>(const gpudb::register_parent_set_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_parent_set_response>(const gpudb::register_parent_set_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_trigger_nai_request>(const gpudb::register_trigger_nai_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_trigger_nai_request>(const gpudb::register_trigger_nai_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_trigger_nai_request>(const gpudb::register_trigger_nai_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_trigger_nai_response>(const gpudb::register_trigger_nai_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_trigger_nai_response>(const gpudb::register_trigger_nai_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_trigger_nai_response>(const gpudb::register_trigger_nai_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_trigger_range_request>(const gpudb::register_trigger_range_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_trigger_range_request>(const gpudb::register_trigger_range_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_trigger_range_request>(const gpudb::register_trigger_range_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_trigger_range_response>(const gpudb::register_trigger_range_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_trigger_range_response>(const gpudb::register_trigger_range_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_trigger_range_response>(const gpudb::register_trigger_range_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_type_request>(const gpudb::register_type_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_type_request>(const gpudb::register_type_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_type_request>(const gpudb::register_type_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_type_response>(const gpudb::register_type_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_type_response>(const gpudb::register_type_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_type_response>(const gpudb::register_type_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_type_transform_request>(const gpudb::register_type_transform_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_type_transform_request>(const gpudb::register_type_transform_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_type_transform_request>(const gpudb::register_type_transform_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_type_transform_response>(const gpudb::register_type_transform_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_type_transform_response>(const gpudb::register_type_transform_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_type_transform_response>(const gpudb::register_type_transform_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_type_with_annotations_request>(const gpudb::register_type_with_annotations_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_type_with_annotations_request>(const gpudb::register_type_with_annotations_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_type_with_annotations_request>(const gpudb::register_type_with_annotations_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::register_type_with_annotations_response>(const gpudb::register_type_with_annotations_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::register_type_with_annotations_response>(const gpudb::register_type_with_annotations_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::register_type_with_annotations_response>(const gpudb::register_type_with_annotations_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::road_intersection_internal_response>(const gpudb::road_intersection_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::road_intersection_internal_response>(const gpudb::road_intersection_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::road_intersection_internal_response>(const gpudb::road_intersection_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::road_intersection_request>(const gpudb::road_intersection_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::road_intersection_request>(const gpudb::road_intersection_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::road_intersection_request>(const gpudb::road_intersection_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::road_intersection_response>(const gpudb::road_intersection_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::road_intersection_response>(const gpudb::road_intersection_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::road_intersection_response>(const gpudb::road_intersection_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::select_delete_request>(const gpudb::select_delete_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::select_delete_request>(const gpudb::select_delete_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::select_delete_request>(const gpudb::select_delete_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::select_delete_response>(const gpudb::select_delete_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::select_delete_response>(const gpudb::select_delete_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::select_delete_response>(const gpudb::select_delete_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::select_request>(const gpudb::select_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::select_request>(const gpudb::select_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::select_request>(const gpudb::select_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::select_response>(const gpudb::select_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::select_response>(const gpudb::select_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::select_response>(const gpudb::select_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::select_update_request>(const gpudb::select_update_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::select_update_request>(const gpudb::select_update_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::select_update_request>(const gpudb::select_update_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::select_update_response>(const gpudb::select_update_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::select_update_response>(const gpudb::select_update_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::select_update_response>(const gpudb::select_update_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::server_status_request>(const gpudb::server_status_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::server_status_request>(const gpudb::server_status_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::server_status_request>(const gpudb::server_status_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::server_status_response>(const gpudb::server_status_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::server_status_response>(const gpudb::server_status_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::server_status_response>(const gpudb::server_status_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::set_info_request>(const gpudb::set_info_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::set_info_request>(const gpudb::set_info_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::set_info_request>(const gpudb::set_info_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::set_info_response>(const gpudb::set_info_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::set_info_response>(const gpudb::set_info_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::set_info_response>(const gpudb::set_info_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::spatial_query_request>(const gpudb::spatial_query_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::spatial_query_request>(const gpudb::spatial_query_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::spatial_query_request>(const gpudb::spatial_query_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::spatial_query_response>(const gpudb::spatial_query_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::spatial_query_response>(const gpudb::spatial_query_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::spatial_query_response>(const gpudb::spatial_query_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::spatial_set_query_internal_response>(const gpudb::spatial_set_query_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::spatial_set_query_internal_response>(const gpudb::spatial_set_query_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::spatial_set_query_internal_response>(const gpudb::spatial_set_query_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::spatial_set_query_request>(const gpudb::spatial_set_query_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::spatial_set_query_request>(const gpudb::spatial_set_query_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::spatial_set_query_request>(const gpudb::spatial_set_query_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::spatial_set_query_response>(const gpudb::spatial_set_query_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::spatial_set_query_response>(const gpudb::spatial_set_query_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::spatial_set_query_response>(const gpudb::spatial_set_query_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::statistics_internal_response>(const gpudb::statistics_internal_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::statistics_internal_response>(const gpudb::statistics_internal_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::statistics_internal_response>(const gpudb::statistics_internal_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::statistics_request>(const gpudb::statistics_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::statistics_request>(const gpudb::statistics_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::statistics_request>(const gpudb::statistics_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::statistics_response>(const gpudb::statistics_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::statistics_response>(const gpudb::statistics_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::statistics_response>(const gpudb::statistics_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::stats_request>(const gpudb::stats_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::stats_request>(const gpudb::stats_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::stats_request>(const gpudb::stats_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::stats_response>(const gpudb::stats_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::stats_response>(const gpudb::stats_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::stats_response>(const gpudb::stats_response& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::status_request>(const gpudb::status_request& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::status_request>(const gpudb::status_request& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::status_request>(const gpudb::status_request& v);
 template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::status_response>(const gpudb::status_response& v);
 template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::status_response>(const gpudb::status_response& v);
+template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::status_response>(const gpudb::status_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::store_group_by_request>(const gpudb::store_group_by_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::store_group_by_request>(const gpudb::store_group_by_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::store_group_by_request>(const gpudb::store_group_by_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::store_group_by_response>(const gpudb::store_group_by_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::store_group_by_response>(const gpudb::store_group_by_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::store_group_by_response>(const gpudb::store_group_by_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::subset_match_request>(const gpudb::subset_match_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::subset_match_request>(const gpudb::subset_match_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::subset_match_request>(const gpudb::subset_match_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::subset_match_response>(const gpudb::subset_match_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::subset_match_response>(const gpudb::subset_match_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::subset_match_response>(const gpudb::subset_match_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::trigger_notification>(const gpudb::trigger_notification& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::trigger_notification>(const gpudb::trigger_notification& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::trigger_notification>(const gpudb::trigger_notification& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::unique_request>(const gpudb::unique_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::unique_request>(const gpudb::unique_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::unique_request>(const gpudb::unique_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::unique_response>(const gpudb::unique_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::unique_response>(const gpudb::unique_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::unique_response>(const gpudb::unique_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_object_request>(const gpudb::update_object_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_object_request>(const gpudb::update_object_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_object_request>(const gpudb::update_object_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_object_response>(const gpudb::update_object_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_object_response>(const gpudb::update_object_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_object_response>(const gpudb::update_object_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_set_metadata_request>(const gpudb::update_set_metadata_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_set_metadata_request>(const gpudb::update_set_metadata_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_set_metadata_request>(const gpudb::update_set_metadata_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_set_metadata_response>(const gpudb::update_set_metadata_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_set_metadata_response>(const gpudb::update_set_metadata_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_set_metadata_response>(const gpudb::update_set_metadata_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_set_properties_request>(const gpudb::update_set_properties_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_set_properties_request>(const gpudb::update_set_properties_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_set_properties_request>(const gpudb::update_set_properties_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_set_properties_response>(const gpudb::update_set_properties_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_set_properties_response>(const gpudb::update_set_properties_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_set_properties_response>(const gpudb::update_set_properties_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_set_ttl_request>(const gpudb::update_set_ttl_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_set_ttl_request>(const gpudb::update_set_ttl_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_set_ttl_request>(const gpudb::update_set_ttl_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_set_ttl_response>(const gpudb::update_set_ttl_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_set_ttl_response>(const gpudb::update_set_ttl_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_set_ttl_response>(const gpudb::update_set_ttl_response& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_trigger_request>(const gpudb::update_trigger_request& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_trigger_request>(const gpudb::update_trigger_request& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_trigger_request>(const gpudb::update_trigger_request& v);
 // template<> size_t AvroUtils::get_estimated_binary_encoded_size<gpudb::update_trigger_response>(const gpudb::update_trigger_response& v);
 // template<> size_t AvroUtils::get_min_binary_encoded_size      <gpudb::update_trigger_response>(const gpudb::update_trigger_response& v);
+// template<> size_t AvroUtils::get_exact_binary_encoded_size    <gpudb::update_trigger_response>(const gpudb::update_trigger_response& v);
  
 
 } // namespace gpudb
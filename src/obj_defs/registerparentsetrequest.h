@@ -34,6 +34,12 @@ struct register_parent_set_request {
 
     inline register_parent_set_request()  : allow_duplicate_children(false) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+        allow_duplicate_children = false;
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id)+
             AvroUtils::get_min_binary_encoded_size(allow_duplicate_children); }
@@ -43,6 +49,10 @@ struct register_parent_set_request {
             AvroUtils::get_binary_encoded_size(allow_duplicate_children)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(allow_duplicate_children); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("register_parent_set_request");
@@ -53,6 +63,17 @@ struct register_parent_set_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"register_parent_set_request\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"allow_duplicate_children\",\"type\":\"boolean\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x73742df44700840dULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
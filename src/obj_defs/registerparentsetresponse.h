@@ -33,6 +33,11 @@ struct register_parent_set_response {
 
     inline register_parent_set_response() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id); }
 
@@ -40,6 +45,9 @@ struct register_parent_set_response {
             AvroUtils::get_binary_encoded_size(set_id)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("register_parent_set_response");
@@ -50,6 +58,17 @@ struct register_parent_set_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"register_parent_set_response\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xaa392aad52dcf171ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -37,6 +37,15 @@ struct register_type_response {
 
     inline register_type_response() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        type_id.clear();
+        type_definition.clear();
+        annotation.clear();
+        label.clear();
+        semantic_type.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(type_id)+
             AvroUtils::get_min_binary_encoded_size(type_definition)+
@@ -52,6 +61,13 @@ struct register_type_response {
             AvroUtils::get_binary_encoded_size(semantic_type)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(type_id)+
+            AvroUtils::get_exact_encoded_size(type_definition)+
+            AvroUtils::get_exact_encoded_size(annotation)+
+            AvroUtils::get_exact_encoded_size(label)+
+            AvroUtils::get_exact_encoded_size(semantic_type); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("register_type_response");
@@ -62,6 +78,17 @@ struct register_type_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"register_type_response\",\"fields\":[{\"name\":\"type_id\",\"type\":\"string\"},{\"name\":\"type_definition\",\"type\":\"string\"},{\"name\":\"annotation\",\"type\":\"string\"},{\"name\":\"label\",\"type\":\"string\"},{\"name\":\"semantic_type\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x9756bcea581b4bbdULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -33,6 +33,11 @@ struct status_request {
 
     inline status_request() {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id); }
 
@@ -40,6 +45,9 @@ struct status_request {
             AvroUtils::get_binary_encoded_size(set_id)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("status_request");
@@ -50,6 +58,17 @@ struct status_request {
         static const std::string str("{\"type\":\"record\",\"name\":\"status_request\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0xc33935e4b660fe4aULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 
@@ -42,6 +42,20 @@ struct status_response {
 
     inline status_response()  : total_size(0),total_full_size(0) {}
 
+    /// Reset the fields for reuse; strings and containers keep their memory.
+    inline void clear() {
+        set_id.clear();
+        set_ids.clear();
+        is_parent.clear();
+        semantic_types.clear();
+        labels.clear();
+        sizes.clear();
+        full_sizes.clear();
+        child_map.clear();
+        total_size = 0;
+        total_full_size = 0;
+    }
+
     size_t min_binary_encoded_size() const { return
             AvroUtils::get_min_binary_encoded_size(set_id)+
             AvroUtils::get_min_binary_encoded_size(set_ids)+
@@ -67,6 +81,18 @@ struct status_response {
             AvroUtils::get_binary_encoded_size(total_full_size)+
             1024); }
 
+    size_t exact_binary_encoded_size() const { return
+            AvroUtils::get_exact_encoded_size(set_id)+
+            AvroUtils::get_exact_encoded_size(set_ids)+
+            AvroUtils::get_exact_encoded_size(is_parent)+
+            AvroUtils::get_exact_encoded_size(semantic_types)+
+            AvroUtils::get_exact_encoded_size(labels)+
+            AvroUtils::get_exact_encoded_size(sizes)+
+            AvroUtils::get_exact_encoded_size(full_sizes)+
+            AvroUtils::get_exact_encoded_size(child_map)+
+            AvroUtils::get_exact_encoded_size(total_size)+
+            AvroUtils::get_exact_encoded_size(total_full_size); }
+
     static const std::string& schema_name(void)
     {
         static const std::string str("status_response");
@@ -77,6 +103,17 @@ struct status_response {
         static const std::string str("{\"type\":\"record\",\"name\":\"status_response\",\"fields\":[{\"name\":\"set_id\",\"type\":\"string\"},{\"name\":\"set_ids\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"is_parent\",\"type\":{\"type\":\"array\",\"items\":\"boolean\"}},{\"name\":\"semantic_types\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"labels\",\"type\":{\"type\":\"array\",\"items\":\"string\"}},{\"name\":\"sizes\",\"type\":{\"type\":\"array\",\"items\":\"long\"}},{\"name\":\"full_sizes\",\"type\":{\"type\":\"array\",\"items\":\"long\"}},{\"name\":\"child_map\",\"type\":{\"type\":\"map\",\"values\":{\"type\":\"array\",\"items\":\"string\"}}},{\"name\":\"total_size\",\"type\":\"long\"},{\"name\":\"total_full_size\",\"type\":\"long\"}]}");
         return str;
     }
+    /// AvroUtils::fingerprint64() of the schema_str() text (not of its canonical form).
+    static uint64_t fingerprint(void)
+    {
+        return 0x0518eb82283bb899ULL;
+    }
+    /// The compiled schema, the one interned by AvroUtils.
+    static const avro::ValidSchema& schema(void)
+    {
+        static const avro::ValidSchema s(AvroUtils::intern_schema(schema_str(), fingerprint()).schema());
+        return s;
+    }
 
 };
 